@@ -359,20 +359,11 @@ void EDA_3D_CANVAS::BuildBoard3DView()
         if( bufferPolys.GetCornersCount() == 0 )
             continue;
 
-        KI_POLYGON_SET  currLayerPolyset;
-        KI_POLYGON_SET  polysetHoles;
-
-        // Add polygons, without holes
-        bufferPolys.ExportTo( currLayerPolyset );
-
         // Add holes in polygon list
         currLayerHoles.Append( allLayerHoles );
 
-        if( currLayerHoles.GetCornersCount() > 0 )
-            currLayerHoles.ExportTo( polysetHoles );
-
         // Merge polygons, remove holes
-        currLayerPolyset -= polysetHoles;
+        bufferPolys.BooleanSubtract( currLayerHoles );
 
         int         thickness = g_Parm_3D_Visu.GetLayerObjectThicknessBIU( layer );
         int         zpos = g_Parm_3D_Visu.GetLayerZcoordBIU( layer );
@@ -387,8 +378,6 @@ void EDA_3D_CANVAS::BuildBoard3DView()
 
         glNormal3f( 0.0, 0.0, Get3DLayer_Z_Orientation( layer ) );
 
-        bufferPolys.RemoveAllContours();
-        bufferPolys.ImportFrom( currLayerPolyset );
         Draw3D_SolidHorizontalPolyPolygons( bufferPolys, zpos,
                                             thickness,
                                             g_Parm_3D_Visu.m_BiuTo3Dunits );
@@ -442,20 +431,9 @@ void EDA_3D_CANVAS::BuildBoard3DView()
         }
 
         glNormal3f( 0.0, 0.0, Get3DLayer_Z_Orientation( LAYER_N_FRONT ) );
-        KI_POLYGON_SET  currLayerPolyset;
-        KI_POLYGON_SET  polysetHoles;
-
-        // Add polygons, without holes
-        bufferPcbOutlines.ExportTo( currLayerPolyset );
-
-        // Build holes list
-        allLayerHoles.ExportTo( polysetHoles );
 
         // remove holes
-        currLayerPolyset -= polysetHoles;
-
-        bufferPcbOutlines.RemoveAllContours();
-        bufferPcbOutlines.ImportFrom( currLayerPolyset );
+        bufferPcbOutlines.BooleanSubtract( allLayerHoles );
 
         // for Draw3D_SolidHorizontalPolyPolygons, zpos it the middle between bottom and top
         // sides
@@ -464,9 +442,6 @@ void EDA_3D_CANVAS::BuildBoard3DView()
     }
 
     // draw graphic items, not on copper layers
-    KI_POLYGON_SET  brdpolysetHoles;
-    allLayerHoles.ExportTo( brdpolysetHoles );
-
     for( LAYER_NUM layer = FIRST_NON_COPPER_LAYER; layer <= LAST_NON_COPPER_LAYER;
          layer++ )
     {
@@ -537,29 +512,27 @@ void EDA_3D_CANVAS::BuildBoard3DView()
         // Calculate merged polygons and remove pads and vias holes
         if( bufferPolys.GetCornersCount() == 0 )
             continue;
-        KI_POLYGON_SET  currLayerPolyset;
-        KI_POLYGON_SET  polyset;
 
         // Solder mask layers are "negative" layers.
         // Shapes should be removed from the full board area.
         if( layer == SOLDERMASK_N_BACK || layer == SOLDERMASK_N_FRONT )
         {
-            bufferPcbOutlines.ExportTo( currLayerPolyset );
+            // The board outlines are kept for the other layers
+            CPOLYGONS_LIST maskPolys = bufferPcbOutlines;
+
             bufferPolys.Append( allLayerHoles );
-            bufferPolys.ExportTo( polyset );
-            currLayerPolyset -= polyset;
+            maskPolys.BooleanSubtract( bufferPolys );
+            bufferPolys.Swap( maskPolys );
         }
         // Remove holes from Solder paste layers and siklscreen
         else if( layer == SOLDERPASTE_N_BACK || layer == SOLDERPASTE_N_FRONT
                  || layer == SILKSCREEN_N_BACK || layer == SILKSCREEN_N_FRONT  )
         {
-            bufferPolys.ExportTo( currLayerPolyset );
-            currLayerPolyset -= brdpolysetHoles;
+            bufferPolys.BooleanSubtract( allLayerHoles );
         }
         else    // usuall layers, merge polys built from each item shape:
         {
-            bufferPolys.ExportTo( polyset );
-            currLayerPolyset += polyset;
+            bufferPolys.Merge();
         }
 
         SetGLTechLayersColor( layer );
@@ -586,8 +559,6 @@ void EDA_3D_CANVAS::BuildBoard3DView()
                 zpos -= thickness/2 ;
         }
 
-        bufferPolys.RemoveAllContours();
-        bufferPolys.ImportFrom( currLayerPolyset );
         Draw3D_SolidHorizontalPolyPolygons( bufferPolys, zpos,
                                             thickness, g_Parm_3D_Visu.m_BiuTo3Dunits );
     }
@@ -49,6 +49,7 @@ BITMAP_BASE::BITMAP_BASE( const wxPoint& pos )
     m_Scale  = 1.0;                 // 1.0 = original bitmap size
     m_bitmap = NULL;
     m_image  = NULL;
+    m_pngDataRead = false;
     m_ppi    = 300;                 // the bitmap definition. the default is 300PPI
     m_pixelScaleFactor = 1000.0 / m_ppi;    // a value OK for bitmaps using 300 PPI
                                             // for Eeschema which uses currently 1000PPI
@@ -61,6 +62,7 @@ BITMAP_BASE::BITMAP_BASE( const BITMAP_BASE& aSchBitmap )
     m_pixelScaleFactor = aSchBitmap.m_pixelScaleFactor;
     m_image = new wxImage( *aSchBitmap.m_image );
     m_bitmap = new wxBitmap( *m_image );
+    m_pngDataRead = false;
 }
 
 
@@ -155,14 +157,28 @@ void BITMAP_BASE::SaveData( wxArrayString& aPngStrings ) const
 
 bool BITMAP_BASE::LoadData( LINE_READER& aLine, wxString& aErrorMsg )
 {
-    wxMemoryOutputStream stream;
+    if( !ReadData( aLine, aErrorMsg ) )
+        return false;
+
+    BuildImage();
+
+    return true;
+}
+
+
+bool BITMAP_BASE::ReadData( LINE_READER& aLine, wxString& aErrorMsg )
+{
     char* line;
 
+    m_pngData.clear();
+    m_pngDataRead = false;
+
     while( true )
     {
         if( !aLine.ReadLine() )
         {
             aErrorMsg = wxT("Unexpected end of data");
+            m_pngData.clear();
             return false;
         }
 
@@ -171,23 +187,19 @@ bool BITMAP_BASE::LoadData( LINE_READER& aLine, wxString& aErrorMsg )
         if( strnicmp( line, "EndData", 4 ) == 0 )
         {
             // all the PNG date is read.
-            // We expect here m_image and m_bitmap are void
-            m_image = new wxImage();
-            wxMemoryInputStream istream( stream );
-            m_image->LoadFile( istream, wxBITMAP_TYPE_PNG );
-            m_bitmap = new wxBitmap( *m_image );
+            m_pngDataRead = true;
             break;
         }
 
         // Read PNG data, stored in hexadecimal,
         // each byte = 2 hexadecimal digits and a space between 2 bytes
-        // and put it in memory stream buffer
+        // and put it in memory buffer
         int len = strlen( line );
         for( ; len > 0; len -= 3, line += 3 )
         {
             int value = 0;
             if( sscanf( line, "%X", &value ) == 1 )
-                stream.PutC( (char) value );
+                m_pngData += (char) value;
             else
                 break;
         }
@@ -197,6 +209,25 @@ bool BITMAP_BASE::LoadData( LINE_READER& aLine, wxString& aErrorMsg )
 }
 
 
+void BITMAP_BASE::BuildImage()
+{
+    if( !m_pngDataRead )
+        return;
+
+    // We expect here m_image and m_bitmap are void
+    delete m_bitmap;
+    delete m_image;
+
+    m_image = new wxImage();
+    wxMemoryInputStream istream( m_pngData.data(), m_pngData.size() );
+    m_image->LoadFile( istream, wxBITMAP_TYPE_PNG );
+    m_bitmap = new wxBitmap( *m_image );
+
+    m_pngData.clear();
+    m_pngDataRead = false;
+}
+
+
 EDA_RECT BITMAP_BASE::GetBoundingBox() const
 {
     EDA_RECT rect;
@@ -43,6 +43,7 @@ ITEM_PICKER::ITEM_PICKER( EDA_ITEM* aItem, UNDO_REDO_T aUndoRedoStatus )
 PICKED_ITEMS_LIST::PICKED_ITEMS_LIST()
 {
     m_Status = UR_UNSPECIFIED;
+    m_memoryUsage = 0;
 }
 
 PICKED_ITEMS_LIST::~PICKED_ITEMS_LIST()
@@ -317,6 +318,17 @@ void UNDO_REDO_CONTAINER::ClearCommandList()
 }
 
 
+size_t UNDO_REDO_CONTAINER::GetMemoryUsage() const
+{
+    size_t total = 0;
+
+    for( unsigned ii = 0; ii < m_CommandsList.size(); ii++ )
+        total += m_CommandsList[ii]->GetMemoryUsage();
+
+    return total;
+}
+
+
 void UNDO_REDO_CONTAINER::PushCommand( PICKED_ITEMS_LIST* aItem )
 {
     m_CommandsList.push_back( aItem );
@@ -296,14 +296,20 @@ int ProcessExecute( const wxString& aCommandLine, int aFlags, wxProcess *callbac
 time_t GetNewTimeStamp()
 {
     static time_t oldTimeStamp;
+    time_t lastTimeStamp;
     time_t newTimeStamp;
 
-    newTimeStamp = time( NULL );
-
-    if( newTimeStamp <= oldTimeStamp )
-        newTimeStamp = oldTimeStamp + 1;
+    // Items are created by several threads when files are loaded concurrently: retry
+    // until no other thread has taken a stamp in between, using thread safe, atomic
+    // operations.
+    do
+    {
+        lastTimeStamp = __sync_add_and_fetch( &oldTimeStamp, 0 );
+        newTimeStamp = time( NULL );
 
-    oldTimeStamp = newTimeStamp;
+        if( newTimeStamp <= lastTimeStamp )
+            newTimeStamp = lastTimeStamp + 1;
+    } while( !__sync_bool_compare_and_swap( &oldTimeStamp, lastTimeStamp, newTimeStamp ) );
 
     return newTimeStamp;
 }
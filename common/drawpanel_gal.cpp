@@ -37,6 +37,7 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/opengl/opengl_gal.h>
 #include <gal/cairo/cairo_gal.h>
+#include <gal/frame_profiler.h>
 
 #include <tool/tool_dispatcher.h>
 #include <tool/tool_manager.h>
@@ -97,11 +98,19 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     Connect( wxEVT_TIMER, wxTimerEventHandler( EDA_DRAW_PANEL_GAL::onRefreshTimer ), NULL, this );
 
     this->SetFocus();
+
+    // Rendering profile is collected on demand and saved as a Chrome trace when the panel
+    // is destroyed
+    if( wxGetEnv( wxT( "KICAD_GAL_PROFILE" ), &m_profileFile ) && !m_profileFile.IsEmpty() )
+        KIGFX::FRAME_PROFILER::Instance().Enable( true );
 }
 
 
 EDA_DRAW_PANEL_GAL::~EDA_DRAW_PANEL_GAL()
 {
+    if( !m_profileFile.IsEmpty() )
+        KIGFX::FRAME_PROFILER::Instance().SaveTrace( std::string( m_profileFile.mb_str() ) );
+
     if( m_painter )
         delete m_painter;
 
@@ -133,6 +142,7 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
     {
         m_drawing = true;
 
+        KIGFX::FRAME_PROFILER::Instance().BeginFrame();
         m_gal->BeginDrawing();
         m_gal->SetBackgroundColor( m_painter->GetSettings()->GetBackgroundColor() ); 
         m_gal->ClearScreen();
@@ -145,6 +155,7 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
         m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
 
         m_gal->EndDrawing();
+        KIGFX::FRAME_PROFILER::Instance().EndFrame();
 
         m_drawing = false;
     }
@@ -40,8 +40,7 @@
 #include <class_base_screen.h>
 
 
-#include <newstroke_font.h>
-#include <plot_common.h>
+#include <stroke_glyph_table.h>
 
 /* factor used to calculate actual size of shapes from hershey fonts
  * (could be adjusted depending on the font name)
@@ -138,31 +137,9 @@ int NegableTextLength( const wxString& aText )
 }
 
 
-/* Function GetHersheyShapeDescription
- * return a pointer to the shape corresponding to unicode value AsciiCode
- * Note we use the same font for Bold and Normal texts
- * because KiCad handles a variable pen size to do that
- * that gives better results in XOR draw mode.
- */
-static const char* GetHersheyShapeDescription( int AsciiCode )
-{
-    // calculate font length
-    int font_length_max = newstroke_font_bufsize;
-
-    if( AsciiCode >= (32 + font_length_max) )
-        AsciiCode = '?';
-
-    if( AsciiCode < 32 )
-        AsciiCode = 32; // Clamp control chars
-
-    AsciiCode -= 32;
-
-    return newstroke_font[AsciiCode];
-}
-
-
 int ReturnGraphicTextWidth( const wxString& aText, int aXSize, bool aItalic, bool aWidth )
 {
+    const STROKE_GLYPH_TABLE& font = STROKE_GLYPH_TABLE::NewStroke();
     int tally = 0;
     int char_count = aText.length();
 
@@ -180,11 +157,7 @@ int ReturnGraphicTextWidth( const wxString& aText, int aXSize, bool aItalic, boo
                 continue;
         }
 
-        const char* shape_ptr = GetHersheyShapeDescription( asciiCode );
-        // Get metrics
-        int         xsta    = *shape_ptr++ - 'R';
-        int         xsto    = *shape_ptr++ - 'R';
-        tally += KiROUND( aXSize * (xsto - xsta) * s_HersheyScaleFactor );
+        tally += KiROUND( aXSize * font.GetGlyph( asciiCode ).advance * s_HersheyScaleFactor );
     }
 
     // For italic correction, add 1/8 size
@@ -276,6 +249,7 @@ void DrawGraphicText( EDA_RECT* aClipBox,
                       void (* aCallback)( int x0, int y0, int xf, int yf ),
                       PLOTTER* aPlotter )
 {
+    const STROKE_GLYPH_TABLE& font = STROKE_GLYPH_TABLE::NewStroke();
     int         AsciiCode;
     int         x0, y0;
     int         size_h, size_v;
@@ -468,54 +442,20 @@ void DrawGraphicText( EDA_RECT* aClipBox,
 
         AsciiCode = aText.GetChar( ptr + overbars );
 
-        const char* ptcar = GetHersheyShapeDescription( AsciiCode );
-        // Get metrics
-        int         xsta    = *ptcar++ - 'R';
-        int         xsto    = *ptcar++ - 'R';
-        int         point_count = 0;
-        bool        endcar = false;
+        const STROKE_GLYPH_TABLE::GLYPH& glyph = font.GetGlyph( AsciiCode );
+        unsigned lastStroke = glyph.firstStroke + glyph.strokeCount;
 
-        while( !endcar )
+        for( unsigned stroke = glyph.firstStroke; stroke < lastStroke; stroke++ )
         {
-            int hc1, hc2;
-            hc1 = *ptcar++;
+            const STROKE_GLYPH_TABLE::POINT* point = font.StrokeBegin( stroke );
+            const STROKE_GLYPH_TABLE::POINT* end   = font.StrokeEnd( stroke );
+            int point_count = 0;
 
-            if( hc1 )
-            {
-                hc2 = *ptcar++;
-            }
-            else
-            {
-                // End of character, insert a synthetic pen up:
-                hc1    = ' ';
-                hc2    = 'R';
-                endcar = true;
-            }
-
-            // Do the Hershey decode thing:
-            // coordinates values are coded as <value> + 'R'
-            hc1 -= 'R';
-            hc2 -= 'R';
-
-            // Pen up request
-            if( hc1 == -50 && hc2 == 0 )
-            {
-                if( point_count )
-                {
-                    if( aWidth <= 1 )
-                        aWidth = 0;
-
-                    DrawGraphicTextPline( aClipBox, aDC, aColor, aWidth,
-                                          sketch_mode, point_count, coord,
-                                          aCallback, aPlotter );
-                }
-
-                point_count = 0;
-            }
-            else
+            for( ; point != end; ++point )
             {
                 wxPoint currpoint;
-                hc1 -= xsta; hc2 -= 10;    // Align the midpoint
+                int hc1 = point->x;
+                int hc2 = point->y - 10;    // Align the midpoint
                 hc1  = KiROUND( hc1 * size_h * s_HersheyScaleFactor );
                 hc2  = KiROUND( hc2 * size_v * s_HersheyScaleFactor );
 
@@ -533,12 +473,19 @@ void DrawGraphicText( EDA_RECT* aClipBox,
                 if( point_count < BUF_SIZE - 1 )
                     point_count++;
             }
+
+            if( aWidth <= 1 )
+                aWidth = 0;
+
+            DrawGraphicTextPline( aClipBox, aDC, aColor, aWidth,
+                                  sketch_mode, point_count, coord,
+                                  aCallback, aPlotter );
         }    // end draw 1 char
 
         ptr++;
 
         // Apply the advance width
-        current_char_pos.x += KiROUND( size_h * (xsto - xsta) * s_HersheyScaleFactor );
+        current_char_pos.x += KiROUND( size_h * glyph.advance * s_HersheyScaleFactor );
     }
 
     if( overbars % 2 )
@@ -43,8 +43,11 @@
 #include <footprint_info.h>
 #include <io_mgr.h>
 #include <fp_lib_table.h>
+#include <fp_info_index.h>
 #include <fpid.h>
 #include <class_module.h>
+#include <parallel_for.h>
+#include <climits>
 #include <boost/thread.hpp>
 
 
@@ -121,7 +124,8 @@ void FOOTPRINT_INFO::load()
                                     // in progress will still pile on for a bit.  e.g. if 9 threads
                                     // expect 9 greater than this.
 
-void FOOTPRINT_LIST::loader_job( const wxString* aNicknameList, int aJobZ )
+void FOOTPRINT_LIST::loader_job( const wxString* aNicknameList, int aJobZ,
+                                 unsigned aThreadBudget )
 {
     //DBG(printf( "%s: first:'%s' count:%d\n", __func__, (char*) TO_UTF8( *aNicknameList ), aJobZ );)
 
@@ -134,7 +138,10 @@ void FOOTPRINT_LIST::loader_job( const wxString* aNicknameList, int aJobZ )
 
         try
         {
-            wxArrayString fpnames = m_lib_table->FootprintEnumerate( nickname );
+            if( loadFromIndex( nickname ) )
+                continue;
+
+            wxArrayString fpnames = m_lib_table->FootprintEnumerate( nickname, aThreadBudget );
 
             for( unsigned ni=0;  ni<fpnames.GetCount();  ++ni )
             {
@@ -182,6 +189,33 @@ void FOOTPRINT_LIST::loader_job( const wxString* aNicknameList, int aJobZ )
 }
 
 
+bool FOOTPRINT_LIST::loadFromIndex( const wxString& aNickname )
+{
+    const FP_LIB_TABLE::ROW* row = m_lib_table->FindRow( aNickname );
+
+    // Only the *.pretty libraries have an index.
+    if( IO_MGR::EnumFromStr( row->GetType() ) != IO_MGR::KICAD )
+        return false;
+
+    FP_INFO_INDEX index( row->GetFullURI( true ) );
+
+    if( !index.Read() )
+        return false;
+
+    const FP_INFO_INDEX::ENTRIES& entries = index.GetEntries();
+
+    for( unsigned ii = 0; ii < entries.size(); ii++ )
+    {
+        const FP_INFO_INDEX::ENTRY& entry = entries[ii];
+
+        addItem( new FOOTPRINT_INFO( this, aNickname, entry.m_Name, entry.m_Doc,
+                                     entry.m_Keywords, entry.m_PadCount ) );
+    }
+
+    return true;
+}
+
+
 bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname )
 {
     bool retv = true;
@@ -195,7 +229,7 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
 
     if( aNickname )
         // single footprint
-        loader_job( aNickname, 1 );
+        loader_job( aNickname, 1, 0 );
     else
     {
         std::vector< wxString > nicknames;
@@ -220,6 +254,13 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
 
         MYTHREADS threads;
 
+        // The libraries are read by one thread per JOBZ nicknames.  When there are fewer
+        // of these threads than cores, e.g. for a single huge library, the plugins may
+        // use the other cores to read each library.
+        unsigned cores   = ParallelThreadCount( UINT_MAX );   // the ones this call may use
+        unsigned loaders = std::max<unsigned>( 1, ( nicknames.size() + JOBZ - 1 ) / JOBZ );
+        unsigned budget  = std::max( 1u, cores / loaders );
+
         // Give each thread JOBZ nicknames to process.  The last portion of, or if the entire
         // size() is small, I'll do myself.
         for( unsigned i=0; i<nicknames.size();  )
@@ -238,13 +279,13 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
                 jobz = nicknames.size() - i;
 
                 // Only a little bit to do, I'll do it myself, on current thread.
-                loader_job( &nicknames[i], jobz );
+                loader_job( &nicknames[i], jobz, budget );
             }
             else
             {
                 // Delegate the job to a worker thread created here.
                 threads.push_back( new boost::thread( &FOOTPRINT_LIST::loader_job,
-                        this, &nicknames[i], jobz ) );
+                        this, &nicknames[i], jobz, budget ) );
             }
 
             i += jobz;
@@ -258,7 +299,7 @@ bool FOOTPRINT_LIST::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* a
             threads[i].join();
         }
 #else
-        loader_job( &nicknames[0], nicknames.size() );
+        loader_job( &nicknames[0], nicknames.size(), 0 );
 #endif
 
         m_list.sort();
@@ -0,0 +1,340 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file fp_info_index.cpp
+ * @brief Summary of the footprints of a *.pretty library, saved in the user's cache.
+ */
+
+#include <fctsys.h>
+#include <cstring>
+#include <map>
+
+#include <macros.h>
+#include <wildcards_and_files_ext.h>
+#include <fp_info_index.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/utils.h>
+
+
+/*  The index is a binary file, all the values are stored little endian:
+ *
+ *      "KiCadFPI"                      magic, 8 bytes
+ *      version                         32 bits, INDEX_VERSION
+ *      library path                    32 bits byte count + UTF8 bytes
+ *      entry count                     32 bits
+ *      entries:
+ *          name, description, keywords strings: 32 bits byte count + UTF8 bytes
+ *          pad count                   32 bits
+ *          file modification time      64 bits, milliseconds since the Epoch
+ */
+
+static const char       INDEX_MAGIC[8] = { 'K', 'i', 'C', 'a', 'd', 'F', 'P', 'I' };
+static const unsigned   INDEX_VERSION  = 2;
+
+// Sanity limit of the length of a string read back, for truncated or damaged files
+static const unsigned   MAX_STRING_LEN = 1 << 20;
+
+
+static void writeUInt( FILE* aFile, unsigned long long aValue, int aBytes )
+{
+    for( int ii = 0; ii < aBytes; ii++ )
+        putc( (int) ( ( aValue >> ( 8 * ii ) ) & 0xFF ), aFile );
+}
+
+
+static void writeString( FILE* aFile, const wxString& aString )
+{
+    std::string utf8 = TO_UTF8( aString );
+
+    writeUInt( aFile, utf8.size(), 4 );
+    fwrite( utf8.data(), 1, utf8.size(), aFile );
+}
+
+
+static bool readUInt( FILE* aFile, unsigned long long& aValue, int aBytes )
+{
+    aValue = 0;
+
+    for( int ii = 0; ii < aBytes; ii++ )
+    {
+        int c = getc( aFile );
+
+        if( c == EOF )
+            return false;
+
+        aValue |= (unsigned long long) c << ( 8 * ii );
+    }
+
+    return true;
+}
+
+
+static bool readString( FILE* aFile, wxString& aString )
+{
+    unsigned long long len;
+
+    if( !readUInt( aFile, len, 4 ) || len > MAX_STRING_LEN )
+        return false;
+
+    std::string utf8( (size_t) len, ' ' );
+
+    if( len && fread( &utf8[0], 1, utf8.size(), aFile ) != utf8.size() )
+        return false;
+
+    aString = FROM_UTF8( utf8.c_str() );
+    return true;
+}
+
+
+FP_INFO_INDEX::FP_INFO_INDEX( const wxString& aLibraryPath )
+{
+    // The same library can be given with or without a trailing separator, or a relative path.
+    wxFileName dir = wxFileName::DirName( aLibraryPath );
+
+    dir.Normalize();
+    m_lib_path = dir.GetPath();
+}
+
+
+void FP_INFO_INDEX::Add( const wxString& aName, const wxString& aDoc, const wxString& aKeywords,
+                         int aPadCount, const wxDateTime& aModTime )
+{
+    ENTRY entry;
+
+    entry.m_Name     = aName;
+    entry.m_Doc      = aDoc;
+    entry.m_Keywords = aKeywords;
+    entry.m_PadCount = aPadCount;
+    entry.m_ModTime  = aModTime;
+
+    m_entries.push_back( entry );
+}
+
+
+bool FP_INFO_INDEX::Read()
+{
+    m_entries.clear();
+
+    if( !wxFileName::FileExists( indexFileName() ) )
+        return false;
+
+    FILE* file = wxFopen( indexFileName(), wxT( "rb" ) );
+
+    if( !file )
+        return false;
+
+    char                magic[sizeof( INDEX_MAGIC )];
+    unsigned long long  version;
+    wxString            libPath;
+    unsigned long long  count;
+
+    // The library path is checked, in case two paths give the same file name.
+    bool                ok = fread( magic, 1, sizeof( magic ), file ) == sizeof( magic )
+                             && !memcmp( magic, INDEX_MAGIC, sizeof( magic ) )
+                             && readUInt( file, version, 4 ) && version == INDEX_VERSION
+                             && readString( file, libPath ) && libPath == m_lib_path
+                             && readUInt( file, count, 4 );
+
+    for( unsigned long long ii = 0; ok && ii < count; ii++ )
+    {
+        ENTRY               entry;
+        unsigned long long  padCount;
+        unsigned long long  modTime;
+
+        ok = readString( file, entry.m_Name )
+             && readString( file, entry.m_Doc )
+             && readString( file, entry.m_Keywords )
+             && readUInt( file, padCount, 4 )
+             && readUInt( file, modTime, 8 );
+
+        if( ok )
+        {
+            entry.m_PadCount = (int) padCount;
+            entry.m_ModTime  = wxDateTime( wxLongLong( (wxLongLong_t) modTime ) );
+            m_entries.push_back( entry );
+        }
+    }
+
+    fclose( file );
+
+    if( !ok || !isUpToDate() )
+    {
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+void FP_INFO_INDEX::Write() throw( IO_ERROR )
+{
+    wxFileName dir = wxFileName::DirName( indexDirectory() );
+
+    if( !dir.DirExists() && !dir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Cannot create footprint index path '%s'" ),
+                                          GetChars( dir.GetPath() ) ) );
+    }
+
+    // Written under a temporary name, then renamed, so another process reading the index
+    // never sees a partial file.
+    wxString    tmpFileName = indexFileName() + wxString::Format( wxT( ".%lu" ),
+                                                                  wxGetProcessId() );
+    FILE*       file = wxFopen( tmpFileName, wxT( "wb" ) );
+
+    if( !file )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Cannot create footprint index file '%s'" ),
+                                          GetChars( tmpFileName ) ) );
+    }
+
+    fwrite( INDEX_MAGIC, 1, sizeof( INDEX_MAGIC ), file );
+    writeUInt( file, INDEX_VERSION, 4 );
+    writeString( file, m_lib_path );
+    writeUInt( file, m_entries.size(), 4 );
+
+    for( unsigned ii = 0; ii < m_entries.size(); ii++ )
+    {
+        const ENTRY& entry = m_entries[ii];
+
+        writeString( file, entry.m_Name );
+        writeString( file, entry.m_Doc );
+        writeString( file, entry.m_Keywords );
+        writeUInt( file, (unsigned) entry.m_PadCount, 4 );
+        writeUInt( file, (unsigned long long) entry.m_ModTime.GetValue().GetValue(), 8 );
+    }
+
+    bool failed = ferror( file ) != 0;
+
+    if( fclose( file ) != 0 || failed || !wxRenameFile( tmpFileName, indexFileName(), true ) )
+    {
+        // Do not leave a truncated index behind
+        wxRemoveFile( tmpFileName );
+
+        THROW_IO_ERROR( wxString::Format( _( "Cannot write footprint index file '%s'" ),
+                                          GetChars( indexFileName() ) ) );
+    }
+}
+
+
+wxString FP_INFO_INDEX::indexFileName() const
+{
+    // 64 bits FNV-1a hash of the library path
+    std::string         utf8 = TO_UTF8( m_lib_path );
+    unsigned long long  hash = 14695981039346656037ULL;
+
+    for( unsigned ii = 0; ii < utf8.size(); ii++ )
+    {
+        hash ^= (unsigned char) utf8[ii];
+        hash *= 1099511628211ULL;
+    }
+
+    wxString name = wxString::Format( wxT( "%08lx%08lx" ),
+                                      (unsigned long) ( hash >> 32 ),
+                                      (unsigned long) ( hash & 0xFFFFFFFF ) );
+
+    return wxFileName( indexDirectory(), name ).GetFullPath();
+}
+
+
+wxString FP_INFO_INDEX::indexDirectory()
+{
+    wxFileName  dir;
+
+#if defined( __WINDOWS__ )
+    dir.AssignDir( wxStandardPaths::Get().GetUserLocalDataDir() );
+    dir.RemoveLastDir();
+    dir.AppendDir( wxT( "kicad" ) );
+#elif defined( __WXMAC__ )
+    dir.AssignDir( wxGetHomeDir() );
+    dir.AppendDir( wxT( "Library" ) );
+    dir.AppendDir( wxT( "Caches" ) );
+    dir.AppendDir( wxT( "kicad" ) );
+#else
+    wxString    cacheHome;
+
+    if( wxGetEnv( wxT( "XDG_CACHE_HOME" ), &cacheHome ) && !cacheHome.IsEmpty() )
+    {
+        dir.AssignDir( cacheHome );
+    }
+    else
+    {
+        dir.AssignDir( wxGetHomeDir() );
+        dir.AppendDir( wxT( ".cache" ) );
+    }
+
+    dir.AppendDir( wxT( "kicad" ) );
+#endif
+
+    dir.AppendDir( wxT( "fp-info-index" ) );
+
+    return dir.GetPath();
+}
+
+
+bool FP_INFO_INDEX::isUpToDate() const
+{
+    typedef std::map<wxString, const ENTRY*> NAME_MAP;
+
+    NAME_MAP byName;
+
+    for( unsigned ii = 0; ii < m_entries.size(); ii++ )
+        byName[ m_entries[ii].m_Name ] = &m_entries[ii];
+
+    // Duplicated names
+    if( byName.size() != m_entries.size() )
+        return false;
+
+    wxDir dir( m_lib_path );
+
+    if( !dir.IsOpened() )
+        return false;
+
+    wxString fpFileName;
+    wxString wildcard = wxT( "*." ) + KiCadFootprintFileExtension;
+    unsigned found = 0;
+
+    if( dir.GetFirst( &fpFileName, wildcard, wxDIR_FILES ) )
+    {
+        do
+        {
+            wxFileName fullPath( m_lib_path, fpFileName );
+
+            NAME_MAP::const_iterator it = byName.find( fullPath.GetName() );
+
+            // A footprint added or modified since the index was written
+            if( it == byName.end() || it->second->m_ModTime != fullPath.GetModificationTime() )
+                return false;
+
+            found++;
+        } while( dir.GetNext( &fpFileName ) );
+    }
+
+    // All the footprints must still be there
+    return found == m_entries.size();
+}
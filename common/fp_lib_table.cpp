@@ -147,11 +147,26 @@ FP_LIB_TABLE::FP_LIB_TABLE( FP_LIB_TABLE* aFallBackTable ) :
 }
 
 
-wxArrayString FP_LIB_TABLE::FootprintEnumerate( const wxString& aNickname )
+wxArrayString FP_LIB_TABLE::FootprintEnumerate( const wxString& aNickname,
+                                                 unsigned aThreadBudget )
 {
     const ROW* row = FindRow( aNickname );
     wxASSERT( (PLUGIN*) row->plugin );
-    return row->plugin->FootprintEnumerate( row->GetFullURI( true ), row->GetProperties() );
+
+    if( !aThreadBudget )
+        return row->plugin->FootprintEnumerate( row->GetFullURI( true ), row->GetProperties() );
+
+    // The row options, plus the budget
+    PROPERTIES  props;
+    char        budget[16];
+
+    if( row->GetProperties() )
+        props = *row->GetProperties();
+
+    sprintf( budget, "%u", aThreadBudget );
+    props[ PROPERTY_THREAD_BUDGET ] = budget;
+
+    return row->plugin->FootprintEnumerate( row->GetFullURI( true ), &props );
 }
 
 
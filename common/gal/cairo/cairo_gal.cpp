@@ -51,6 +51,7 @@ CAIRO_GAL::CAIRO_GAL( wxWindow* aParent, wxEvtHandler* aMouseListener,
     isInitialized       = false;
     isDeleteSavedPixels = false;
     validCompositor     = false;
+    isOffscreen         = false;
     groupCounter        = 0;
 
     // Connecting the event handlers
@@ -120,6 +121,12 @@ void CAIRO_GAL::EndDrawing()
     compositor->DrawBuffer( mainBuffer );
     compositor->DrawBuffer( overlayBuffer );
 
+    if( isOffscreen )
+    {
+        deinitSurface();
+        return;
+    }
+
     // This code was taken from the wxCairo example - it's not the most efficient one
     // Here is a good place for optimizations
 
@@ -250,6 +257,24 @@ void CAIRO_GAL::DrawPolyline( std::deque<VECTOR2D>& aPointList )
 }
 
 
+void CAIRO_GAL::DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                               const std::vector<unsigned int>& aStarts )
+{
+    // All the polylines become subpaths of a single path, so they are stroked at once
+    for( unsigned int i = 0; i < aStarts.size(); ++i )
+    {
+        unsigned int end = ( i + 1 < aStarts.size() ) ? aStarts[i + 1] : aPoints.size();
+
+        cairo_move_to( currentContext, aPoints[aStarts[i]].x, aPoints[aStarts[i]].y );
+
+        for( unsigned int j = aStarts[i] + 1; j < end; ++j )
+            cairo_line_to( currentContext, aPoints[j].x, aPoints[j].y );
+    }
+
+    isElementAdded = true;
+}
+
+
 void CAIRO_GAL::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
 {
     // Iterate over the point list and draw the polygon
@@ -0,0 +1,201 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file frame_profiler.cpp
+ * @brief Lightweight per-frame timers and counters for the GAL rendering pipeline.
+ */
+
+#include <gal/frame_profiler.h>
+
+#include <cstdio>
+
+using namespace KIGFX;
+
+static const char* counterNames[FRAME_PROFILER::COUNTERS_NUMBER] =
+{
+    "items_queried",
+    "items_drawn",
+    "items_culled",
+    "groups_cached",
+    "bytes_uploaded"
+};
+
+
+FRAME_PROFILER& FRAME_PROFILER::Instance()
+{
+    static FRAME_PROFILER profiler;
+
+    return profiler;
+}
+
+
+FRAME_PROFILER::FRAME_PROFILER() :
+    m_enabled( false ), m_inFrame( false ), m_depth( 0 ), m_historySize( 100 )
+{
+    resetCurrent();
+}
+
+
+void FRAME_PROFILER::Enable( bool aEnable )
+{
+    m_enabled = aEnable;
+    m_inFrame = false;
+    m_depth   = 0;
+
+    m_frames.clear();
+    resetCurrent();
+}
+
+
+void FRAME_PROFILER::SetHistorySize( unsigned int aSize )
+{
+    m_historySize = aSize;
+
+    while( m_frames.size() > m_historySize )
+        m_frames.pop_front();
+}
+
+
+void FRAME_PROFILER::BeginFrame()
+{
+    if( !m_enabled )
+        return;
+
+    // Stages measured between frames (e.g. recaching after loading a board) are reported
+    // as a part of the next frame
+    m_current.start = get_tics();
+    m_inFrame = true;
+}
+
+
+void FRAME_PROFILER::EndFrame()
+{
+    if( !m_enabled || !m_inFrame )
+        return;
+
+    m_current.end = get_tics();
+    m_inFrame = false;
+
+    m_frames.push_back( m_current );
+
+    while( m_frames.size() > m_historySize )
+        m_frames.pop_front();
+
+    resetCurrent();
+}
+
+
+int FRAME_PROFILER::beginEvent( const char* aName )
+{
+    EVENT event;
+
+    event.name  = aName;
+    event.start = get_tics();
+    event.end   = event.start;
+    event.depth = m_depth++;
+
+    m_current.events.push_back( event );
+
+    return m_current.events.size() - 1;
+}
+
+
+void FRAME_PROFILER::endEvent( int aEvent )
+{
+    // The profiler could have been reset while the stage was being measured
+    if( (unsigned) aEvent >= m_current.events.size() )
+        return;
+
+    m_current.events[aEvent].end = get_tics();
+    --m_depth;
+}
+
+
+void FRAME_PROFILER::resetCurrent()
+{
+    m_current.start = get_tics();
+    m_current.end   = m_current.start;
+    m_current.events.clear();
+
+    for( int i = 0; i < COUNTERS_NUMBER; ++i )
+        m_current.counters[i] = 0;
+}
+
+
+bool FRAME_PROFILER::SaveTrace( const std::string& aFileName ) const
+{
+    FILE* file = fopen( aFileName.c_str(), "wt" );
+
+    if( !file )
+        return false;
+
+    fprintf( file, "{\"traceEvents\":[\n" );
+
+    bool first = true;
+
+    for( std::deque<FRAME>::const_iterator it = m_frames.begin(); it != m_frames.end(); ++it )
+    {
+        const FRAME& frame = *it;
+
+        fprintf( file, "%s{\"name\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"
+                 "\"ts\":%llu,\"dur\":%llu,\"args\":{",
+                 first ? "" : ",\n",
+                 (unsigned long long) frame.start,
+                 (unsigned long long) ( frame.end - frame.start ) );
+        first = false;
+
+        for( int i = 0; i < COUNTERS_NUMBER; ++i )
+        {
+            fprintf( file, "%s\"%s\":%lld", i > 0 ? "," : "", counterNames[i],
+                     (long long) frame.counters[i] );
+        }
+
+        fprintf( file, "}}" );
+
+        for( std::vector<EVENT>::const_iterator ev = frame.events.begin();
+             ev != frame.events.end(); ++ev )
+        {
+            fprintf( file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"
+                     "\"ts\":%llu,\"dur\":%llu}",
+                     ev->name, (unsigned long long) ev->start,
+                     (unsigned long long) ( ev->end - ev->start ) );
+        }
+
+        // Counters are displayed as graphs in the trace viewer
+        fprintf( file, ",\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"ts\":%llu,\"args\":{",
+                 (unsigned long long) frame.start );
+
+        for( int i = 0; i < COUNTERS_NUMBER; ++i )
+        {
+            fprintf( file, "%s\"%s\":%lld", i > 0 ? "," : "", counterNames[i],
+                     (long long) frame.counters[i] );
+        }
+
+        fprintf( file, "}}" );
+    }
+
+    fprintf( file, "\n]}\n" );
+
+    return fclose( file ) == 0;
+}
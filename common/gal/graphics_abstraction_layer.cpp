@@ -56,8 +56,6 @@ GAL::GAL() :
     SetCursorColor( COLOR4D( 1.0, 1.0, 1.0, 1.0 ) );
     SetCursorSize( 80 );
     SetCursorEnabled( false );
-
-    strokeFont.LoadNewStrokeFont( newstroke_font, newstroke_font_bufsize );
 }
 
 
@@ -77,6 +75,21 @@ void GAL::SetTextAttributes( const EDA_TEXT* aText )
 }
 
 
+void GAL::DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                         const std::vector<unsigned int>& aStarts )
+{
+    std::deque<VECTOR2D> pointList;
+
+    for( unsigned int i = 0; i < aStarts.size(); ++i )
+    {
+        unsigned int end = ( i + 1 < aStarts.size() ) ? aStarts[i + 1] : aPoints.size();
+
+        pointList.assign( aPoints.begin() + aStarts[i], aPoints.begin() + end );
+        DrawPolyline( pointList );
+    }
+}
+
+
 void GAL::ComputeWorldScreenMatrix()
 {
     ComputeWorldScale();
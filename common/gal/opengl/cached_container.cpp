@@ -33,6 +33,7 @@
 #include <gal/opengl/vertex_manager.h>
 #include <gal/opengl/vertex_item.h>
 #include <gal/opengl/shader.h>
+#include <gal/frame_profiler.h>
 #include <confirm.h>
 #include <wx/log.h>
 #include <list>
@@ -213,6 +214,8 @@ VERTEX* CACHED_CONTAINER::GetVertices( const VERTEX_ITEM* aItem ) const
 
 unsigned int CACHED_CONTAINER::reallocate( unsigned int aSize )
 {
+    FRAME_PROFILER_SCOPE profile( "CACHED_CONTAINER::reallocate" );
+
     wxASSERT( aSize > 0 );
 
 #if CACHED_CONTAINER_TEST > 2
@@ -302,6 +305,8 @@ unsigned int CACHED_CONTAINER::reallocate( unsigned int aSize )
 
 bool CACHED_CONTAINER::defragment( VERTEX* aTarget )
 {
+    FRAME_PROFILER_SCOPE profile( "CACHED_CONTAINER::defragment" );
+
 #if CACHED_CONTAINER_TEST > 0
     wxLogDebug( wxT( "Defragmenting" ) );
 
@@ -421,6 +426,8 @@ void CACHED_CONTAINER::mergeFreeChunks()
 
 bool CACHED_CONTAINER::resizeContainer( unsigned int aNewSize )
 {
+    FRAME_PROFILER_SCOPE profile( "CACHED_CONTAINER::resizeContainer" );
+
     wxASSERT( aNewSize != m_currentSize );
 
 #if CACHED_CONTAINER_TEST > 0
@@ -31,6 +31,7 @@
 #include <gal/opengl/cached_container.h>
 #include <gal/opengl/noncached_container.h>
 #include <gal/opengl/shader.h>
+#include <gal/frame_profiler.h>
 #include <typeinfo>
 #include <wx/msgdlg.h>
 #include <confirm.h>
@@ -187,6 +188,8 @@ void GPU_CACHED_MANAGER::EndDrawing()
 
 void GPU_CACHED_MANAGER::uploadToGpu()
 {
+    FRAME_PROFILER_SCOPE profile( "GPU_CACHED_MANAGER::uploadToGpu" );
+
 #ifdef __WXDEBUG__
     prof_counter totalTime;
     prof_start( &totalTime );
@@ -202,6 +205,8 @@ void GPU_CACHED_MANAGER::uploadToGpu()
     glBindBuffer( GL_ARRAY_BUFFER, m_verticesBuffer );
     glBufferData( GL_ARRAY_BUFFER, bufferSize * VertexSize, vertices, GL_DYNAMIC_DRAW );
     glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    FRAME_PROFILER::Instance().AddCount( FRAME_PROFILER::BYTES_UPLOADED,
+                                         (int64_t) bufferSize * VertexSize );
 
     // Allocate the biggest possible buffer for indices
     m_indices.reset( new GLuint[bufferSize] );
@@ -28,6 +28,7 @@
 
 #include <gal/opengl/opengl_gal.h>
 #include <gal/definitions.h>
+#include <gal/frame_profiler.h>
 
 #include <wx/log.h>
 #include <macros.h>
@@ -117,6 +118,8 @@ OPENGL_GAL::~OPENGL_GAL()
 
 void OPENGL_GAL::BeginDrawing()
 {
+    FRAME_PROFILER_SCOPE profile( "OPENGL_GAL::BeginDrawing" );
+
     SetCurrent( *glContext );
 
     clientDC = new wxClientDC( this );
@@ -219,6 +222,8 @@ void OPENGL_GAL::BeginDrawing()
 
 void OPENGL_GAL::EndDrawing()
 {
+    FRAME_PROFILER_SCOPE profile( "OPENGL_GAL::EndDrawing" );
+
     // Cached & non-cached containers are rendered to the same buffer
     compositor.SetBuffer( mainBuffer );
     nonCachedManager.EndDrawing();
@@ -486,6 +491,36 @@ void OPENGL_GAL::DrawPolyline( std::deque<VECTOR2D>& aPointList )
 }
 
 
+void OPENGL_GAL::DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                                const std::vector<unsigned int>& aStarts )
+{
+    for( unsigned int i = 0; i < aStarts.size(); ++i )
+    {
+        unsigned int start = aStarts[i];
+        unsigned int end   = ( i + 1 < aStarts.size() ) ? aStarts[i + 1] : aPoints.size();
+
+        if( end - start < 2 )
+            continue;
+
+        for( unsigned int j = start + 1; j < end; ++j )
+        {
+            const VECTOR2D startEndVector = aPoints[j] - aPoints[j - 1];
+            double lineAngle = startEndVector.Angle();
+
+            drawLineQuad( aPoints[j - 1], aPoints[j] );
+
+            // There is no need to draw line caps on both ends of polyline's segments
+            drawFilledSemiCircle( aPoints[j - 1], lineWidth / 2, lineAngle + M_PI / 2 );
+        }
+
+        // ..and now - draw the ending cap
+        const VECTOR2D startEndVector = aPoints[end - 1] - aPoints[end - 2];
+        double lineAngle = startEndVector.Angle();
+        drawFilledSemiCircle( aPoints[end - 1], lineWidth / 2, lineAngle - M_PI / 2 );
+    }
+}
+
+
 void OPENGL_GAL::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
 {
     // Any non convex polygon needs to be tesselated
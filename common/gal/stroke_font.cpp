@@ -38,6 +38,7 @@ const double STROKE_FONT::HERSHEY_SCALE = 1.0 / 21.0;
 
 STROKE_FONT::STROKE_FONT( GAL* aGal ) :
     m_gal( aGal ),
+    m_glyphs( &STROKE_GLYPH_TABLE::NewStroke() ),
     m_bold( false ),
     m_italic( false ),
     m_mirrored( false )
@@ -51,67 +52,8 @@ STROKE_FONT::STROKE_FONT( GAL* aGal ) :
 
 bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
 {
-    m_glyphs.clear();
-    m_glyphBoundingBoxes.clear();
-    m_glyphs.resize( aNewStrokeFontSize );
-    m_glyphBoundingBoxes.resize( aNewStrokeFontSize );
-
-    for( int j = 0; j < aNewStrokeFontSize; j++ )
-    {
-        GLYPH    glyph;
-        double   glyphStartX = 0.0;
-        double   glyphEndX = 0.0;
-        VECTOR2D glyphBoundingX;
-
-        std::deque<VECTOR2D> pointList;
-
-        int i = 0;
-
-        while( aNewStrokeFont[j][i] )
-        {
-            VECTOR2D    point( 0.0, 0.0 );
-            char        coordinate[2] = { 0, };
-
-            for( int k = 0; k < 2; k++ )
-            {
-                coordinate[k] = aNewStrokeFont[j][i + k];
-            }
-
-            if( i < 2 )
-            {
-                // The first two values contain the width of the char
-                glyphStartX     = ( coordinate[0] - 'R' ) * HERSHEY_SCALE;
-                glyphEndX       = ( coordinate[1] - 'R' ) * HERSHEY_SCALE;
-                glyphBoundingX  = VECTOR2D( 0, glyphEndX - glyphStartX );
-            }
-            else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
-            {
-                // Raise pen
-                if( pointList.size() > 0 )
-                    glyph.push_back( pointList );
-
-                pointList.clear();
-            }
-            else
-            {
-                // Every coordinate description of the Hershey format has an offset,
-                // it has to be subtracted
-                point.x = (double) ( coordinate[0] - 'R' ) * HERSHEY_SCALE - glyphStartX;
-                point.y = (double) ( coordinate[1] - 'R' ) * HERSHEY_SCALE;
-                pointList.push_back( point );
-            }
-
-            i += 2;
-        }
-
-        if( pointList.size() > 0 )
-            glyph.push_back( pointList );
-
-        m_glyphs[j] = glyph;
-
-        // Compute the bounding box of the glyph
-        m_glyphBoundingBoxes[j] = computeBoundingBox( glyph, glyphBoundingX );
-    }
+    m_ownGlyphs.reset( new STROKE_GLYPH_TABLE( aNewStrokeFont, aNewStrokeFontSize ) );
+    m_glyphs = m_ownGlyphs.get();
 
     return true;
 }
@@ -123,30 +65,6 @@ int STROKE_FONT::getInterline() const
 }
 
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGLYPH, const VECTOR2D& aGLYPHBoundingX ) const
-{
-    BOX2D boundingBox;
-
-    std::deque<VECTOR2D> boundingPoints;
-
-    boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, 0 ) );
-    boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.y, 0 ) );
-
-    for( GLYPH::const_iterator pointListIt = aGLYPH.begin(); pointListIt != aGLYPH.end(); ++pointListIt )
-    {
-        for( std::deque<VECTOR2D>::const_iterator pointIt = pointListIt->begin();
-                pointIt != pointListIt->end(); ++pointIt )
-        {
-            boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, pointIt->y ) );
-        }
-    }
-
-    boundingBox.Compute( boundingPoints );
-
-    return boundingBox;
-}
-
-
 void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRotationAngle )
 {
     // Context needs to be saved before any transformations
@@ -252,6 +170,13 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         xOffset = 0.0;
     }
 
+    // The whole line is tessellated first and then drawn at once
+    m_points.clear();
+    m_strokeStarts.clear();
+
+    const double scaleX = glyphSize.x * HERSHEY_SCALE;
+    const double scaleY = glyphSize.y * HERSHEY_SCALE;
+
     for( UTF8::uni_iter chIt = aText.ubegin(), end = aText.uend(); chIt < end; ++chIt )
     {
         // Toggle overbar
@@ -266,32 +191,27 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             // If it is a double tilda, just process the second one
         }
 
-        unsigned dd = *chIt - ' ';
-
-        if( dd >= m_glyphBoundingBoxes.size() || dd < 0 )
-            dd = '?' - ' ';
-
-        GLYPH& glyph = m_glyphs[dd];
-        BOX2D& bbox  = m_glyphBoundingBoxes[dd];
+        const STROKE_GLYPH_TABLE::GLYPH& glyph = m_glyphs->GetGlyph( *chIt );
+        double advance = scaleX * glyph.advance;
 
         if( m_overbar )
         {
             VECTOR2D startOverbar( xOffset, -getInterline() * OVERBAR_HEIGHT );
-            VECTOR2D endOverbar( xOffset + glyphSize.x * bbox.GetEnd().x,
-                                 -getInterline() * OVERBAR_HEIGHT );
+            VECTOR2D endOverbar( xOffset + advance, -getInterline() * OVERBAR_HEIGHT );
 
-            m_gal->DrawLine( startOverbar, endOverbar );
+            addLine( startOverbar, endOverbar );
         }
 
-        for( GLYPH::iterator pointListIt = glyph.begin(); pointListIt != glyph.end();
-             ++pointListIt )
+        unsigned int lastStroke = glyph.firstStroke + glyph.strokeCount;
+
+        for( unsigned int stroke = glyph.firstStroke; stroke < lastStroke; ++stroke )
         {
-            std::deque<VECTOR2D> pointListScaled;
+            m_strokeStarts.push_back( m_points.size() );
 
-            for( std::deque<VECTOR2D>::iterator pointIt = pointListIt->begin();
-                 pointIt != pointListIt->end(); ++pointIt )
+            for( const STROKE_GLYPH_TABLE::POINT* point = m_glyphs->StrokeBegin( stroke ),
+                 *strokeEnd = m_glyphs->StrokeEnd( stroke ); point != strokeEnd; ++point )
             {
-                VECTOR2D pointPos( pointIt->x * glyphSize.x + xOffset, pointIt->y * glyphSize.y );
+                VECTOR2D pointPos( point->x * scaleX + xOffset, point->y * scaleY );
 
                 if( m_italic )
                 {
@@ -303,15 +223,16 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                         pointPos.x -= pointPos.y * 0.1;
                 }
 
-                pointListScaled.push_back( pointPos );
+                m_points.push_back( pointPos );
             }
-
-            m_gal->DrawPolyline( pointListScaled );
         }
 
-        xOffset += glyphSize.x * bbox.GetEnd().x;
+        xOffset += advance;
     }
 
+    if( !m_strokeStarts.empty() )
+        m_gal->DrawPolylines( m_points, m_strokeStarts );
+
     m_gal->Restore();
 }
 
@@ -333,13 +254,7 @@ VECTOR2D STROKE_FONT::computeTextSize( const UTF8& aText ) const
                 break;
         }
 
-        // Index in the bounding boxes table
-        unsigned dd = *it - ' ';
-
-        if( dd >= m_glyphBoundingBoxes.size() || dd < 0 )
-            dd = '?' - ' ';
-
-        result.x += m_glyphSize.x * m_glyphBoundingBoxes[dd].GetEnd().x;
+        result.x += m_glyphSize.x * HERSHEY_SCALE * m_glyphs->GetGlyph( *it ).advance;
     }
 
     return result;
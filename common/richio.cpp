@@ -441,9 +441,10 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... ) throw( IO_ERRO
     for( int i=0; i<nestLevel;  ++i )
     {
         // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        // Same as sprint( "%*c", NESTWIDTH, ' ' ), without printf().
+        write( "        ", NESTWIDTH );
 
-        total += result;
+        total += NESTWIDTH;
     }
 
     // no error checking needed, an exception indicates an error.
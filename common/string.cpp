@@ -197,7 +197,8 @@ char* GetLine( FILE* File, char* Line, int* LineNum, int SizeLine )
 
     } while( Line[0] == '#' || Line[0] == '\n' ||  Line[0] == '\r' || Line[0] == 0 );
 
-    strtok( Line, "\n\r" );
+    // Strip the end of line.  Not with strtok(), which is not reentrant.
+    Line[ strcspn( Line, "\n\r" ) ] = 0;
     return Line;
 }
 
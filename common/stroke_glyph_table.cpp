@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file stroke_glyph_table.cpp
+ * @brief Decoded Hershey (newstroke) glyphs stored in contiguous arrays.
+ */
+
+#include <cstring>
+
+#include <stroke_glyph_table.h>
+#include <newstroke_font.h>
+
+
+const STROKE_GLYPH_TABLE& STROKE_GLYPH_TABLE::NewStroke()
+{
+    static const STROKE_GLYPH_TABLE table( newstroke_font, newstroke_font_bufsize );
+
+    return table;
+}
+
+
+STROKE_GLYPH_TABLE::STROKE_GLYPH_TABLE( const char* const aFont[], int aGlyphCount )
+{
+    unsigned totalSize = 0;
+
+    for( int i = 0; i < aGlyphCount; ++i )
+        totalSize += strlen( aFont[i] ) / 2;
+
+    // Upper bounds, every coordinate pair is either a point or a pen up
+    m_points.reserve( totalSize );
+    m_strokes.reserve( totalSize + 1 );
+    m_glyphs.resize( aGlyphCount );
+
+    for( int i = 0; i < aGlyphCount; ++i )
+    {
+        const char* shape = aFont[i];
+        GLYPH&      glyph = m_glyphs[i];
+
+        // The first two values contain the horizontal extents of the glyph
+        int xStart = shape[0] - 'R';
+        int xEnd   = shape[1] - 'R';
+
+        glyph.advance     = xEnd - xStart;
+        glyph.firstStroke = m_strokes.size();
+
+        unsigned strokeStart = m_points.size();
+
+        for( shape += 2; shape[0] && shape[1]; shape += 2 )
+        {
+            if( shape[0] == ' ' && shape[1] == 'R' )
+            {
+                // Raise pen
+                if( m_points.size() > strokeStart )
+                    m_strokes.push_back( strokeStart );
+
+                strokeStart = m_points.size();
+            }
+            else
+            {
+                // Every coordinate of the Hershey format has an offset, it has to be subtracted
+                POINT point;
+                point.x = shape[0] - 'R' - xStart;
+                point.y = shape[1] - 'R';
+                m_points.push_back( point );
+            }
+        }
+
+        if( m_points.size() > strokeStart )
+            m_strokes.push_back( strokeStart );
+
+        glyph.strokeCount = m_strokes.size() - glyph.firstStroke;
+    }
+
+    // Sentinel, so the end of the last stroke can be found the same way as for the others
+    m_strokes.push_back( m_points.size() );
+
+    // StrokeEnd() for the last stroke has to point past the last point
+    if( m_points.empty() )
+        m_points.resize( 1 );
+}
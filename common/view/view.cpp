@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <map>
+#include <cstdlib>
 #include <boost/foreach.hpp>
 
 #include <base_struct.h>
@@ -32,6 +34,7 @@
 #include <view/view_rtree.h>
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <gal/frame_profiler.h>
 #include <painter.h>
 
 #ifdef __WXDEBUG__
@@ -46,6 +49,8 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_painter( NULL ),
     m_gal( NULL ),
     m_dynamic( aIsDynamic ),
+    m_drawnItems( 0 ),
+    m_culledItems( 0 ),
     m_scaleLimits( 150000000000.0, 0.0000000000001 )
 {
     m_panBoundary.SetMaximum();
@@ -85,6 +90,7 @@ void VIEW::AddLayer( int aLayer, bool aDisplayOnly )
         m_layers[aLayer].enabled        = true;
         m_layers[aLayer].displayOnly    = aDisplayOnly;
         m_layers[aLayer].target         = TARGET_CACHED;
+        m_layers[aLayer].minScreenSize  = 0.0;
     }
 
     sortLayers();
@@ -110,6 +116,34 @@ void VIEW::Add( VIEW_ITEM* aItem )
 }
 
 
+void VIEW::Add( const std::vector<VIEW_ITEM*>& aItems )
+{
+    int layers[VIEW_MAX_LAYERS], layers_count;
+    std::map<int, std::vector<VIEW_ITEM*> > layerItems;
+
+    // Sort the items by layers, so every layer index can be built at once
+    BOOST_FOREACH( VIEW_ITEM* item, aItems )
+    {
+        item->ViewGetLayers( layers, layers_count );
+        item->saveLayers( layers, layers_count );
+
+        for( int i = 0; i < layers_count; i++ )
+            layerItems[layers[i]].push_back( item );
+
+        if( m_dynamic )
+            item->viewAssign( this );
+    }
+
+    for( std::map<int, std::vector<VIEW_ITEM*> >::const_iterator it = layerItems.begin();
+         it != layerItems.end(); ++it )
+    {
+        VIEW_LAYER& l = m_layers[it->first];
+        l.items->BulkLoad( it->second );
+        MarkTargetDirty( l.target );
+    }
+}
+
+
 void VIEW::Remove( VIEW_ITEM* aItem )
 {
     if( m_dynamic )
@@ -577,29 +611,58 @@ struct VIEW::drawItem
     drawItem( VIEW* aView, const VIEW_LAYER* aCurrentLayer ) :
         currentLayer( aCurrentLayer ), view( aView )
     {
+        // Items smaller than the threshold (converted to world units) are not worth drawing
+        double worldScale = view->m_gal->GetWorldScale();
+
+        if( currentLayer->minScreenSize > 0.0 && worldScale > 0.0 )
+            minSize = currentLayer->minScreenSize / worldScale;
+        else
+            minSize = 0.0;
+
+        queried = 0;
     }
 
     bool operator()( VIEW_ITEM* aItem )
     {
+        ++queried;
+
         // Conditions that have te be fulfilled for an item to be drawn
         bool drawCondition = aItem->ViewIsVisible() &&
                              aItem->ViewGetLOD( currentLayer->id ) < view->m_scale;
         if( !drawCondition )
             return true;
 
+        if( minSize > 0.0 )
+        {
+            const BOX2I bbox = aItem->ViewBBox();
+
+            if( std::abs( bbox.GetWidth() ) < minSize && std::abs( bbox.GetHeight() ) < minSize )
+            {
+                ++view->m_culledItems;
+                return true;
+            }
+        }
+
         view->draw( aItem, currentLayer->id );
+        ++view->m_drawnItems;
 
         return true;
     }
 
     const VIEW_LAYER* currentLayer;
     VIEW* view;
-    int layersCount, layers[VIEW_MAX_LAYERS];
+    double minSize;
+    int queried;
 };
 
 
 void VIEW::redrawRect( const BOX2I& aRect )
 {
+    FRAME_PROFILER_SCOPE profile( "VIEW::redrawRect" );
+    int queriedItems = 0;
+
+    m_drawnItems = 0;
+    m_culledItems = 0;
 
     BOOST_FOREACH( VIEW_LAYER* l, m_orderedLayers )
     {
@@ -610,8 +673,14 @@ void VIEW::redrawRect( const BOX2I& aRect )
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
             l->items->Query( aRect, drawFunc );
+            queriedItems += drawFunc.queried;
         }
     }
+
+    FRAME_PROFILER& profiler = FRAME_PROFILER::Instance();
+    profiler.AddCount( FRAME_PROFILER::ITEMS_QUERIED, queriedItems );
+    profiler.AddCount( FRAME_PROFILER::ITEMS_DRAWN, m_drawnItems );
+    profiler.AddCount( FRAME_PROFILER::ITEMS_CULLED, m_culledItems );
 }
 
 
@@ -629,6 +698,8 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate ) const
         }
         else
         {
+            FRAME_PROFILER::Instance().AddCount( FRAME_PROFILER::GROUPS_CACHED );
+
             group = m_gal->BeginGroup();
             aItem->setGroup( aLayer, group );
 
@@ -715,6 +786,8 @@ struct VIEW::recacheItem
 
         if( immediately )
         {
+            FRAME_PROFILER::Instance().AddCount( FRAME_PROFILER::GROUPS_CACHED );
+
             int group = gal->BeginGroup();
             aItem->setGroup( layer, group );
 
@@ -782,6 +855,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    FRAME_PROFILER_SCOPE profile( "VIEW::Redraw" );
+
     VECTOR2D screenSize = m_gal->GetScreenPixelSize();
     BOX2I    rect( ToWorld( VECTOR2D( 0, 0 ) ),
                    ToWorld( screenSize ) - ToWorld( VECTOR2D( 0, 0 ) ) );
@@ -914,6 +989,8 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     if( prevGroup >= 0 )
         m_gal->DeleteGroup( prevGroup );
 
+    FRAME_PROFILER::Instance().AddCount( FRAME_PROFILER::GROUPS_CACHED );
+
     int group = m_gal->BeginGroup();
     aItem->setGroup( aLayer, group );
     m_painter->Draw( static_cast<EDA_ITEM*>( aItem ), aLayer );
@@ -984,6 +1061,8 @@ bool VIEW::areRequiredLayersEnabled( int aLayerId ) const
 
 void VIEW::RecacheAllItems( bool aImmediately )
 {
+    FRAME_PROFILER_SCOPE profile( "VIEW::RecacheAllItems" );
+
     BOX2I r;
 
     r.SetMaximum();
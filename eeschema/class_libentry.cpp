@@ -35,6 +35,7 @@
 #include <gr_basic.h>
 #include <class_sch_screen.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 
 #include <general.h>
 #include <template_fieldnames.h>
@@ -726,9 +727,12 @@ bool LIB_COMPONENT::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
     line = aLineReader.Line();
 
-    p = strtok( line, " \t\r\n" );
+    // Libraries are loaded by several threads: strtok() cannot be used to split lines.
+    LINE_TOKENIZER tokens( line );
 
-    if( strcmp( p, "DEF" ) != 0 )
+    p = tokens.NextToken();
+
+    if( p == NULL || strcmp( p, "DEF" ) != 0 )
     {
         aErrorMsg.Printf( wxT( "DEF command expected in line %d, aborted." ),
                           aLineReader.LineNumber() );
@@ -739,17 +743,17 @@ bool LIB_COMPONENT::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
     char drawnum = 0;
     char drawname = 0;
 
-    if( ( componentName = strtok( NULL, " \t\n" ) ) == NULL  // Part name:
-        || ( prefix = strtok( NULL, " \t\n" ) ) == NULL      // Prefix name:
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // NumOfPins:
+    if( ( componentName = tokens.NextToken() ) == NULL      // Part name:
+        || ( prefix = tokens.NextToken() ) == NULL          // Prefix name:
+        || ( p = tokens.NextToken() ) == NULL               // NumOfPins:
         || sscanf( p, "%d", &unused ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // TextInside:
+        || ( p = tokens.NextToken() ) == NULL               // TextInside:
         || sscanf( p, "%d", &m_pinNameOffset ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // DrawNums:
-        || sscanf( p, "%c", &drawnum ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // DrawNums:
-        || sscanf( p, "%c", &drawname ) != 1
-        || ( p = strtok( NULL, " \t\n" ) ) == NULL           // m_unitCount:
+        || ( p = tokens.NextToken() ) == NULL               // DrawNums:
+        || ( drawnum = *p ) == 0
+        || ( p = tokens.NextToken() ) == NULL               // DrawNums:
+        || ( drawname = *p ) == 0
+        || ( p = tokens.NextToken() ) == NULL               // m_unitCount:
         || sscanf( p, "%d", &m_unitCount ) != 1 )
     {
         aErrorMsg.Printf( wxT( "Wrong DEF format in line %d, skipped." ),
@@ -757,9 +761,9 @@ bool LIB_COMPONENT::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
         while( (line = aLineReader.ReadLine()) != NULL )
         {
-            p = strtok( line, " \t\n" );
+            p = LINE_TOKENIZER( line ).NextToken();
 
-            if( stricmp( p, "ENDDEF" ) == 0 )
+            if( p && stricmp( p, "ENDDEF" ) == 0 )
                 break;
         }
 
@@ -809,16 +813,21 @@ bool LIB_COMPONENT::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
     }
 
     // Copy optional infos
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL && *p == 'L' )
+    if( ( p = tokens.NextToken() ) != NULL && *p == 'L' )
         m_unitsLocked = true;
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL  && *p == 'P' )
+    if( ( p = tokens.NextToken() ) != NULL  && *p == 'P' )
         m_options = ENTRY_POWER;
 
     // Read next lines, until "ENDDEF" is found
     while( ( line = aLineReader.ReadLine() ) != NULL )
     {
-        p = strtok( line, " \t\r\n" );
+        LINE_TOKENIZER lineTokens( line );
+
+        p = lineTokens.NextToken();
+
+        if( p == NULL )         // blank line
+            p = line;
 
         // This is the error flag ( if an error occurs, result = false)
         result = true;
@@ -836,7 +845,7 @@ bool LIB_COMPONENT::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
             result = LoadDrawEntries( aLineReader, Msg );
         else if( strncmp( p, "ALIAS", 5 ) == 0 )
         {
-            p = strtok( NULL, "\r\n" );
+            p = lineTokens.Position();
             result = LoadAliases( p, aErrorMsg );
         }
         else if( strncmp( p, "$FPLIST", 5 ) == 0 )
@@ -952,13 +961,11 @@ bool LIB_COMPONENT::LoadDrawEntries( LINE_READER& aLineReader, wxString& aErrorM
 
 bool LIB_COMPONENT::LoadAliases( char* aLine, wxString& aErrorMsg )
 {
-    char* text = strtok( aLine, " \t\r\n" );
+    LINE_TOKENIZER  tokens( aLine );
+    char*           text;
 
-    while( text )
-    {
+    while( ( text = tokens.NextToken() ) != NULL )
         m_aliases.push_back( new LIB_ALIAS( FROM_UTF8( text ), this ) );
-        text = strtok( NULL, " \t\r\n" );
-    }
 
     return true;
 }
@@ -35,11 +35,17 @@
 #include <eda_doc.h>
 #include <wxstruct.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 
 #include <general.h>
 #include <class_library.h>
 
+#include <template_fieldnames.h>
+#include <parallel_for.h>
+
+#include <climits>
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
 
 #include <wx/tokenzr.h>
 #include <wx/regex.h>
@@ -609,10 +615,15 @@ bool CMP_LIBRARY::LoadHeader( LINE_READER& aLineReader )
     {
         line = (char*) aLineReader;
 
-        text = strtok( line, " \t\r\n" );
-        data = strtok( NULL, " \t\r\n" );
+        LINE_TOKENIZER tokens( line );
+
+        text = tokens.NextToken();
+        data = tokens.NextToken();
+
+        if( text == NULL )
+            continue;
 
-        if( stricmp( text, "TimeStamp" ) == 0 )
+        if( stricmp( text, "TimeStamp" ) == 0 && data )
             timeStamp = atol( data );
 
         if( stricmp( text, "$ENDHEADER" ) == 0 )
@@ -668,8 +679,9 @@ bool CMP_LIBRARY::LoadDocs( wxString& aErrorMsg )
             return false;
         }
 
-        /* Read one $CMP/$ENDCMP part entry from library: */
-        name = strtok( line + 5, "\n\r" );
+        /* Read one $CMP/$ENDCMP part entry from library, GetLine() removed the
+         * end of line. */
+        name = line + 5;
 
         wxString cmpname = FROM_UTF8( name );
 
@@ -680,7 +692,7 @@ bool CMP_LIBRARY::LoadDocs( wxString& aErrorMsg )
             if( strncmp( line, "$ENDCMP", 7 ) == 0 )
                 break;
 
-            text = strtok( line + 2, "\n\r" );
+            text = line + 2;
 
             if( entry )
             {
@@ -857,6 +869,95 @@ bool CMP_LIBRARY::AddLibrary( const wxFileName& aFileName, wxString& aErrorMsg,
 }
 
 
+/// A library read by a worker thread of CMP_LIBRARY::AddLibraries()
+struct LIBRARY_LOAD_JOB
+{
+    CMP_LIBRARY*    m_Library;
+    wxString        m_ErrorMsg;
+    bool            m_Success;
+};
+
+
+void CMP_LIBRARY::loadLibraryFile( std::vector<LIBRARY_LOAD_JOB>* aJobs, unsigned aJob )
+{
+    LIBRARY_LOAD_JOB&   job = (*aJobs)[aJob];
+    CMP_LIBRARY*        lib = job.m_Library;
+
+    job.m_Success = lib->Load( job.m_ErrorMsg );
+
+    if( job.m_Success && USE_OLD_DOC_FILE_FORMAT( lib->versionMajor, lib->versionMinor ) )
+    {
+        wxString docErrorMsg;   // Like LoadLibrary(), a library without doc is loaded
+
+        lib->LoadDocs( docErrorMsg );
+    }
+}
+
+
+int CMP_LIBRARY::AddLibraries( const std::vector<wxFileName>& aFileNames,
+                               wxArrayString& aErrorMsgs )
+{
+    std::vector<CMP_LIBRARY*>       libs( aFileNames.size(), (CMP_LIBRARY*) NULL );
+    std::vector<LIBRARY_LOAD_JOB>   jobs;
+    std::vector<unsigned>           jobIndex( aFileNames.size(), UINT_MAX );
+
+    aErrorMsgs.Empty();
+    aErrorMsgs.Add( wxEmptyString, aFileNames.size() );
+
+    wxBusyCursor ShowWait;
+
+    for( unsigned ii = 0; ii < aFileNames.size(); ii++ )
+    {
+        const wxFileName&   fn = aFileNames[ii];
+        bool                loaded = FindLibrary( fn.GetName() ) != NULL;
+
+        /* Don't load the library twice. */
+        for( unsigned jj = 0; jj < ii && !loaded; jj++ )
+            loaded = libs[jj] && *libs[jj] == fn.GetName();
+
+        if( loaded )
+            continue;
+
+        libs[ii] = new CMP_LIBRARY( LIBRARY_TYPE_EESCHEMA, fn );
+
+        LIBRARY_LOAD_JOB job;
+        job.m_Library = libs[ii];
+        job.m_Success = false;
+
+        jobIndex[ii] = jobs.size();
+        jobs.push_back( job );
+    }
+
+    if( !jobs.empty() )
+    {
+        // Initializes the static default field names, LIB_COMPONENT needs them.
+        TEMPLATE_FIELDNAME::GetDefaultFieldName( 0 );
+
+        ParallelFor( jobs.size(), boost::bind( loadLibraryFile, &jobs, _1 ) );
+    }
+
+    int failures = 0;
+
+    for( unsigned ii = 0; ii < libs.size(); ii++ )
+    {
+        if( libs[ii] == NULL )
+            continue;
+
+        if( !jobs[ jobIndex[ii] ].m_Success )
+        {
+            aErrorMsgs[ii] = jobs[ jobIndex[ii] ].m_ErrorMsg;
+            delete libs[ii];
+            failures++;
+            continue;
+        }
+
+        libraryList.push_back( libs[ii] );
+    }
+
+    return failures;
+}
+
+
 void CMP_LIBRARY::RemoveLibrary( const wxString& aName )
 {
     if( aName.IsEmpty() )
@@ -75,6 +75,7 @@ class OUTPUTFORMATTER;
 /* Helpers for creating a list of component libraries. */
 class CMP_LIBRARY;
 class wxRegEx;
+struct LIBRARY_LOAD_JOB;
 
 
 typedef boost::ptr_vector< CMP_LIBRARY > CMP_LIBRARY_LIST;
@@ -147,6 +148,9 @@ private:
     bool LoadHeader( LINE_READER& aLineReader );
     void LoadAliases( LIB_COMPONENT* aComponent );
 
+    ///> Worker thread job of AddLibraries(), reads the library aJob of aJobs
+    static void loadLibraryFile( std::vector<LIBRARY_LOAD_JOB>* aJobs, unsigned aJob );
+
 public:
     /**
      * Get library entry status.
@@ -441,6 +445,20 @@ public:
     static bool AddLibrary( const wxFileName& aFileName, wxString& aErrorMsg,
                             CMP_LIBRARY_LIST::iterator& aIterator );
 
+    /**
+     * Function AddLibraries
+     * appends the component libraries which are not loaded yet to the library list, in
+     * the order of \a aFileNames.  The files are read by worker threads.  Each of them is
+     * parsed, even if it did not change since the last time it was loaded: nothing is
+     * cached between loads.
+     *
+     * @param aFileNames - File name objects of the component libraries.
+     * @param aErrorMsgs - Receives one message per file, empty if the library is loaded.
+     * @return The number of libraries which failed to load.
+     */
+    static int AddLibraries( const std::vector<wxFileName>& aFileNames,
+                             wxArrayString& aErrorMsgs );
+
     /**
      * Function RemoveLibrary
      * removes a component library from the library list.
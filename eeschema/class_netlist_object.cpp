@@ -37,6 +37,8 @@
 
 #include <wx/regex.h>
 
+#include <ki_mutex.h>
+
 
 /**
  * The regular expression string for label bus notation.  Valid bus labels are defined as
@@ -45,12 +47,17 @@
  */
 static wxRegEx busLabelRe( wxT( "^([^[:space:]]+)(\\[[\\d]+\\.+[\\d]+\\])$" ), wxRE_ADVANCED );
 
+// wxRegEx keeps the last match, net list items are built by several threads
+static MUTEX busLabelReLock;
+
 
 bool IsBusLabel( const wxString& aLabel )
 {
     wxCHECK_MSG( busLabelRe.IsValid(), false,
                  wxT( "Invalid regular expression in IsBusLabel()." ) );
 
+    MUTLOCK lock( busLabelReLock );
+
     return busLabelRe.Matches( aLabel );
 }
 
@@ -252,8 +259,15 @@ void NETLIST_OBJECT::ConvertBusToNetListItems( NETLIST_OBJECT_LIST& aNetListItem
     wxString tmp, busName, busNumber;
     long begin, end, member;
 
-    busName = busLabelRe.GetMatch( m_Label, 1 );
-    busNumber = busLabelRe.GetMatch( m_Label, 2 );
+    {
+        MUTLOCK lock( busLabelReLock );
+
+        if( !busLabelRe.Matches( m_Label ) )
+            return;
+
+        busName = busLabelRe.GetMatch( m_Label, 1 );
+        busNumber = busLabelRe.GetMatch( m_Label, 2 );
+    }
 
     /* Search for  '[' because a bus label is like "busname[nn..mm]" */
     i = busNumber.Find( '[' );
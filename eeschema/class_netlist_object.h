@@ -32,11 +32,16 @@
 #define _CLASS_NETLIST_OBJECT_H_
 
 
+#include <algorithm>
+#include <vector>
+
 #include <sch_sheet_path.h>
 #include <lib_pin.h>      // LIB_PIN::ReturnPinStringNum( m_PinNum )
 
 class NETLIST_OBJECT_LIST;
 class SCH_COMPONENT;
+class SHEET_CONNECTION_INDEX;
+class LABEL_NAME_INDEX;
 
 
 /* Type of Net objects (wires, labels, pins...) */
@@ -252,6 +257,61 @@ public:
 
 
 
+/**
+ * Class NET_CODE_MERGER
+ * keeps track of net codes merged while building the connectivity (a union-find over
+ * net codes), so merging two nets does not require to rewrite the code of all their items.
+ * Items keep the code they were given, their actual net code is Find( code ).
+ */
+class NET_CODE_MERGER
+{
+public:
+    void Clear() { m_parent.clear(); }
+
+    /**
+     * Function Find
+     * @return the code of the net \a aCode has been merged into (0 for 0).
+     */
+    int Find( int aCode )
+    {
+        if( aCode <= 0 || aCode >= (int) m_parent.size() )
+            return aCode;
+
+        while( m_parent[aCode] != aCode )
+        {
+            m_parent[aCode] = m_parent[m_parent[aCode]];
+            aCode = m_parent[aCode];
+        }
+
+        return aCode;
+    }
+
+    /**
+     * Function Merge
+     * merges the net \a aOldCode into \a aNewCode: items of both nets then have the
+     * code \a aNewCode.
+     */
+    void Merge( int aOldCode, int aNewCode )
+    {
+        aOldCode = Find( aOldCode );
+        aNewCode = Find( aNewCode );
+
+        if( aOldCode == aNewCode || aOldCode <= 0 )
+            return;
+
+        int size = std::max( aOldCode, aNewCode ) + 1;
+
+        for( int code = m_parent.size(); code < size; ++code )
+            m_parent.push_back( code );
+
+        m_parent[aOldCode] = aNewCode;
+    }
+
+private:
+    std::vector<int> m_parent;      ///< Merged codes point to the code they were merged into
+};
+
+
 /**
  * NETLIST_OBJECT_LIST is a class to handle the list of connected items
  * in a full shematic hierarchy for netlist and erc calculations
@@ -263,6 +323,10 @@ class NETLIST_OBJECT_LIST: public std::vector <NETLIST_OBJECT*>
     int m_lastNetCode;  // Used in intermediate calculation: last net code created
     int m_lastBusNetCode;  // Used in intermediate calculation:
                            // last net code created for bus members
+    NET_CODE_MERGER m_netCodes;     // Used in intermediate calculation: merged net codes
+    NET_CODE_MERGER m_busNetCodes;  // Used in intermediate calculation: merged bus net codes
+    bool m_connectionsValid;        // Used in intermediate calculation: false if an item of
+                                    // unspecified type was found by buildSheetConnections()
 
 public:
     /**
@@ -273,7 +337,12 @@ public:
      * @param aIsOwner true if the instance is the owner of item list
      * (default = false)
      */
-    NETLIST_OBJECT_LIST( bool aIsOwner = false ) { m_isOwner = aIsOwner; }
+    NETLIST_OBJECT_LIST( bool aIsOwner = false )
+    {
+        m_isOwner = aIsOwner;
+        m_lastNetCode = m_lastBusNetCode = 1;
+        m_connectionsValid = true;
+    }
     ~NETLIST_OBJECT_LIST();
 
     void SetOwner( bool aIsOwner ) { m_isOwner = aIsOwner; }
@@ -380,12 +449,20 @@ private:
      */
     void propageNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus );
 
+    /*
+     * Net code and bus net code of an item while the connectivity is built,
+     * i.e. taking in account nets merged by propageNetCode()
+     */
+    int getNet( const NETLIST_OBJECT* aItem ) { return m_netCodes.Find( aItem->GetNet() ); }
+    int getBusNet( const NETLIST_OBJECT* aItem ) { return m_busNetCodes.Find( aItem->m_BusNetCode ); }
+
     /*
      * This function merges the net codes of groups of objects already connected
      * to labels (wires, bus, pins ... ) when 2 labels are equivalents
      * (i.e. group objects connected by labels)
+     * aLabels holds all labels of the list, by name
      */
-    void labelConnect( NETLIST_OBJECT* aLabelRef );
+    void labelConnect( NETLIST_OBJECT* aLabelRef, LABEL_NAME_INDEX& aLabels );
 
     /* Comparison function to sort by increasing Netcode the list of connected items
      */
@@ -404,19 +481,37 @@ private:
     /*
      * Propagate net codes from a parent sheet to an include sheet,
      * from a pin sheet connection
+     * aLabels holds all labels of the list, by name
+     */
+    void sheetLabelConnect( NETLIST_OBJECT* aSheetLabel, LABEL_NAME_INDEX& aLabels );
+
+    /*
+     * Build the connections between items of a list holding the items of a single
+     * sheet (sorted like the full list), using wires, buses and junctions.
+     * Net codes and bus net codes are numbered from 1.
      */
-    void sheetLabelConnect( NETLIST_OBJECT* aSheetLabel );
+    void buildSheetConnections();
 
-    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, int start );
+    /*
+     * Worker thread job calling buildSheetConnections() for the sheet aSheet of aSheets
+     */
+    static void buildSheetConnectionsJob( std::vector<NETLIST_OBJECT_LIST>* aSheets,
+                                          unsigned aSheet );
+
+    /*
+     * Search items of the sheet of aRef having an end point in common with aRef
+     * and propagate the aRef net code (or bus net code if aIsBus) to them
+     */
+    void pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus, SHEET_CONNECTION_INDEX& aIndex );
 
     /*
      * Search connections betweena junction and segments
      * Propagate the junction net code to objects connected by this junction.
      * The junction must have a valid net code
-     * The list of objects is expected sorted by sheets.
-     * Search is done from index aIdxStart to the last element of list
+     * aIndex holds the items of the junction sheet
      */
-    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus, int aIdxStart );
+    void segmentToPointConnect( NETLIST_OBJECT* aJonction, bool aIsBus,
+                                SHEET_CONNECTION_INDEX& aIndex );
 
     void connectBusLabels();
 
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <boost/foreach.hpp>
+#include <iterator>
 #include <set>
 
 #include <wx/string.h>
@@ -60,7 +61,8 @@ struct COMPONENT_TREE_SEARCH_CONTAINER::TREE_NODE
           DisplayInfo( aDisplayInfo ),
           MatchName( aName.Lower() ),
           SearchText( aSearchText.Lower() ),
-          MatchScore( 0 ), PreviousScore( 0 )
+          MatchScore( 0 ), PreviousScore( 0 ),
+          AliasIndex( 0 ), AliasCount( 0 )
     {
     }
 
@@ -77,9 +79,22 @@ struct COMPONENT_TREE_SEARCH_CONTAINER::TREE_NODE
     unsigned MatchScore;          ///< Result-Score after UpdateSearchTerm()
     unsigned PreviousScore;       ///< Optimization: used to see if we need any tree update.
     wxTreeItemId TreeId;          ///< Tree-ID if stored in the tree (if MatchScore > 0).
+
+    unsigned AliasIndex;          ///< Alias: position in the alias list. Library: first alias.
+    unsigned AliasCount;          ///< Library: number of aliases it contains.
 };
 
 
+// Packs three characters into a key of the trigram index. Unicode code points fit in 21 bits.
+static inline uint64_t trigramKey( wxChar c0, wxChar c1, wxChar c2 )
+{
+    const uint64_t mask = 0x1FFFFF;
+
+    return ( ( uint64_t( c0 ) & mask ) << 42 ) | ( ( uint64_t( c1 ) & mask ) << 21 )
+           | ( uint64_t( c2 ) & mask );
+}
+
+
 // Sort tree nodes by reverse match-score (bigger is first), then alphabetically.
 // Library (i.e. the ones that don't have a parent) are always sorted before any
 // leaf nodes. Component
@@ -99,7 +114,8 @@ bool COMPONENT_TREE_SEARCH_CONTAINER::scoreComparator( const TREE_NODE* a1, cons
 
 
 COMPONENT_TREE_SEARCH_CONTAINER::COMPONENT_TREE_SEARCH_CONTAINER()
-    : tree( NULL ), libraries_added( 0 ), preselect_unit_number( -1 )
+    : tree( NULL ), libraries_added( 0 ), last_search_valid( false ),
+      preselect_unit_number( -1 )
 {
 }
 
@@ -146,6 +162,11 @@ void COMPONENT_TREE_SEARCH_CONTAINER::AddAliasList( const wxString& aNodeName,
     TREE_NODE* const lib_node = new TREE_NODE( TREE_NODE::TYPE_LIB,  NULL, NULL,
                                                aNodeName, wxEmptyString, wxEmptyString );
     nodes.push_back( lib_node );
+    libraries.push_back( lib_node );
+    lib_node->AliasIndex = aliases.size();
+
+    // The previous search result does not know about the new aliases.
+    last_search_valid = false;
 
     BOOST_FOREACH( const wxString& aName, aAliasNameList )
     {
@@ -177,6 +198,11 @@ void COMPONENT_TREE_SEARCH_CONTAINER::AddAliasList( const wxString& aNodeName,
                                                a, a->GetName(), display_info, search_text );
         nodes.push_back( alias_node );
 
+        alias_node->AliasIndex = aliases.size();
+        aliases.push_back( alias_node );
+        indexText( alias_node->AliasIndex, alias_node->MatchName );
+        indexText( alias_node->AliasIndex, alias_node->SearchText );
+
         if( a->GetComponent()->IsMulti() )    // Add all units as sub-nodes.
             for ( int u = 0; u < a->GetComponent()->GetPartCount(); ++u )
             {
@@ -188,6 +214,112 @@ void COMPONENT_TREE_SEARCH_CONTAINER::AddAliasList( const wxString& aNodeName,
                 nodes.push_back( unit_node );
             }
     }
+
+    lib_node->AliasCount = aliases.size() - lib_node->AliasIndex;
+}
+
+
+void COMPONENT_TREE_SEARCH_CONTAINER::indexText( unsigned aAliasIndex, const wxString& aText )
+{
+    for( size_t i = 2; i < aText.length(); ++i )
+    {
+        std::vector<unsigned>& postings = trigrams[ trigramKey( aText[i - 2], aText[i - 1],
+                                                                aText[i] ) ];
+
+        // Aliases are indexed in order, so each posting list stays sorted and unique.
+        if( postings.empty() || postings.back() != aAliasIndex )
+            postings.push_back( aAliasIndex );
+    }
+}
+
+
+void COMPONENT_TREE_SEARCH_CONTAINER::getCandidates( const wxString& aTerm,
+                                                     std::vector<unsigned>& aResult ) const
+{
+    aResult.clear();
+
+    // Aliases containing all the trigrams of the term in their name or search text.
+    std::vector<const std::vector<unsigned>*> lists;
+
+    for( size_t i = 2; i < aTerm.length(); ++i )
+    {
+        TRIGRAM_INDEX::const_iterator it = trigrams.find( trigramKey( aTerm[i - 2],
+                                                                      aTerm[i - 1],
+                                                                      aTerm[i] ) );
+        if( it == trigrams.end() )
+        {
+            lists.clear();
+            break;
+        }
+
+        lists.push_back( &it->second );
+    }
+
+    if( !lists.empty() )
+    {
+        // Start with the shortest list, the intersection can only shrink.
+        const std::vector<unsigned>* shortest = lists[0];
+
+        for( unsigned i = 1; i < lists.size(); ++i )
+        {
+            if( lists[i]->size() < shortest->size() )
+                shortest = lists[i];
+        }
+
+        aResult = *shortest;
+
+        std::vector<unsigned> intersection;
+
+        for( unsigned i = 0; i < lists.size() && !aResult.empty(); ++i )
+        {
+            if( lists[i] == shortest )
+                continue;
+
+            intersection.clear();
+            std::set_intersection( aResult.begin(), aResult.end(),
+                                   lists[i]->begin(), lists[i]->end(),
+                                   std::back_inserter( intersection ) );
+            aResult.swap( intersection );
+        }
+    }
+
+    // All the aliases of a library whose name contains the term. There are only a few
+    // libraries, so they are just scanned.
+    bool merge = false;
+
+    BOOST_FOREACH( const TREE_NODE* lib, libraries )
+    {
+        if( lib->AliasCount == 0 || lib->MatchName.Find( aTerm ) == wxNOT_FOUND )
+            continue;
+
+        for( unsigned i = 0; i < lib->AliasCount; ++i )
+            aResult.push_back( lib->AliasIndex + i );
+
+        merge = true;
+    }
+
+    if( merge )
+    {
+        std::sort( aResult.begin(), aResult.end() );
+        aResult.erase( std::unique( aResult.begin(), aResult.end() ), aResult.end() );
+    }
+}
+
+
+bool COMPONENT_TREE_SEARCH_CONTAINER::isRefinement( const std::vector<wxString>& aTerms ) const
+{
+    if( !last_search_valid || aTerms.size() < last_terms.size() )
+        return false;
+
+    // A string containing the new term also contains the previous one, and additional
+    // terms can only drop more aliases (AND semantics).
+    for( unsigned i = 0; i < last_terms.size(); ++i )
+    {
+        if( aTerms[i].Find( last_terms[i] ) == wxNOT_FOUND )
+            return false;
+    }
+
+    return true;
 }
 
 
@@ -221,22 +353,66 @@ static int matchPosScore(int aPosition, int aMaximum)
 }
 
 
+int COMPONENT_TREE_SEARCH_CONTAINER::termScore( const TREE_NODE* aNode, const wxString& aTerm )
+{
+    // Keywords and description we only count if the match string is at
+    // least two characters long. That avoids spurious, low quality
+    // matches. Most abbreviations are at three characters long.
+    int found_pos;
+
+    if( aTerm == aNode->MatchName )
+        return 1000;  // exact match. High score :)
+    else if( (found_pos = aNode->MatchName.Find( aTerm ) ) != wxNOT_FOUND )
+    {
+        // Substring match. The earlier in the string the better.  score += 20..40
+        return matchPosScore( found_pos, 20 ) + 20;
+    }
+    else if( aNode->Parent->MatchName.Find( aTerm ) != wxNOT_FOUND )
+        return 19;   // parent name matches.         score += 19
+    else if( ( found_pos = aNode->SearchText.Find( aTerm ) ) != wxNOT_FOUND )
+    {
+        // If we have a very short search term (like one or two letters), we don't want
+        // to accumulate scores if they just happen to be in keywords or description as
+        // almost any one or two-letter combination shows up in there.
+        // For longer terms, we add scores 1..18 for positional match (higher in the
+        // front, where the keywords are).                        score += 0..18
+        return ( aTerm.length() >= 2 ) ? matchPosScore( found_pos, 17 ) + 1 : 0;
+    }
+
+    return -1;    // No match. That's it for this item.
+}
+
+
 void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch )
 {
     if( tree == NULL )
         return;
 
-    // We score the list by going through it several time, essentially with a complexity
-    // of O(n). For the default library of 2000+ items, this typically takes less than 5ms
-    // on an i5. Good enough, no index needed.
+    // Only the aliases that may still match are scored: terms of three or more characters
+    // are looked up in the trigram index built by AddAliasList(), and when the search only
+    // got more specific (typing more letters), the previous result is the starting point.
+    // Only the full scan of the first keystroke is O(n).
+    std::vector<wxString> terms;
+    wxStringTokenizer tokenizer( aSearch );
 
-    // Initial AND condition: Leaf nodes are considered to match initially.
-    BOOST_FOREACH( TREE_NODE* node, nodes )
+    while ( tokenizer.HasMoreTokens() )
+        terms.push_back( tokenizer.GetNextToken().Lower() );
+
+    std::vector<unsigned> matches;
+
+    if( isRefinement( terms ) )
+        matches = last_matches;
+    else
     {
-        node->PreviousScore = node->MatchScore;
-        node->MatchScore = ( node->Type == TREE_NODE::TYPE_LIB ) ? 0 : kLowestDefaultScore;
+        matches.resize( aliases.size() );
+
+        for( unsigned i = 0; i < aliases.size(); ++i )
+            matches[i] = i;
     }
 
+    // Initial AND condition: Leaf nodes are considered to match initially.
+    std::vector<unsigned> scores( matches.size(), kLowestDefaultScore );
+
     // Create match scores for each node for all the terms, that come space-separated.
     // Scoring adds up values for each term according to importance of the match. If a term does
     // not match at all, the result is thrown out of the results (AND semantics).
@@ -248,50 +424,57 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
     //     first so contribute more to the score.
     //
     // This is of course subject to tweaking.
-    wxStringTokenizer tokenizer( aSearch );
+    std::vector<unsigned> candidates;
 
-    while ( tokenizer.HasMoreTokens() )
+    BOOST_FOREACH( const wxString& term, terms )
     {
-        const wxString term = tokenizer.GetNextToken().Lower();
+        bool indexed = term.length() >= 3;
 
-        BOOST_FOREACH( TREE_NODE* node, nodes )
-        {
-            if( node->Type != TREE_NODE::TYPE_ALIAS )
-                continue;      // Only aliases are actually scored here.
-
-            if( node->MatchScore == 0)
-                continue;   // Leaf node without score are out of the game.
+        if( indexed )
+            getCandidates( term, candidates );
 
-            // Keywords and description we only count if the match string is at
-            // least two characters long. That avoids spurious, low quality
-            // matches. Most abbreviations are at three characters long.
-            int found_pos;
+        std::vector<unsigned>::const_iterator candidate = candidates.begin();
+        unsigned kept = 0;
 
-            if( term == node->MatchName )
-                node->MatchScore += 1000;  // exact match. High score :)
-            else if( (found_pos = node->MatchName.Find( term ) ) != wxNOT_FOUND )
-            {
-                // Substring match. The earlier in the string the better.  score += 20..40
-                node->MatchScore += matchPosScore( found_pos, 20 ) + 20;
-            }
-            else if( node->Parent->MatchName.Find( term ) != wxNOT_FOUND )
-                node->MatchScore += 19;   // parent name matches.         score += 19
-            else if( ( found_pos = node->SearchText.Find( term ) ) != wxNOT_FOUND )
+        for( unsigned i = 0; i < matches.size(); ++i )
+        {
+            if( indexed )
             {
-                // If we have a very short search term (like one or two letters), we don't want
-                // to accumulate scores if they just happen to be in keywords or description as
-                // almost any one or two-letter combination shows up in there.
-                // For longer terms, we add scores 1..18 for positional match (higher in the
-                // front, where the keywords are).                        score += 0..18
-                node->MatchScore += ( ( term.length() >= 2 )
-                                       ? matchPosScore( found_pos, 17 ) + 1
-                                       : 0 );
+                // Both lists are sorted: skip the aliases the index rules out.
+                while( candidate != candidates.end() && *candidate < matches[i] )
+                    ++candidate;
+
+                if( candidate == candidates.end() || *candidate != matches[i] )
+                    continue;
             }
-            else
-                node->MatchScore = 0;    // No match. That's it for this item.
+
+            int score = termScore( aliases[matches[i]], term );
+
+            if( score < 0 )
+                continue;
+
+            matches[kept] = matches[i];
+            scores[kept]  = scores[i] + score;
+            ++kept;
         }
+
+        matches.resize( kept );
+        scores.resize( kept );
     }
 
+    last_terms = terms;
+    last_matches = matches;
+    last_search_valid = true;
+
+    BOOST_FOREACH( TREE_NODE* node, nodes )
+    {
+        node->PreviousScore = node->MatchScore;
+        node->MatchScore = 0;
+    }
+
+    for( unsigned i = 0; i < matches.size(); ++i )
+        aliases[matches[i]]->MatchScore = scores[i];
+
     // Library nodes have the maximum score seen in any of their children.
     // Alias nodes have the score of their parents.
     unsigned highest_score_seen = 0;
@@ -323,8 +506,16 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
     if( !any_change )
         return;
 
-    // Now: sort all items according to match score, libraries first.
-    std::sort( nodes.begin(), nodes.end(), scoreComparator );
+    // Now: sort the items to display according to match score, libraries first.
+    std::vector<TREE_NODE*> results;
+
+    BOOST_FOREACH( TREE_NODE* node, nodes )
+    {
+        if( node->MatchScore > 0 )
+            results.push_back( node );
+    }
+
+    std::sort( results.begin(), results.end(), scoreComparator );
 
     // Fill the tree with all items that have a match. Re-arranging, adding and removing changed
     // items is pretty complex, so we just re-build the whole tree.
@@ -334,11 +525,8 @@ void COMPONENT_TREE_SEARCH_CONTAINER::UpdateSearchTerm( const wxString& aSearch
     const TREE_NODE* first_match = NULL;
     const TREE_NODE* preselected_node = NULL;
 
-    BOOST_FOREACH( TREE_NODE* node, nodes )
+    BOOST_FOREACH( TREE_NODE* node, results )
     {
-        if( node->MatchScore == 0 )
-            continue;
-
         // If we have nodes that go beyond the default score, suppress nodes that
         // have the default score. That can happen if they have an honary += 0 score due to
         // some one-letter match in the keyword or description. In this case, we prefer matches
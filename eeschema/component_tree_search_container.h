@@ -25,6 +25,8 @@
 #define COMPONENT_TREE_SEARCH_CONTAINER_H
 
 #include <vector>
+#include <stdint.h>
+#include <boost/unordered_map.hpp>
 #include <wx/string.h>
 
 class LIB_ALIAS;
@@ -105,10 +107,33 @@ private:
     struct TREE_NODE;
     static bool scoreComparator( const TREE_NODE* a1, const TREE_NODE* a2 );
 
+    // Score added by aTerm to an alias node, or -1 if the term does not match at all.
+    static int termScore( const TREE_NODE* aNode, const wxString& aTerm );
+
+    // Add the trigrams of aText to the posting lists of alias number aAliasIndex.
+    void indexText( unsigned aAliasIndex, const wxString& aText );
+
+    // Fill aResult with the sorted indices of the aliases that might match aTerm (at least
+    // three characters long): a superset of the aliases termScore() accepts.
+    void getCandidates( const wxString& aTerm, std::vector<unsigned>& aResult ) const;
+
+    // Returns true if every alias matching aTerms also matched the previous search.
+    bool isRefinement( const std::vector<wxString>& aTerms ) const;
+
+    typedef boost::unordered_map< uint64_t, std::vector<unsigned> > TRIGRAM_INDEX;
+
     std::vector<TREE_NODE*> nodes;
+    std::vector<TREE_NODE*> libraries;  // Library nodes in the order they were added.
+    std::vector<TREE_NODE*> aliases;    // Alias nodes, indexed by the trigram posting lists.
+    TRIGRAM_INDEX trigrams;             // Trigram -> sorted indices of aliases containing it.
     wxTreeCtrl* tree;
     int libraries_added;
 
+    // Result of the previous search, the start point of a search that only got more specific.
+    bool last_search_valid;
+    std::vector<wxString> last_terms;
+    std::vector<unsigned> last_matches;
+
     wxString preselect_node_name;
     int preselect_unit_number;
 };
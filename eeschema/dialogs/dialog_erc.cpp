@@ -466,66 +466,8 @@ void DIALOG_ERC::TestErc( wxArrayString* aMessagesList )
     // Reset the connection type indicator
     objectsConnectedList->ResetConnectionsType();
 
-    unsigned lastNet;
-    unsigned nextNet = lastNet = 0;
-    int NetNbItems = 0;
-    int MinConn    = NOC;
-
-    for( unsigned net = 0; net < objectsConnectedList->size(); net++ )
-    {
-        if( objectsConnectedList->GetItemNet( lastNet ) !=
-            objectsConnectedList->GetItemNet( net ) )
-        {
-            // New net found:
-            MinConn    = NOC;
-            NetNbItems = 0;
-            nextNet   = net;
-        }
-
-        switch( objectsConnectedList->GetItemType( net ) )
-        {
-        // These items do not create erc problems
-        case NET_ITEM_UNSPECIFIED:
-        case NET_SEGMENT:
-        case NET_BUS:
-        case NET_JUNCTION:
-        case NET_LABEL:
-        case NET_BUSLABELMEMBER:
-        case NET_PINLABEL:
-        case NET_GLOBLABEL:
-        case NET_GLOBBUSLABELMEMBER:
-            break;
-
-        case NET_HIERLABEL:
-        case NET_HIERBUSLABELMEMBER:
-        case NET_SHEETLABEL:
-        case NET_SHEETBUSLABELMEMBER:
-
-            // ERC problems when pin sheets do not match hierarchical labels.
-            // Each pin sheet must match a hierarchical label
-            // Each hierarchical label must match a pin sheet
-            TestLabel( objectsConnectedList, net, nextNet );
-            break;
-
-        case NET_NOCONNECT:
-
-            // ERC problems when a noconnect symbol is connected to more than one pin.
-            MinConn = NET_NC;
-
-            if( NetNbItems != 0 )
-                Diagnose( objectsConnectedList->GetItem( net ), NULL, MinConn, UNC );
-
-            break;
-
-        case NET_PIN:
-
-            // Look for ERC problems between pins:
-            TestOthersItems( objectsConnectedList, net, nextNet, &NetNbItems, &MinConn );
-            break;
-        }
-
-        lastNet = net;
-    }
+    // Look for ERC problems in each net
+    TestNetConnections( objectsConnectedList );
 
     // Displays global results:
     wxString num;
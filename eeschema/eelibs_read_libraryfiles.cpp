@@ -20,9 +20,11 @@ void SCH_EDIT_FRAME::LoadLibraries( void )
 {
     size_t         ii;
     wxFileName     fn;
-    wxString       msg, tmp, errMsg;
+    wxString       msg, tmp;
     wxString       libraries_not_found;
     wxArrayString  sortOrder;
+    std::vector<wxFileName> libFiles;
+    wxArrayString  errMsgs;
 
     CMP_LIBRARY_LIST::iterator i = CMP_LIBRARY::GetLibraryList().begin();
 
@@ -67,23 +69,32 @@ void SCH_EDIT_FRAME::LoadLibraries( void )
             tmp = fn.GetFullPath();
         }
 
-        // Loaded library statusbar message
         fn = tmp;
+        libFiles.push_back( fn );
+    }
+
+    /* The libraries are read concurrently, then reported in the list order. */
+    CMP_LIBRARY::AddLibraries( libFiles, errMsgs );
+
+    for( ii = 0; ii < libFiles.size(); ii++ )
+    {
+        const wxFileName& libFile = libFiles[ii];
 
-        if( CMP_LIBRARY::AddLibrary( fn, errMsg ) )
+        // Loaded library statusbar message
+        if( errMsgs[ii].IsEmpty() )
         {
-            msg.Printf( _( "Library <%s> loaded" ), GetChars( tmp ) );
-            sortOrder.Add( fn.GetName() );
+            msg.Printf( _( "Library <%s> loaded" ), GetChars( libFile.GetFullPath() ) );
+            sortOrder.Add( libFile.GetName() );
         }
         else
         {
             wxString prompt;
 
             prompt.Printf( _( "Component library <%s> failed to load.\nError: %s" ),
-                           GetChars( fn.GetFullPath() ),
-                           GetChars( errMsg ) );
+                           GetChars( libFile.GetFullPath() ),
+                           GetChars( errMsgs[ii] ) );
             DisplayError( this, prompt );
-            msg.Printf( _( "Library <%s> error!" ), GetChars( tmp ) );
+            msg.Printf( _( "Library <%s> error!" ), GetChars( libFile.GetFullPath() ) );
         }
 
         PrintMsg( msg );
@@ -103,6 +114,12 @@ void SCH_EDIT_FRAME::LoadLibraries( void )
     CMP_LIBRARY::SetSortOrder( sortOrder );
     CMP_LIBRARY::GetLibraryList().sort();
 
+    /* Components may have other pins and bodies in the new libraries. */
+    SCH_SCREENS screens;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+        screen->InvalidateIndex();
+
 #if 0   // #ifdef __WXDEBUG__
     wxLogDebug( wxT( "LoadLibraries() requested component library sort order:" ) );
 
@@ -40,6 +40,10 @@
 #include <sch_marker.h>
 #include <sch_component.h>
 #include <sch_sheet.h>
+#include <parallel_for.h>
+
+#include <boost/unordered/unordered_map.hpp>
+#include <boost/bind.hpp>
 
 
 /* ERC tests :
@@ -346,139 +350,310 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst,
 }
 
 
-void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                      unsigned aNetItemRef, unsigned aNetStart,
-                      int* aNetNbItems, int* aMinConnexion )
+/**
+ * Struct ERC_DIAG
+ * is a problem found in a net, reported by Diagnose() once all the nets are tested, so
+ * the markers are created in the same order whatever the thread which tested the net.
+ */
+struct ERC_DIAG
 {
-    unsigned netItemTst = aNetStart;
-    int jj;
-    int erc = OK;
+    unsigned    m_Ref;                  ///< Index of the item the problem is about
+    int         m_Tst;                  ///< Index of the conflicting pin, or -1
+    int         m_MinConn;
+    int         m_Diag;
+    bool        m_CheckDuplicates;      ///< The pin is not connected: no problem if an other
+                                        ///< instance of this pin (other unit) is connected
+};
 
-    /* Analysis of the table of connections. */
-    int ref_elect_type = aList->GetItem( aNetItemRef )->m_ElectricalType;
-    int local_minconn = NOC;
 
-    if( ref_elect_type == PIN_NC )
-        local_minconn = NPI;
+/**
+ * Struct ERC_NET_JOB
+ * is a net of the net list to test, and the problems found in it.
+ */
+struct ERC_NET_JOB
+{
+    unsigned                m_Start;    ///< Index of the first item of the net
+    unsigned                m_End;      ///< Index after the last item of the net
+    std::vector<ERC_DIAG>   m_Diags;
 
-    /* Test pins connected to NetItemRef */
-    for( ; ; netItemTst++ )
+    void AddDiag( unsigned aRef, int aTst, int aMinConn, int aDiag,
+                  bool aCheckDuplicates = false )
     {
-        if( aNetItemRef == netItemTst )
-            continue;
+        ERC_DIAG diag;
+
+        diag.m_Ref = aRef;
+        diag.m_Tst = aTst;
+        diag.m_MinConn = aMinConn;
+        diag.m_Diag = aDiag;
+        diag.m_CheckDuplicates = aCheckDuplicates;
+        m_Diags.push_back( diag );
+    }
+};
+
+
+/**
+ * Function isLabelOrphaned
+ * tells if the sheet label or hierarchical label \a aLabel is not connected to a
+ * hierarchical label or a sheet label of \a aNetLabels (the labels of its net).
+ */
+static bool isLabelOrphaned( NETLIST_OBJECT_LIST* aList, unsigned aLabel,
+                             const std::vector<unsigned>& aNetLabels )
+{
+    NETLIST_OBJECT* label = aList->GetItem( aLabel );
+
+    for( unsigned ii = 0; ii < aNetLabels.size(); ii++ )
+    {
+        NETLIST_OBJECT* other = aList->GetItem( aNetLabels[ii] );
+
+        if( label->IsLabelConnected( other ) || other->IsLabelConnected( label ) )
+            return false;
+    }
 
-        // We examine only a given net. We stop the search if the net changes
-        if( ( netItemTst >= aList->size() ) // End of list
-            || ( aList->GetItemNet( aNetItemRef ) !=
-                 aList->GetItemNet( netItemTst ) ) ) // End of net
+    return true;
+}
+
+
+/**
+ * Function testNet
+ * tests the pins, no connect symbols and hierarchical labels of a net.
+ * <p>
+ * Pins are tested against the count of pins of each electrical type of the net, and against
+ * the first following pin of each type, instead of against each other pin of the net.
+ * </p>
+ */
+static void testNet( NETLIST_OBJECT_LIST* aList, ERC_NET_JOB& aNet )
+{
+    std::vector<unsigned> pinsOfType[PIN_NMAX];     // Pins of the net by electrical type
+    std::vector<unsigned> labels;                   // Sheet and hierarchical labels
+    bool                  hasNoConnect = false;
+    unsigned              pinCount = 0;
+
+    for( unsigned ii = aNet.m_Start; ii < aNet.m_End; ii++ )
+    {
+        switch( aList->GetItemType( ii ) )
         {
-            /* End net code found: minimum connection test. */
-            if( ( *aMinConnexion < NET_NC ) && ( local_minconn < NET_NC ) )
-            {
-                /* Not connected or not driven pin. */
-                bool seterr = true;
+        case NET_PIN:
+            pinsOfType[ aList->GetItem( ii )->m_ElectricalType ].push_back( ii );
+            pinCount++;
+            break;
 
-                if( local_minconn == NOC &&
-                    aList->GetItemType( aNetItemRef ) == NET_PIN )
-                {
-                    /* This pin is not connected: for multiple part per
-                     * package, and duplicated pin,
-                     * search for an other instance of this pin
-                     * this will be flagged only if all instances of this pin
-                     * are not connected
-                     * TODO test also if instances connected are connected to
-                     * the same net
-                     */
-                    for( unsigned duplicate = 0; duplicate < aList->size(); duplicate++ )
-                    {
-                        if( aList->GetItemType( duplicate ) != NET_PIN )
-                            continue;
-
-                        if( duplicate == aNetItemRef )
-                            continue;
-
-                        if( aList->GetItem( aNetItemRef )->m_PinNum !=
-                            aList->GetItem( duplicate )->m_PinNum )
-                            continue;
-
-                        if( ( (SCH_COMPONENT*) aList->GetItem( aNetItemRef )->
-                             m_Link )->GetRef( &aList->GetItem( aNetItemRef )-> m_SheetPath ) !=
-                            ( (SCH_COMPONENT*) aList->GetItem( duplicate )->m_Link )
-                           ->GetRef( &aList->GetItem( duplicate )->m_SheetPath ) )
-                            continue;
-
-                        // Same component and same pin. Do dot create error for this pin
-                        // if the other pin is connected (i.e. if duplicate net has an other
-                        // item)
-                        if( (duplicate > 0)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate - 1 ) ) )
-                            seterr = false;
-
-                        if( (duplicate < aList->size() - 1)
-                          && ( aList->GetItemNet( duplicate ) ==
-                               aList->GetItemNet( duplicate + 1 ) ) )
-                            seterr = false;
-                    }
-                }
+        case NET_NOCONNECT:
+            hasNoConnect = true;
+            break;
 
-                if( seterr )
-                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR );
+        case NET_HIERLABEL:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_SHEETLABEL:
+        case NET_SHEETBUSLABELMEMBER:
+            labels.push_back( ii );
+            break;
 
-                *aMinConnexion = DRV;   // inhibiting other messages of this
-                                       // type for the net.
-            }
-            return;
+        default:
+            break;
         }
+    }
+
+    unsigned nextPin[PIN_NMAX] = { 0 };     // First pin of each type after the current item
+    unsigned pinsSeen = 0;
+    int      netNbItems = 0;
+    int      minConn = NOC;
 
-        switch( aList->GetItemType( netItemTst ) )
+    for( unsigned ii = aNet.m_Start; ii < aNet.m_End; ii++ )
+    {
+        switch( aList->GetItemType( ii ) )
         {
+        // These items do not create erc problems
         case NET_ITEM_UNSPECIFIED:
         case NET_SEGMENT:
         case NET_BUS:
         case NET_JUNCTION:
         case NET_LABEL:
-        case NET_HIERLABEL:
         case NET_BUSLABELMEMBER:
-        case NET_HIERBUSLABELMEMBER:
-        case NET_SHEETBUSLABELMEMBER:
-        case NET_SHEETLABEL:
+        case NET_PINLABEL:
         case NET_GLOBLABEL:
         case NET_GLOBBUSLABELMEMBER:
-        case NET_PINLABEL:
+            break;
+
+        case NET_HIERLABEL:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_SHEETLABEL:
+        case NET_SHEETBUSLABELMEMBER:
+
+            // ERC problems when pin sheets do not match hierarchical labels.
+            // Each pin sheet must match a hierarchical label
+            // Each hierarchical label must match a pin sheet
+            if( isLabelOrphaned( aList, ii, labels ) )
+                aNet.AddDiag( ii, -1, -1, WAR );
+
             break;
 
         case NET_NOCONNECT:
-            local_minconn = std::max( NET_NC, local_minconn );
+
+            // ERC problems when a noconnect symbol is connected to more than one pin.
+            minConn = NET_NC;
+
+            if( netNbItems != 0 )
+                aNet.AddDiag( ii, -1, minConn, UNC );
+
             break;
 
         case NET_PIN:
-            jj = aList->GetItem( netItemTst )->m_ElectricalType;
-            local_minconn = std::max( MinimalReq[ref_elect_type][jj], local_minconn );
+        {
+            // Look for ERC problems between pins:
+            int refType = aList->GetItem( ii )->m_ElectricalType;
+            int localMinConn = ( refType == PIN_NC ) ? NPI : NOC;
 
-            if( netItemTst <= aNetItemRef )
-                break;
+            pinsSeen++;
+            netNbItems += pinCount - pinsSeen;
 
-            *aNetNbItems += 1;
+            if( hasNoConnect )
+                localMinConn = std::max( NET_NC, localMinConn );
 
-            if( erc == OK )
+            int conflict = -1;      // First following pin having a conflict with this one
+
+            for( int jj = 0; jj < PIN_NMAX; jj++ )
             {
-                erc = DiagErc[ref_elect_type][jj];
+                const std::vector<unsigned>& pins = pinsOfType[jj];
+                unsigned count = pins.size() - ( jj == refType ? 1 : 0 );
+
+                if( count > 0 )
+                    localMinConn = std::max( MinimalReq[refType][jj], localMinConn );
 
-                if( erc != OK )
+                while( nextPin[jj] < pins.size() && pins[ nextPin[jj] ] <= ii )
+                    nextPin[jj]++;
+
+                if( DiagErc[refType][jj] != OK && nextPin[jj] < pins.size() )
                 {
-                    if( aList->GetConnectionType( netItemTst ) == UNCONNECTED )
-                    {
-                        Diagnose( aList->GetItem( aNetItemRef ),
-                                  aList->GetItem( netItemTst ),
-                                  0, erc );
-                        aList->SetConnectionType( netItemTst, NOCONNECT_SYMBOL_PRESENT );
-                    }
+                    int pin = pins[ nextPin[jj] ];
+
+                    if( conflict < 0 || pin < conflict )
+                        conflict = pin;
                 }
             }
 
+            if( conflict >= 0 && aList->GetConnectionType( conflict ) == UNCONNECTED )
+            {
+                int erc = DiagErc[refType][ aList->GetItem( conflict )->m_ElectricalType ];
+
+                aNet.AddDiag( ii, conflict, 0, erc );
+                aList->SetConnectionType( conflict, NOCONNECT_SYMBOL_PRESENT );
+            }
+
+            // Minimum connection test.
+            if( ( minConn < NET_NC ) && ( localMinConn < NET_NC ) )
+            {
+                // Not connected or not driven pin.
+                aNet.AddDiag( ii, -1, localMinConn, WAR, localMinConn == NOC );
+                minConn = DRV;      // inhibiting other messages of this type for the net.
+            }
+
             break;
         }
+        }
+    }
+}
+
+
+/**
+ * Function testNetJob
+ * tests the net \a aNet of \a aNets.
+ */
+static void testNetJob( std::vector<ERC_NET_JOB>* aNets, NETLIST_OBJECT_LIST* aList,
+                        unsigned aNet )
+{
+    testNet( aList, (*aNets)[aNet] );
+}
+
+
+/**
+ * Function hasConnectedDuplicate
+ * tells if an other instance of the unconnected pin \a aPin (the same pin of an other part
+ * of the same package) is connected.  \a aSamePinNum are the pins having its pin number.
+ */
+static bool hasConnectedDuplicate( NETLIST_OBJECT_LIST* aList, unsigned aPin,
+                                   const std::vector<unsigned>& aSamePinNum )
+{
+    NETLIST_OBJECT* pin = aList->GetItem( aPin );
+    bool            connected = false;
+
+    for( unsigned ii = 0; ii < aSamePinNum.size(); ii++ )
+    {
+        unsigned        duplicate = aSamePinNum[ii];
+        NETLIST_OBJECT* item = aList->GetItem( duplicate );
+
+        if( duplicate == aPin )
+            continue;
+
+        if( ( (SCH_COMPONENT*) pin->m_Link )->GetRef( &pin->m_SheetPath ) !=
+            ( (SCH_COMPONENT*) item->m_Link )->GetRef( &item->m_SheetPath ) )
+            continue;
+
+        // Same component and same pin. Do dot create error for this pin
+        // if the other pin is connected (i.e. if duplicate net has an other
+        // item)
+        if( (duplicate > 0)
+          && ( aList->GetItemNet( duplicate ) == aList->GetItemNet( duplicate - 1 ) ) )
+            connected = true;
+
+        if( (duplicate < aList->size() - 1)
+          && ( aList->GetItemNet( duplicate ) == aList->GetItemNet( duplicate + 1 ) ) )
+            connected = true;
+    }
+
+    return connected;
+}
+
+
+void TestNetConnections( NETLIST_OBJECT_LIST* aList )
+{
+    std::vector<ERC_NET_JOB> nets;
+
+    for( unsigned ii = 0; ii < aList->size(); ii++ )
+    {
+        if( ii == 0 || aList->GetItemNet( ii ) != aList->GetItemNet( ii - 1 ) )
+        {
+            // New net found:
+            ERC_NET_JOB net;
+            net.m_Start = ii;
+            nets.push_back( net );
+        }
+
+        nets.back().m_End = ii + 1;
+    }
+
+    if( nets.empty() )
+        return;
+
+    ParallelFor( nets.size(), boost::bind( testNetJob, &nets, aList, _1 ) );
+
+    // Pins by pin number, to find the other instances of unconnected pins
+    typedef boost::unordered_map< long, std::vector<unsigned> > PINS_BY_NUMBER;
+    PINS_BY_NUMBER pinsByNumber;
+
+    for( unsigned ii = 0; ii < aList->size(); ii++ )
+    {
+        if( aList->GetItemType( ii ) == NET_PIN )
+            pinsByNumber[ aList->GetItem( ii )->m_PinNum ].push_back( ii );
+    }
+
+    // Create the markers in the net list order
+    for( unsigned ii = 0; ii < nets.size(); ii++ )
+    {
+        const std::vector<ERC_DIAG>& diags = nets[ii].m_Diags;
+
+        for( unsigned jj = 0; jj < diags.size(); jj++ )
+        {
+            const ERC_DIAG& diag = diags[jj];
+
+            if( diag.m_CheckDuplicates
+              && hasConnectedDuplicate( aList, diag.m_Ref,
+                                        pinsByNumber[ aList->GetItem( diag.m_Ref )->m_PinNum ] ) )
+                continue;
+
+            Diagnose( aList->GetItem( diag.m_Ref ),
+                      diag.m_Tst < 0 ? NULL : aList->GetItem( diag.m_Tst ),
+                      diag.m_MinConn, diag.m_Diag );
+        }
     }
 }
 
@@ -531,38 +706,3 @@ bool WriteDiagnosticERC( const wxString& aFullFileName )
 
     return true;
 }
-
-
-void TestLabel( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned aStartNet )
-{
-    unsigned netItemTst = aStartNet;
-    int      erc = 1;
-
-    /* Review the list of labels connected to NetItemRef. */
-    for( ; ; netItemTst++ )
-    {
-        if( netItemTst == aNetItemRef )
-            continue;
-
-        /* Is always in the same net? */
-        if( ( netItemTst == aList->size() )
-          || ( aList->GetItemNet( aNetItemRef ) != aList->GetItemNet( netItemTst ) ) )
-        {
-            /* End Netcode found. */
-            if( erc )
-            {
-                /* Glabel or SheetLabel orphaned. */
-                Diagnose( aList->GetItem( aNetItemRef ), NULL, -1, WAR );
-            }
-
-            return;
-        }
-
-        if( aList->GetItem( aNetItemRef )->IsLabelConnected( aList->GetItem( netItemTst ) ) )
-            erc = 0;
-
-        //same thing, different order.
-        if( aList->GetItem( netItemTst )->IsLabelConnected( aList->GetItem( aNetItemRef ) ) )
-            erc = 0;
-    }
-}
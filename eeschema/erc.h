@@ -83,19 +83,13 @@ extern void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
                       int MinConnexion, int Diag );
 
 /**
- * Perform ERC testing for electrical conflicts between \a NetItemRef and other items
- * on the same net.
+ * Function TestNetConnections
+ * performs the ERC of each net of \a aList: conflicts between connected pins, minimal
+ * connection requirements, no connect symbols connected to more than one pin, and sheet
+ * labels not matching hierarchical labels.  Nets are tested in parallel, and the markers
+ * are created in the net list order.
  */
-extern void TestOthersItems( NETLIST_OBJECT_LIST* aList,
-                             unsigned aNetItemRef, unsigned aNetStart,
-                             int* aNetNbItems, int* aMinConnexion );
-
-/**
- * Function TestLabel
- * performs an ERC on a sheet labels to verify that it is connected to a corresponding
- * sub sheet global label.
- */
-extern void TestLabel( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned aStartNet );
+extern void TestNetConnections( NETLIST_OBJECT_LIST* aList );
 
 /**
  * Function TestDuplicateSheetNames( )
@@ -34,6 +34,7 @@
 #include <wxstruct.h>
 #include <bezier_curves.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <base_units.h>
 #include <msgpanel.h>
 
@@ -71,12 +72,17 @@ bool LIB_BEZIER::Save( OUTPUTFORMATTER& aFormatter )
 
 bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
-    char*   p;
     int     i, ccount = 0;
     wxPoint pt;
     char*   line = (char*) aLineReader;
 
-    i = sscanf( line + 2, "%d %d %d %d", &ccount, &m_Unit, &m_Convert, &m_Width );
+    LINE_TOKENIZER tokens( line + 2 );
+
+    tokens.NextInt( ccount );
+    tokens.NextInt( m_Unit );
+    tokens.NextInt( m_Convert );
+    tokens.NextInt( m_Width );
+    i = tokens.Parsed();
 
     if( i !=4 )
     {
@@ -90,25 +96,15 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         return false;
     }
 
-    p = strtok( line + 2, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-
     for( i = 0; i < ccount; i++ )
     {
-        wxPoint point;
-        p = strtok( NULL, " \t\n" );
-
-        if( sscanf( p, "%d", &pt.x ) != 1 )
+        if( !tokens.NextInt( pt.x ) )
         {
             aErrorMsg.Printf( _( "Bezier point %d X position not defined" ), i );
             return false;
         }
 
-        p = strtok( NULL, " \t\n" );
-
-        if( sscanf( p, "%d", &pt.y ) != 1 )
+        if( !tokens.NextInt( pt.y ) )
         {
             aErrorMsg.Printf( _( "Bezier point %d Y position not defined" ), i );
             return false;
@@ -119,7 +115,9 @@ bool LIB_BEZIER::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 
     m_Fill = NO_FILL;
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL )
+    char* p = tokens.NextToken();
+
+    if( p )
     {
         if( p[0] == 'F' )
             m_Fill = FILLED_SHAPE;
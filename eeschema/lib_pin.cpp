@@ -36,6 +36,7 @@
 #include <plot_common.h>
 #include <wxEeschemaStruct.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <base_units.h>
 #include <msgpanel.h>
 
@@ -663,18 +664,30 @@ bool LIB_PIN::Save( OUTPUTFORMATTER& aFormatter )
 bool LIB_PIN::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
     int  i, j;
-    char pinAttrs[64];
-    char pinName[256];
-    char pinNum[64];
-    char pinOrient[64];
-    char pinType[64];
     char* line = (char*) aLineReader;
 
-    *pinAttrs = 0;
+    // Format: name number x y length orientation number_size name_size unit convert
+    //         type [attributes]
+    LINE_TOKENIZER tokens( line + 2 );
 
-    i = sscanf( line + 2, "%s %s %d %d %d %s %d %d %d %d %s %s", pinName,
-                pinNum, &m_position.x, &m_position.y, &m_length, pinOrient, &m_numTextSize,
-                &m_nameTextSize, &m_Unit, &m_Convert, pinType, pinAttrs );
+    char* pinName = tokens.NextToken();
+    char* pinNum  = tokens.NextToken();
+
+    tokens.NextInt( m_position.x );
+    tokens.NextInt( m_position.y );
+    tokens.NextInt( m_length );
+
+    char* pinOrient = tokens.NextToken();
+
+    tokens.NextInt( m_numTextSize );
+    tokens.NextInt( m_nameTextSize );
+    tokens.NextInt( m_Unit );
+    tokens.NextInt( m_Convert );
+
+    char* pinType  = tokens.NextToken();
+    char* pinAttrs = tokens.NextToken();
+
+    i = tokens.Parsed();
 
     if( i < 11 )
     {
@@ -34,6 +34,7 @@
 #include <trigo.h>
 #include <wxstruct.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <base_units.h>
 #include <msgpanel.h>
 
@@ -73,12 +74,17 @@ bool LIB_POLYLINE::Save( OUTPUTFORMATTER& aFormatter )
 
 bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
 {
-    char*   p;
     int     i, ccount = 0;
     wxPoint pt;
     char*   line = (char*) aLineReader;
 
-    i = sscanf( line + 2, "%d %d %d %d", &ccount, &m_Unit, &m_Convert, &m_Width );
+    LINE_TOKENIZER tokens( line + 2 );
+
+    tokens.NextInt( ccount );
+    tokens.NextInt( m_Unit );
+    tokens.NextInt( m_Convert );
+    tokens.NextInt( m_Width );
+    i = tokens.Parsed();
 
     m_Fill = NO_FILL;
 
@@ -94,25 +100,15 @@ bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         return false;
     }
 
-    p = strtok( line + 2, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-    p = strtok( NULL, " \t\n" );
-
     for( i = 0; i < ccount; i++ )
     {
-        wxPoint point;
-        p = strtok( NULL, " \t\n" );
-
-        if( p == NULL || sscanf( p, "%d", &pt.x ) != 1 )
+        if( !tokens.NextInt( pt.x ) )
         {
             aErrorMsg.Printf( _( "Polyline point %d X position not defined" ), i );
             return false;
         }
 
-        p = strtok( NULL, " \t\n" );
-
-        if( p == NULL || sscanf( p, "%d", &pt.y ) != 1 )
+        if( !tokens.NextInt( pt.y ) )
         {
             aErrorMsg.Printf( _( "Polyline point %d Y position not defined" ), i );
             return false;
@@ -121,7 +117,9 @@ bool LIB_POLYLINE::Load( LINE_READER& aLineReader, wxString& aErrorMsg )
         AddPoint( pt );
     }
 
-    if( ( p = strtok( NULL, " \t\n" ) ) != NULL )
+    char* p = tokens.NextToken();
+
+    if( p )
     {
         if( p[0] == 'F' )
             m_Fill = FILLED_SHAPE;
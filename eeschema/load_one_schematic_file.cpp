@@ -45,6 +45,11 @@
 #include <sch_sheet.h>
 #include <sch_bitmap.h>
 #include <wildcards_and_files_ext.h>
+#include <template_fieldnames.h>
+#include <line_tokenizer.h>
+#include <parallel_for.h>
+
+#include <boost/bind.hpp>
 
 
 bool ReadSchemaDescr( LINE_READER* aLine, wxString& aMsgDiag, SCH_SCREEN* Window );
@@ -52,29 +57,24 @@ bool ReadSchemaDescr( LINE_READER* aLine, wxString& aMsgDiag, SCH_SCREEN* Window
 static void LoadLayers( LINE_READER* aLine );
 
 
-bool SCH_EDIT_FRAME::LoadOneEEFile( SCH_SCREEN* aScreen, const wxString& aFullFileName, bool append )
+/**
+ * Function loadSchematicFile
+ * reads the schematic file \a aFullFileName into \a aScreen.  It does not interact with
+ * the user, so it can run on a worker thread: the error which stopped the loading is
+ * stored in \a aError, and warnings in \a aWarning, for the caller to display them.
+ * Bitmap images are only read, buildScreenImages() must be called on the main thread
+ * to create them.
+ * @return bool - false if the file cannot be read or is not a schematic file, true if it
+ *  has been loaded, at least partially.
+ */
+static bool loadSchematicFile( SCH_SCREEN* aScreen, const wxString& aFullFileName,
+                               wxString& aError, wxString& aWarning )
 {
     char            name1[256];
     bool            itemLoaded = false;
     SCH_ITEM*       item;
     wxString        msgDiag;            // Error and log messages
     char*           line;
-    wxFileName      fn;
-
-    if( aScreen == NULL )
-        return false;
-
-    if( aFullFileName.IsEmpty() )
-        return false;
-
-    fn = aFullFileName;
-    CheckForAutoSaveFile( fn, SchematicBackupFileExtension );
-
-    wxLogTrace( traceAutoSave, wxT( "Loading schematic file " ) + aFullFileName );
-
-    aScreen->SetCurItem( NULL );
-    if( !append )
-        aScreen->SetFileName( aFullFileName );
 
     FILE* f;
     wxString fname = aFullFileName;
@@ -86,23 +86,18 @@ bool SCH_EDIT_FRAME::LoadOneEEFile( SCH_SCREEN* aScreen, const wxString& aFullFi
 
     if( ( f = wxFopen( fname, wxT( "rt" ) ) ) == NULL )
     {
-        msgDiag.Printf( _( "Failed to open <%s>" ), GetChars( aFullFileName ) );
-        DisplayError( this, msgDiag );
+        aError.Printf( _( "Failed to open <%s>" ), GetChars( aFullFileName ) );
         return false;
     }
 
     // reader now owns the open FILE.
     FILE_LINE_READER    reader( f, aFullFileName );
 
-    msgDiag.Printf( _( "Loading <%s>" ), GetChars( aScreen->GetFileName() ) );
-    PrintMsg( msgDiag );
-
     if( !reader.ReadLine()
         || strncmp( (char*)reader + 9, SCHEMATIC_HEAD_STRING,
                     sizeof( SCHEMATIC_HEAD_STRING ) - 1 ) != 0 )
     {
-        msgDiag.Printf( _( "<%s> is NOT an Eeschema file!" ), GetChars( aFullFileName ) );
-        DisplayError( this, msgDiag );
+        aError.Printf( _( "<%s> is NOT an Eeschema file!" ), GetChars( aFullFileName ) );
         return false;
     }
 
@@ -119,10 +114,9 @@ bool SCH_EDIT_FRAME::LoadOneEEFile( SCH_SCREEN* aScreen, const wxString& aFullFi
 
     if( version > EESCHEMA_VERSION )
     {
-        msgDiag.Printf( _( "<%s> was created by a more recent \
+        aWarning.Printf( _( "<%s> was created by a more recent \
 version of Eeschema and may not load correctly. Please consider updating!" ),
                 GetChars( aFullFileName ) );
-        DisplayInfoMessage( this, msgDiag );
     }
 
 #if 0
@@ -139,8 +133,7 @@ again." );
 
     if( !reader.ReadLine() || strncmp( reader, "LIBS:", 5 ) != 0 )
     {
-        msgDiag.Printf( _( "<%s> is NOT an Eeschema file!" ), GetChars( aFullFileName ) );
-        DisplayError( this, msgDiag );
+        aError.Printf( _( "<%s> is NOT an Eeschema file!" ), GetChars( aFullFileName ) );
         return false;
     }
 
@@ -246,7 +239,7 @@ again." );
             msgDiag.Printf( _( "Eeschema file object not loaded at line %d, aborted" ),
                             reader.LineNumber() );
             msgDiag << wxT( "\n" ) << FROM_UTF8( line );
-            DisplayError( this, msgDiag );
+            aError = msgDiag;
             break;
         }
     }
@@ -257,6 +250,72 @@ again." );
 
     aScreen->TestDanglingEnds();
 
+    return true;    // Although it may be that file is only partially loaded.
+}
+
+
+/**
+ * Function buildScreenImages
+ * creates the images of the bitmaps read by loadSchematicFile() in \a aScreen.  wxBitmap
+ * objects can only be created by the main thread, so this is not done by the workers.
+ */
+static void buildScreenImages( SCH_SCREEN* aScreen )
+{
+    bool hasImages = false;
+
+    for( SCH_ITEM* item = aScreen->GetDrawItems(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_BITMAP_T )
+        {
+            ( (SCH_BITMAP*) item )->m_Image->BuildImage();
+            hasImages = true;
+        }
+    }
+
+    // The bounding boxes of the images were empty when the items were indexed.
+    if( hasImages )
+        aScreen->InvalidateIndex();
+}
+
+
+bool SCH_EDIT_FRAME::LoadOneEEFile( SCH_SCREEN* aScreen, const wxString& aFullFileName, bool append )
+{
+    wxString        msgDiag;            // Error and log messages
+    wxFileName      fn;
+
+    if( aScreen == NULL )
+        return false;
+
+    if( aFullFileName.IsEmpty() )
+        return false;
+
+    fn = aFullFileName;
+    CheckForAutoSaveFile( fn, SchematicBackupFileExtension );
+
+    wxLogTrace( traceAutoSave, wxT( "Loading schematic file " ) + aFullFileName );
+
+    aScreen->SetCurItem( NULL );
+    if( !append )
+        aScreen->SetFileName( aFullFileName );
+
+    msgDiag.Printf( _( "Loading <%s>" ), GetChars( aScreen->GetFileName() ) );
+    PrintMsg( msgDiag );
+
+    wxString    error;
+    wxString    warning;
+    bool        success = loadSchematicFile( aScreen, aFullFileName, error, warning );
+
+    buildScreenImages( aScreen );
+
+    if( !warning.IsEmpty() )
+        DisplayInfoMessage( this, warning );
+
+    if( !error.IsEmpty() )
+        DisplayError( this, error );
+
+    if( !success )
+        return false;
+
     msgDiag.Printf( _( "Done Loading <%s>" ), GetChars( aScreen->GetFileName() ) );
     PrintMsg( msgDiag );
 
@@ -264,6 +323,88 @@ again." );
 }
 
 
+/// A schematic file loaded by SCH_EDIT_FRAME::LoadEEFiles()
+struct SCHEMATIC_LOAD_JOB
+{
+    SCH_SCREEN* m_Screen;
+    wxString    m_FileName;
+    wxString    m_Error;
+    wxString    m_Warning;
+    bool        m_Success;
+};
+
+
+/**
+ * Function loadSchematicFileJob
+ * is the worker thread job of SCH_EDIT_FRAME::LoadEEFiles(), it loads the file
+ * \a aJob of \a aJobs.
+ * It only reads and parses it, the images are built once the workers are joined.
+ */
+static void loadSchematicFileJob( std::vector<SCHEMATIC_LOAD_JOB>* aJobs, unsigned aJob )
+{
+    SCHEMATIC_LOAD_JOB& job = (*aJobs)[aJob];
+
+    job.m_Success = loadSchematicFile( job.m_Screen, job.m_FileName, job.m_Error,
+                                       job.m_Warning );
+}
+
+
+bool SCH_EDIT_FRAME::LoadEEFiles( const std::vector<SCH_SCREEN*>& aScreens,
+                                  const wxArrayString& aFileNames )
+{
+    wxCHECK_MSG( aScreens.size() == aFileNames.GetCount(), false,
+                 wxT( "One screen is needed for each schematic file." ) );
+
+    if( aScreens.empty() )
+        return true;
+
+    if( aScreens.size() == 1 )
+        return LoadOneEEFile( aScreens[0], aFileNames[0] );
+
+    std::vector<SCHEMATIC_LOAD_JOB> jobs( aScreens.size() );
+
+    // Everything which can interact with the user is done here, on the main thread.
+    for( unsigned ii = 0; ii < jobs.size(); ii++ )
+    {
+        jobs[ii].m_Screen   = aScreens[ii];
+        jobs[ii].m_FileName = aFileNames[ii];
+        jobs[ii].m_Success  = false;
+
+        CheckForAutoSaveFile( wxFileName( aFileNames[ii] ), SchematicBackupFileExtension );
+
+        wxLogTrace( traceAutoSave, wxT( "Loading schematic file " ) + aFileNames[ii] );
+
+        aScreens[ii]->SetCurItem( NULL );
+        aScreens[ii]->SetFileName( aFileNames[ii] );
+    }
+
+    // Initializes the static default field names, SCH_COMPONENT needs them.
+    TEMPLATE_FIELDNAME::GetDefaultFieldName( 0 );
+
+    ParallelFor( jobs.size(), boost::bind( loadSchematicFileJob, &jobs, _1 ) );
+
+    for( unsigned ii = 0; ii < jobs.size(); ii++ )
+        buildScreenImages( jobs[ii].m_Screen );
+
+    bool success = true;
+
+    // Report in the order of the files, as if they were loaded one after the other.
+    for( unsigned ii = 0; ii < jobs.size(); ii++ )
+    {
+        if( !jobs[ii].m_Warning.IsEmpty() )
+            DisplayInfoMessage( this, jobs[ii].m_Warning );
+
+        if( !jobs[ii].m_Error.IsEmpty() )
+            DisplayError( this, jobs[ii].m_Error );
+
+        if( !jobs[ii].m_Success )
+            success = false;
+    }
+
+    return success;
+}
+
+
 static void LoadLayers( LINE_READER* aLine )
 {
     /* read the layer descr
@@ -283,17 +424,18 @@ static void LoadLayers( LINE_READER* aLine )
 /// Get the length of a string constant, at compile time
 #define SZ( x )         (sizeof(x)-1)
 
-static const char delims[] = " \t\r\n";
-
 /* Read the schematic header. */
 bool ReadSchemaDescr( LINE_READER* aLine, wxString& aMsgDiag, SCH_SCREEN* aScreen )
 {
     char*   line = aLine->Line();
 
-    char*   pageType = strtok( line + SZ( "$Descr" ), delims );
-    char*   width    = strtok( NULL, delims );
-    char*   height   = strtok( NULL, delims );
-    char*   orient   = strtok( NULL, delims );
+    // Not strtok(), several sheets can be loaded at the same time
+    LINE_TOKENIZER tokens( line + SZ( "$Descr" ) );
+
+    char*   pageType = tokens.NextToken();
+    char*   width    = tokens.NextToken();
+    char*   height   = tokens.NextToken();
+    char*   orient   = tokens.NextToken();
 
     wxString pagename = FROM_UTF8( pageType );
 
@@ -44,9 +44,10 @@
 #include <sch_sheet.h>
 
 #include <wx/tokenzr.h>
-#include <xnode.h>      // also nests: <wx/xml/xml.h>
+#include <richio.h>
 #include <build_version.h>
 #include <set>
+#include <vector>
 
 #define INTERMEDIATE_NETLIST_EXT wxT("xml")
 
@@ -84,6 +85,217 @@ bool UNIQUE_STRINGS::Lookup( const wxString& aString )
 }
 
 
+/**
+ * Class NETLIST_STREAM_WRITER
+ * writes a document made of nested elements, attributes and text to an OUTPUTFORMATTER
+ * as it is visited, so the generic netlist never has to be held in memory as a tree.
+ * <p>
+ * Elements are closed in reverse order of opening, and the attributes of an element
+ * must be added before its text or its child elements.  Only leaf elements have text.
+ */
+class NETLIST_STREAM_WRITER
+{
+public:
+    NETLIST_STREAM_WRITER( OUTPUTFORMATTER* aOut ) :
+        m_out( aOut )
+    {
+    }
+
+    virtual ~NETLIST_STREAM_WRITER() {}
+
+    virtual void StartElement( const char* aName ) throw( IO_ERROR ) = 0;
+
+    virtual void AddAttribute( const char* aName, const wxString& aValue ) throw( IO_ERROR ) = 0;
+
+    virtual void AddText( const wxString& aText ) throw( IO_ERROR ) = 0;
+
+    virtual void EndElement() throw( IO_ERROR ) = 0;
+
+    /**
+     * Function Element
+     * writes a leaf element without attribute and with an optional textual content.
+     */
+    void Element( const char* aName, const wxString& aTextualContent = wxEmptyString )
+        throw( IO_ERROR )
+    {
+        StartElement( aName );
+
+        if( aTextualContent.Len() > 0 )     // excludes wxEmptyString, the parameter's default value
+            AddText( aTextualContent );
+
+        EndElement();
+    }
+
+protected:
+    OUTPUTFORMATTER*            m_out;
+    std::vector<const char*>    m_open;     ///< names of the currently open elements
+};
+
+
+/**
+ * Class SEXPR_NETLIST_WRITER
+ * writes the netlist in S-expression format, the same way XNODE::Format() does.
+ */
+class SEXPR_NETLIST_WRITER : public NETLIST_STREAM_WRITER
+{
+public:
+    SEXPR_NETLIST_WRITER( OUTPUTFORMATTER* aOut ) :
+        NETLIST_STREAM_WRITER( aOut )
+    {
+    }
+
+    void StartElement( const char* aName ) throw( IO_ERROR )
+    {
+        // A child element starts on a new line.  The newline is written here rather than
+        // after the closing parenthesis of its previous sibling, so the last child of an
+        // element is immediately followed by the parent's closing parenthesis.
+        if( !m_open.empty() )
+            m_out->Print( 0, "\n" );
+
+        m_out->Print( (int) m_open.size(), "(%s", m_out->Quotes( aName ).c_str() );
+        m_open.push_back( aName );
+    }
+
+    void AddAttribute( const char* aName, const wxString& aValue ) throw( IO_ERROR )
+    {
+        // attr names should never need quoting, no spaces, we designed the file.
+        m_out->Print( 0, " (%s %s)", m_out->Quotes( aName ).c_str(),
+                      m_out->Quotew( aValue ).c_str() );
+    }
+
+    void AddText( const wxString& aText ) throw( IO_ERROR )
+    {
+        m_out->Print( 0, " %s", m_out->Quotew( aText ).c_str() );
+    }
+
+    void EndElement() throw( IO_ERROR )
+    {
+        m_out->Print( 0, ")" );
+        m_open.pop_back();
+    }
+};
+
+
+/**
+ * Class XML_NETLIST_WRITER
+ * writes the netlist in XML format, the same way wxXmlDocument::Save() does with an
+ * indentation step of 2.
+ */
+class XML_NETLIST_WRITER : public NETLIST_STREAM_WRITER
+{
+public:
+    XML_NETLIST_WRITER( OUTPUTFORMATTER* aOut ) :
+        NETLIST_STREAM_WRITER( aOut ),
+        m_startTagOpen( false ),
+        m_lastWasText( false )
+    {
+    }
+
+    void StartDocument() throw( IO_ERROR )
+    {
+        m_out->Print( 0, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+    }
+
+    void EndDocument() throw( IO_ERROR )
+    {
+        m_out->Print( 0, "\n" );
+    }
+
+    void StartElement( const char* aName ) throw( IO_ERROR )
+    {
+        if( !m_open.empty() )
+        {
+            closeStartTag();
+            newLine( (int) m_open.size() );
+        }
+
+        m_out->Print( 0, "<%s", aName );
+        m_open.push_back( aName );
+        m_startTagOpen = true;
+        m_lastWasText  = false;
+    }
+
+    void AddAttribute( const char* aName, const wxString& aValue ) throw( IO_ERROR )
+    {
+        m_out->Print( 0, " %s=\"%s\"", aName, escape( aValue, true ).c_str() );
+    }
+
+    void AddText( const wxString& aText ) throw( IO_ERROR )
+    {
+        closeStartTag();
+        m_out->Print( 0, "%s", escape( aText, false ).c_str() );
+        m_lastWasText = true;
+    }
+
+    void EndElement() throw( IO_ERROR )
+    {
+        const char* name = m_open.back();
+
+        m_open.pop_back();
+
+        if( m_startTagOpen )
+        {
+            // no children, output "<foo/>"
+            m_out->Print( 0, "/>" );
+            m_startTagOpen = false;
+        }
+        else
+        {
+            if( !m_lastWasText )
+                newLine( (int) m_open.size() );
+
+            m_out->Print( 0, "</%s>", name );
+        }
+
+        m_lastWasText = false;
+    }
+
+private:
+    void closeStartTag() throw( IO_ERROR )
+    {
+        if( m_startTagOpen )
+        {
+            m_out->Print( 0, ">" );
+            m_startTagOpen = false;
+        }
+    }
+
+    void newLine( int aNestLevel ) throw( IO_ERROR )
+    {
+        m_out->Print( 0, "\n%*s", aNestLevel * 2, "" );
+    }
+
+    /// Returns \a aText in UTF8, with the characters that are special to XML escaped.
+    static std::string escape( const wxString& aText, bool aAttribute )
+    {
+        std::string utf8 = TO_UTF8( aText );
+        std::string escaped;
+
+        escaped.reserve( utf8.size() );
+
+        for( std::string::const_iterator it = utf8.begin(); it != utf8.end(); ++it )
+        {
+            switch( *it )
+            {
+            case '<':   escaped += "&lt;";      break;
+            case '>':   escaped += "&gt;";      break;
+            case '&':   escaped += "&amp;";     break;
+            case '\r':  escaped += "&#xD;";     break;
+            case '"':   escaped += aAttribute ? "&quot;" : "\"";    break;
+            case '\t':  escaped += aAttribute ? "&#x9;"  : "\t";    break;
+            case '\n':  escaped += aAttribute ? "&#xA;"  : "\n";    break;
+            default:    escaped += *it;         break;
+            }
+        }
+
+        return escaped;
+    }
+
+    bool    m_startTagOpen;     ///< the start tag of the innermost element still lacks its '>'
+    bool    m_lastWasText;      ///< the last thing written in the innermost element is text
+};
+
+
 /**
  * Class NETLIST_EXPORT_TOOL
  * is a private implementation class used in this source file to keep track
@@ -189,44 +401,43 @@ class NETLIST_EXPORT_TOOL
     bool writeListOfNetsCADSTAR( FILE* f );
 
     /**
-     * Function makeGenericRoot
-     * builds the entire document tree for the generic export.  This is factored
-     * out here so we can write the tree in either S-expression file format
-     * or in XML if we put the tree built here into a wxXmlDocument.
+     * Function writeGenericRoot
+     * writes the entire document for the generic export.  This is factored
+     * out here so we can write the document in either S-expression file format
+     * or in XML, depending on \a aOut.
      */
-    XNODE* makeGenericRoot();
+    void writeGenericRoot( NETLIST_STREAM_WRITER* aOut );
 
     /**
-     * Function makeGenericComponents
-     * returns a sub-tree holding all the schematic components.
+     * Function writeGenericComponents
+     * writes an element holding all the schematic components.
      */
-    XNODE* makeGenericComponents();
+    void writeGenericComponents( NETLIST_STREAM_WRITER* aOut );
 
     /**
-     * Function makeGenericDesignHeader
-     * fills out a project "design" header into an XML node.
-     * @return XNODE* - the design header
+     * Function writeGenericDesignHeader
+     * writes a project "design" header element.
      */
-    XNODE* makeGenericDesignHeader();
+    void writeGenericDesignHeader( NETLIST_STREAM_WRITER* aOut );
 
     /**
-     * Function makeGenericLibParts
-     * fills out an XML node with the unique library parts and returns it.
+     * Function writeGenericLibParts
+     * writes an element holding the unique library parts.
      */
-    XNODE* makeGenericLibParts();
+    void writeGenericLibParts( NETLIST_STREAM_WRITER* aOut );
 
     /**
-     * Function makeGenericListOfNets
-     * fills out an XML node with a list of nets and returns it.
+     * Function writeGenericListOfNets
+     * writes an element holding the list of nets.
      */
-    XNODE* makeGenericListOfNets();
+    void writeGenericListOfNets( NETLIST_STREAM_WRITER* aOut );
 
     /**
-     * Function makeGenericLibraries
-     * fills out an XML node with a list of used libraries and returns it.
-     * Must have called makeGenericLibParts() before this function.
+     * Function writeGenericLibraries
+     * writes an element holding the list of used libraries.
+     * Must have called writeGenericLibParts() before this function.
      */
-    XNODE* makeGenericLibraries();
+    void writeGenericLibraries( NETLIST_STREAM_WRITER* aOut );
 
 public:
     NETLIST_EXPORT_TOOL( NETLIST_OBJECT_LIST * aMasterList )
@@ -614,38 +825,17 @@ SCH_COMPONENT* NETLIST_EXPORT_TOOL::findNextComponentAndCreatePinList( EDA_ITEM*
 }
 
 
-/**
- * Function node
- * is a convenience function that creates a new XNODE with an optional textual child.
- * It also provides some insulation from a possible change in XML library.
- *
- * @param aName is the name to associate with a new node of type wxXML_ELEMENT_NODE.
- * @param aTextualContent is optional, and if given is the text to include in a child
- *   of the returned node, and has type wxXML_TEXT_NODE.
- */
-static XNODE* node( const wxString& aName, const wxString& aTextualContent = wxEmptyString )
+void NETLIST_EXPORT_TOOL::writeGenericDesignHeader( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
-
-    if( aTextualContent.Len() > 0 )     // excludes wxEmptyString, the parameter's default value
-        n->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, aTextualContent ) );
-
-    return n;
-}
-
-
-XNODE* NETLIST_EXPORT_TOOL::makeGenericDesignHeader()
-{
-    XNODE*  xdesign = node( wxT("design") );
+    aOut->StartElement( "design" );
 
     // the root sheet is a special sheet, call it source
-    xdesign->AddChild( node( wxT( "source" ), g_RootSheet->GetScreen()->GetFileName() ) );
+    aOut->Element( "source", g_RootSheet->GetScreen()->GetFileName() );
 
-    xdesign->AddChild( node( wxT( "date" ), DateAndTime() ) );
+    aOut->Element( "date", DateAndTime() );
 
     // which Eeschema tool
-    xdesign->AddChild( node( wxT( "tool" ), wxGetApp().GetAppName() + wxChar(' ') +
-                             GetBuildVersion() ) );
+    aOut->Element( "tool", wxGetApp().GetAppName() + wxChar(' ') + GetBuildVersion() );
 
     /*  @todo might do a list of schematic pages
 
@@ -669,56 +859,40 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericDesignHeader()
         </sheets>
     */
 
-    return xdesign;
+    aOut->EndElement();
 }
 
 
-XNODE* NETLIST_EXPORT_TOOL::makeGenericLibraries()
+void NETLIST_EXPORT_TOOL::writeGenericLibraries( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE*  xlibs = node( wxT( "libraries" ) );     // auto_ptr
+    aOut->StartElement( "libraries" );
 
     for( std::set<void*>::iterator it = m_Libraries.begin(); it!=m_Libraries.end();  ++it )
     {
         CMP_LIBRARY*    lib = (CMP_LIBRARY*) *it;
-        XNODE*      xlibrary;
 
-        xlibs->AddChild( xlibrary = node( wxT( "library" ) ) );
-        xlibrary->AddAttribute( wxT( "logical" ), lib->GetLogicalName() );
-        xlibrary->AddChild( node( wxT( "uri" ),  lib->GetFullFileName() ) );
+        aOut->StartElement( "library" );
+        aOut->AddAttribute( "logical", lib->GetLogicalName() );
+        aOut->Element( "uri", lib->GetFullFileName() );
 
         // @todo: add more fun stuff here
+
+        aOut->EndElement();
     }
 
-    return xlibs;
+    aOut->EndElement();
 }
 
 
-XNODE* NETLIST_EXPORT_TOOL::makeGenericLibParts()
+void NETLIST_EXPORT_TOOL::writeGenericLibParts( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE*      xlibparts = node( wxT( "libparts" ) );   // auto_ptr
-    wxString    sLibpart  = wxT( "libpart" );
-    wxString    sLib      = wxT( "lib" );
-    wxString    sPart     = wxT( "part" );
-    wxString    sAliases  = wxT( "aliases" );
-    wxString    sAlias    = wxT( "alias" );
-    wxString    sPins     = wxT( "pins" );      // key for library component pins list
-    wxString    sPin      = wxT( "pin" );       // key for one library component pin descr
-    wxString    sPinNum   = wxT( "num" );       // key for one library component pin num
-    wxString    sPinName  = wxT( "name" );      // key for one library component pin name
-    wxString    sPinType  = wxT( "type" );      // key for one library component pin electrical type
-    wxString    sName     = wxT( "name" );
-    wxString    sField    = wxT( "field" );
-    wxString    sFields   = wxT( "fields" );
-    wxString    sDescr    = wxT( "description" );
-    wxString    sDocs     = wxT( "docs" );
-    wxString    sFprints  = wxT( "footprints" );
-    wxString    sFp       = wxT( "fp" );
-
     LIB_PINS    pinList;
     LIB_FIELDS  fieldList;
 
     m_Libraries.clear();
 
+    aOut->StartElement( "libparts" );
+
     for( std::set<void*>::iterator it = m_LibParts.begin(); it!=m_LibParts.end();  ++it )
     {
         LIB_COMPONENT*  lcomp = (LIB_COMPONENT*) *it;
@@ -726,61 +900,65 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericLibParts()
 
         m_Libraries.insert( library );  // inserts component's library if unique
 
-        XNODE*      xlibpart;
-        xlibparts->AddChild( xlibpart = node( sLibpart ) );
-        xlibpart->AddAttribute( sLib, library->GetLogicalName() );
-        xlibpart->AddAttribute( sPart, lcomp->GetName()  );
+        aOut->StartElement( "libpart" );
+        aOut->AddAttribute( "lib", library->GetLogicalName() );
+        aOut->AddAttribute( "part", lcomp->GetName()  );
 
         if( lcomp->GetAliasCount() )
         {
             wxArrayString aliases = lcomp->GetAliasNames( false );
             if( aliases.GetCount() )
             {
-                XNODE*  xaliases = node( sAliases );
-                xlibpart->AddChild( xaliases );
+                aOut->StartElement( "aliases" );
+
                 for( unsigned i=0;  i<aliases.GetCount();  ++i )
                 {
-                    xaliases->AddChild( node( sAlias, aliases[i] ) );
+                    aOut->Element( "alias", aliases[i] );
                 }
+
+                aOut->EndElement();
             }
         }
 
         //----- show the important properties -------------------------
         if( !lcomp->GetAlias( 0 )->GetDescription().IsEmpty() )
-            xlibpart->AddChild( node( sDescr, lcomp->GetAlias( 0 )->GetDescription() ) );
+            aOut->Element( "description", lcomp->GetAlias( 0 )->GetDescription() );
 
         if( !lcomp->GetAlias( 0 )->GetDocFileName().IsEmpty() )
-            xlibpart->AddChild( node( sDocs,  lcomp->GetAlias( 0 )->GetDocFileName() ) );
+            aOut->Element( "docs", lcomp->GetAlias( 0 )->GetDocFileName() );
 
         // Write the footprint list
         if( lcomp->GetFootPrints().GetCount() )
         {
-            XNODE*  xfootprints;
-            xlibpart->AddChild( xfootprints = node( sFprints ) );
+            aOut->StartElement( "footprints" );
 
             for( unsigned i=0; i<lcomp->GetFootPrints().GetCount(); ++i )
             {
-                xfootprints->AddChild( node( sFp, lcomp->GetFootPrints()[i] ) );
+                aOut->Element( "fp", lcomp->GetFootPrints()[i] );
             }
+
+            aOut->EndElement();
         }
 
         //----- show the fields here ----------------------------------
         fieldList.clear();
         lcomp->GetFields( fieldList );
 
-        XNODE*     xfields;
-        xlibpart->AddChild( xfields = node( sFields ) );
+        aOut->StartElement( "fields" );
 
         for( unsigned i=0;  i<fieldList.size();  ++i )
         {
             if( !fieldList[i].GetText().IsEmpty() )
             {
-                XNODE*     xfield;
-                xfields->AddChild( xfield = node( sField, fieldList[i].GetText() ) );
-                xfield->AddAttribute( sName, fieldList[i].GetName(false) );
+                aOut->StartElement( "field" );
+                aOut->AddAttribute( "name", fieldList[i].GetName(false) );
+                aOut->AddText( fieldList[i].GetText() );
+                aOut->EndElement();
             }
         }
 
+        aOut->EndElement();
+
         //----- show the pins here ------------------------------------
         pinList.clear();
         lcomp->GetPins( pinList, 0, 0 );
@@ -805,43 +983,36 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericLibParts()
 
         if( pinList.size() )
         {
-            XNODE*     pins;
+            aOut->StartElement( "pins" );
 
-            xlibpart->AddChild( pins = node( sPins ) );
             for( unsigned i=0; i<pinList.size();  ++i )
             {
-                XNODE*     pin;
-
-                pins->AddChild( pin = node( sPin ) );
-                pin->AddAttribute( sPinNum, pinList[i]->GetNumberString() );
-                pin->AddAttribute( sPinName, pinList[i]->GetName() );
-                pin->AddAttribute( sPinType, pinList[i]->GetTypeString() );
+                aOut->StartElement( "pin" );
+                aOut->AddAttribute( "num", pinList[i]->GetNumberString() );
+                aOut->AddAttribute( "name", pinList[i]->GetName() );
+                aOut->AddAttribute( "type", pinList[i]->GetTypeString() );
 
                 // caution: construction work site here, drive slowly
+
+                aOut->EndElement();
             }
+
+            aOut->EndElement();
         }
+
+        aOut->EndElement();     // libpart
     }
 
-    return xlibparts;
+    aOut->EndElement();         // libparts
 }
 
 
-XNODE* NETLIST_EXPORT_TOOL::makeGenericListOfNets()
+void NETLIST_EXPORT_TOOL::writeGenericListOfNets( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE*      xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
 
-    wxString    sNet  = wxT( "net" );
-    wxString    sName = wxT( "name" );
-    wxString    sCode = wxT( "code" );
-    wxString    sRef  = wxT( "ref" );
-    wxString    sPin  = wxT( "pin" );
-    wxString    sNode = wxT( "node" );
-    wxString    sFmtd = wxT( "%d" );
-
-    XNODE*      xnet = 0;
     int         netCode;
     int         lastNetCode = -1;
     int         sameNetcodeCount = 0;
@@ -856,6 +1027,8 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericListOfNets()
 
     m_LibParts.clear();     // must call this function before using m_LibParts.
 
+    aOut->StartElement( "nets" );
+
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
     {
         NETLIST_OBJECT* nitem = m_masterList->GetItem( ii );
@@ -864,6 +1037,9 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericListOfNets()
         // New net found, write net id;
         if( ( netCode = nitem->GetNet() ) != lastNetCode )
         {
+            if( sameNetcodeCount > 0 )
+                aOut->EndElement();     // previous net
+
             sameNetcodeCount = 0;   // item count for this net
             netName = nitem->GetNetName();
             lastNetCode  = netCode;
@@ -884,80 +1060,56 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericListOfNets()
 
         if( ++sameNetcodeCount == 1 )
         {
-            xnets->AddChild( xnet = node( sNet ) );
-            netCodeTxt.Printf( sFmtd, netCode );
-            xnet->AddAttribute( sCode, netCodeTxt );
-            xnet->AddAttribute( sName, netName );
+            aOut->StartElement( "net" );
+            netCodeTxt.Printf( wxT( "%d" ), netCode );
+            aOut->AddAttribute( "code", netCodeTxt );
+            aOut->AddAttribute( "name", netName );
         }
 
-        XNODE*      xnode;
-        xnet->AddChild( xnode = node( sNode ) );
-        xnode->AddAttribute( sRef, ref );
-        xnode->AddAttribute( sPin,  nitem->GetPinNumText() );
+        aOut->StartElement( "node" );
+        aOut->AddAttribute( "ref", ref );
+        aOut->AddAttribute( "pin",  nitem->GetPinNumText() );
+        aOut->EndElement();
     }
 
-    return xnets;
+    if( sameNetcodeCount > 0 )
+        aOut->EndElement();     // last net
+
+    aOut->EndElement();         // nets
 }
 
 
-XNODE* NETLIST_EXPORT_TOOL::makeGenericRoot()
+void NETLIST_EXPORT_TOOL::writeGenericRoot( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE*      xroot = node( wxT( "export" ) );
-
-    xroot->AddAttribute( wxT( "version" ), wxT( "D" ) );
+    aOut->StartElement( "export" );
+    aOut->AddAttribute( "version", wxT( "D" ) );
 
     // add the "design" header
-    xroot->AddChild( makeGenericDesignHeader() );
+    writeGenericDesignHeader( aOut );
 
-    xroot->AddChild( makeGenericComponents() );
+    writeGenericComponents( aOut );
 
-    xroot->AddChild( makeGenericLibParts() );
+    writeGenericLibParts( aOut );
 
-    // must follow makeGenericLibParts()
-    xroot->AddChild( makeGenericLibraries() );
+    // must follow writeGenericLibParts()
+    writeGenericLibraries( aOut );
 
-    xroot->AddChild( makeGenericListOfNets() );
+    writeGenericListOfNets( aOut );
 
-    return xroot;
+    aOut->EndElement();
 }
 
 
-XNODE* NETLIST_EXPORT_TOOL::makeGenericComponents()
+void NETLIST_EXPORT_TOOL::writeGenericComponents( NETLIST_STREAM_WRITER* aOut )
 {
-    XNODE*      xcomps = node( wxT( "components" ) );
-
     wxString    timeStamp;
 
-    // some strings we need many times, but don't want to construct more
-    // than once for performance.  These are used within loops so the
-    // enclosing wxString constructor would fire on each loop iteration if
-    // they were in a nested scope.
-
-    // these are actually constructor invocations, not assignments as it appears:
-    wxString    sFields     = wxT( "fields" );
-    wxString    sField      = wxT( "field" );
-    wxString    sComponent  = wxT( "comp" );          // use "part" ?
-    wxString    sName       = wxT( "name" );
-    wxString    sRef        = wxT( "ref" );
-    wxString    sPins       = wxT( "pins" );
-    wxString    sPin        = wxT( "pin" );
-    wxString    sValue      = wxT( "value" );
-    wxString    sSheetPath  = wxT( "sheetpath" );
-    wxString    sFootprint  = wxT( "footprint" );
-    wxString    sDatasheet  = wxT( "datasheet" );
-    wxString    sTStamp     = wxT( "tstamp" );
-    wxString    sTStamps    = wxT( "tstamps" );
-    wxString    sTSFmt      = wxT( "%8.8lX" );        // comp->m_TimeStamp
-    wxString    sLibSource  = wxT( "libsource" );
-    wxString    sLibPart    = wxT( "libpart" );
-    wxString    sLib        = wxT( "lib" );
-    wxString    sPart       = wxT( "part" );
-    wxString    sNames      = wxT( "names" );
-
     m_ReferencesAlreadyFound.Clear();
 
     SCH_SHEET_LIST sheetList;
 
+    aOut->StartElement( "components" );
+
     // Output is xml, so there is no reason to remove spaces from the field values.
     // And XML element names need not be translated to various languages.
 
@@ -971,31 +1123,28 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericComponents()
 
             schItem = comp;
 
-            XNODE* xcomp;  // current component being constructed
-
             // Output the component's elements in order of expected access frequency.
             // This may not always look best, but it will allow faster execution
             // under XSL processing systems which do sequential searching within
             // an element.
 
-            xcomps->AddChild( xcomp = node( sComponent ) );
-            xcomp->AddAttribute( sRef, comp->GetRef( path ) );
+            aOut->StartElement( "comp" );       // use "part" ?
+            aOut->AddAttribute( "ref", comp->GetRef( path ) );
 
-            xcomp->AddChild( node( sValue, comp->GetField( VALUE )->GetText() ) );
+            aOut->Element( "value", comp->GetField( VALUE )->GetText() );
 
             if( !comp->GetField( FOOTPRINT )->IsVoid() )
-                xcomp->AddChild( node( sFootprint, comp->GetField( FOOTPRINT )->GetText() ) );
+                aOut->Element( "footprint", comp->GetField( FOOTPRINT )->GetText() );
 
             if( !comp->GetField( DATASHEET )->IsVoid() )
-                xcomp->AddChild( node( sDatasheet, comp->GetField( DATASHEET )->GetText() ) );
+                aOut->Element( "datasheet", comp->GetField( DATASHEET )->GetText() );
 
             // Export all user defined fields within the component,
             // which start at field index MANDATORY_FIELDS.  Only output the <fields>
             // container element if there are any <field>s.
             if( comp->GetFieldCount() > MANDATORY_FIELDS )
             {
-                XNODE* xfields;
-                xcomp->AddChild( xfields = node( sFields ) );
+                aOut->StartElement( "fields" );
 
                 for( int fldNdx = MANDATORY_FIELDS; fldNdx < comp->GetFieldCount(); ++fldNdx )
                 {
@@ -1004,35 +1153,40 @@ XNODE* NETLIST_EXPORT_TOOL::makeGenericComponents()
                     // only output a field if non empty and not just "~"
                     if( !f->IsVoid() )
                     {
-                        XNODE*  xfield;
-                        xfields->AddChild( xfield = node( sField, f->GetText() ) );
-                        xfield->AddAttribute( sName, f->GetName() );
+                        aOut->StartElement( "field" );
+                        aOut->AddAttribute( "name", f->GetName() );
+                        aOut->AddText( f->GetText() );
+                        aOut->EndElement();
                     }
                 }
+
+                aOut->EndElement();
             }
 
-            XNODE*  xlibsource;
-            xcomp->AddChild( xlibsource = node( sLibSource ) );
+            aOut->StartElement( "libsource" );
 
             // "logical" library name, which is in anticipation of a better search
             // algorithm for parts based on "logical_lib.part" and where logical_lib
             // is merely the library name minus path and extension.
             LIB_COMPONENT* entry = CMP_LIBRARY::FindLibraryComponent( comp->GetLibName() );
             if( entry )
-                xlibsource->AddAttribute( sLib, entry->GetLibrary()->GetLogicalName() );
-            xlibsource->AddAttribute( sPart, comp->GetLibName() );
+                aOut->AddAttribute( "lib", entry->GetLibrary()->GetLogicalName() );
+            aOut->AddAttribute( "part", comp->GetLibName() );
+            aOut->EndElement();
 
-            XNODE* xsheetpath;
-            xcomp->AddChild( xsheetpath = node( sSheetPath ) );
-            xsheetpath->AddAttribute( sNames, path->PathHumanReadable() );
-            xsheetpath->AddAttribute( sTStamps, path->Path() );
+            aOut->StartElement( "sheetpath" );
+            aOut->AddAttribute( "names", path->PathHumanReadable() );
+            aOut->AddAttribute( "tstamps", path->Path() );
+            aOut->EndElement();
 
-            timeStamp.Printf( sTSFmt, comp->GetTimeStamp() );
-            xcomp->AddChild( node( sTStamp, timeStamp ) );
+            timeStamp.Printf( wxT( "%8.8lX" ), comp->GetTimeStamp() );
+            aOut->Element( "tstamp", timeStamp );
+
+            aOut->EndElement();     // comp
         }
     }
 
-    return xcomps;
+    aOut->EndElement();             // components
 }
 
 
@@ -1042,13 +1196,12 @@ bool NETLIST_EXPORT_TOOL::WriteKiCadNetList( const wxString& aOutFileName )
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
         m_masterList->GetItem( ii )->m_Flag = 0;
 
-    std::auto_ptr<XNODE>    xroot( makeGenericRoot() );
-
     try
     {
         FILE_OUTPUTFORMATTER    formatter( aOutFileName );
+        SEXPR_NETLIST_WRITER    writer( &formatter );
 
-        xroot->Format( &formatter, 0 );
+        writeGenericRoot( &writer );
     }
     catch( IO_ERROR ioe )
     {
@@ -1066,11 +1219,22 @@ bool NETLIST_EXPORT_TOOL::WriteGENERICNetList( const wxString& aOutFileName )
         m_masterList->GetItem( ii )->m_Flag = 0;
 
     // output the XML format netlist.
-    wxXmlDocument   xdoc;
+    try
+    {
+        FILE_OUTPUTFORMATTER    formatter( aOutFileName );
+        XML_NETLIST_WRITER      writer( &formatter );
 
-    xdoc.SetRoot( makeGenericRoot() );
+        writer.StartDocument();
+        writeGenericRoot( &writer );
+        writer.EndDocument();
+    }
+    catch( IO_ERROR ioe )
+    {
+        DisplayError( NULL, ioe.errorText );
+        return false;
+    }
 
-    return xdoc.Save( aOutFileName, 2 /* indent bug, today was ignored by wxXml lib */ );
+    return true;
 }
 
 
@@ -40,9 +40,13 @@
 #include <sch_no_connect.h>
 #include <sch_text.h>
 #include <sch_sheet.h>
+#include <geometry/rtree.h>
+#include <parallel_for.h>
 #include <algorithm>
 
 #include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/bind.hpp>
 
 #define IS_WIRE false
 #define IS_BUS true
@@ -52,6 +56,218 @@ NETLIST_OBJECT_LIST s_NetObjectslist( true );
 
 //#define NETLIST_DEBUG
 
+
+/**
+ * Class SHEET_CONNECTION_INDEX
+ * indexes the items of a single sheet by their end points (for point to point
+ * connections) and the wires and buses by their area (for junctions and labels
+ * connected to the middle of a segment), so connections of an item are found without
+ * scanning the whole sheet.
+ */
+class SHEET_CONNECTION_INDEX
+{
+public:
+    /**
+     * Function Build
+     * indexes items aStart to aEnd - 1 of aList, all of them must belong to the same sheet.
+     */
+    void Build( NETLIST_OBJECT_LIST& aList, unsigned aStart, unsigned aEnd )
+    {
+        for( int ii = 0; ii < 2; ii++ )
+        {
+            m_points[ii].clear();
+            m_segments[ii].RemoveAll();
+        }
+
+        for( unsigned ii = aStart; ii < aEnd; ii++ )
+        {
+            NETLIST_OBJECT* item = aList.GetItem( ii );
+
+            if( isWireConnectable( item->m_Type ) )
+                addPoints( item, IS_WIRE );
+
+            if( isBusConnectable( item->m_Type ) )
+                addPoints( item, IS_BUS );
+
+            if( item->m_Type == NET_SEGMENT || item->m_Type == NET_BUS )
+            {
+                int mmin[2] = { std::min( item->m_Start.x, item->m_End.x ),
+                                std::min( item->m_Start.y, item->m_End.y ) };
+                int mmax[2] = { std::max( item->m_Start.x, item->m_End.x ),
+                                std::max( item->m_Start.y, item->m_End.y ) };
+
+                m_segments[item->m_Type == NET_BUS].Insert( mmin, mmax, item );
+            }
+        }
+    }
+
+    /**
+     * Function GetConnectedPoints
+     * appends to aResult the items having an end point in common with aRef
+     * (possibly including aRef itself and items found twice).
+     */
+    void GetConnectedPoints( const NETLIST_OBJECT* aRef, bool aIsBus,
+                             std::vector<NETLIST_OBJECT*>& aResult )
+    {
+        appendItemsAt( aRef->m_Start, aIsBus, aResult );
+
+        if( aRef->m_End != aRef->m_Start )
+            appendItemsAt( aRef->m_End, aIsBus, aResult );
+    }
+
+    /**
+     * Function GetSegmentsAt
+     * appends to aResult wires (or buses if aIsBus) passing through aPoint.
+     */
+    void GetSegmentsAt( const wxPoint& aPoint, bool aIsBus,
+                        std::vector<NETLIST_OBJECT*>& aResult )
+    {
+        const int       pt[2] = { aPoint.x, aPoint.y };
+        SEGMENT_VISITOR visitor( aPoint, aResult );
+
+        m_segments[aIsBus].Search( pt, pt, visitor );
+    }
+
+private:
+    typedef std::pair<int, int>                                             POINT_KEY;
+    typedef boost::unordered_map<POINT_KEY, std::vector<NETLIST_OBJECT*> >  POINT_MAP;
+
+    ///> Collects segments found in the R-tree that actually pass through a point
+    class SEGMENT_VISITOR
+    {
+    public:
+        SEGMENT_VISITOR( const wxPoint& aPoint, std::vector<NETLIST_OBJECT*>& aResult ) :
+            m_point( aPoint ), m_result( aResult )
+        {
+        }
+
+        bool operator()( NETLIST_OBJECT* aSegment )
+        {
+            if( IsPointOnSegment( aSegment->m_Start, aSegment->m_End, m_point ) )
+                m_result.push_back( aSegment );
+
+            return true;
+        }
+
+    private:
+        const wxPoint&                  m_point;
+        std::vector<NETLIST_OBJECT*>&   m_result;
+    };
+
+    // Items connected point to point to wires
+    static bool isWireConnectable( NETLIST_ITEM_T aType )
+    {
+        switch( aType )
+        {
+        case NET_SEGMENT:
+        case NET_PIN:
+        case NET_LABEL:
+        case NET_HIERLABEL:
+        case NET_GLOBLABEL:
+        case NET_SHEETLABEL:
+        case NET_PINLABEL:
+        case NET_JUNCTION:
+        case NET_NOCONNECT:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    // Items connected point to point to buses
+    static bool isBusConnectable( NETLIST_ITEM_T aType )
+    {
+        switch( aType )
+        {
+        case NET_BUS:
+        case NET_BUSLABELMEMBER:
+        case NET_SHEETBUSLABELMEMBER:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_GLOBBUSLABELMEMBER:
+        case NET_JUNCTION:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    void addPoints( NETLIST_OBJECT* aItem, bool aIsBus )
+    {
+        m_points[aIsBus][ POINT_KEY( aItem->m_Start.x, aItem->m_Start.y ) ].push_back( aItem );
+
+        if( aItem->m_End != aItem->m_Start )
+            m_points[aIsBus][ POINT_KEY( aItem->m_End.x, aItem->m_End.y ) ].push_back( aItem );
+    }
+
+    void appendItemsAt( const wxPoint& aPoint, bool aIsBus, std::vector<NETLIST_OBJECT*>& aResult )
+    {
+        POINT_MAP::const_iterator it = m_points[aIsBus].find( POINT_KEY( aPoint.x, aPoint.y ) );
+
+        if( it != m_points[aIsBus].end() )
+            aResult.insert( aResult.end(), it->second.begin(), it->second.end() );
+    }
+
+    POINT_MAP                               m_points[2];    ///< Indexed by aIsBus
+    RTree<NETLIST_OBJECT*, int, 2, float>   m_segments[2];  ///< Indexed by aIsBus
+};
+
+
+/**
+ * Class LABEL_NAME_INDEX
+ * groups the labels of a NETLIST_OBJECT_LIST by name (case insensitive), labels are
+ * connected only to labels having the same name.
+ */
+class LABEL_NAME_INDEX
+{
+public:
+    LABEL_NAME_INDEX( NETLIST_OBJECT_LIST& aList )
+    {
+        for( unsigned ii = 0; ii < aList.size(); ii++ )
+        {
+            NETLIST_OBJECT* item = aList.GetItem( ii );
+
+            if( item->IsLabelType() )
+                m_labels[ key( item->m_Label ) ].push_back( item );
+        }
+    }
+
+    /**
+     * Function GetLabels
+     * @return the labels named aName (case insensitive), in the list order.
+     */
+    const std::vector<NETLIST_OBJECT*>& GetLabels( const wxString& aName )
+    {
+        LABEL_MAP::const_iterator it = m_labels.find( key( aName ) );
+
+        return it != m_labels.end() ? it->second : m_empty;
+    }
+
+private:
+    typedef boost::unordered_map<std::string, std::vector<NETLIST_OBJECT*> > LABEL_MAP;
+
+    static std::string key( const wxString& aName )
+    {
+        return std::string( aName.Lower().utf8_str() );
+    }
+
+    LABEL_MAP                       m_labels;
+    std::vector<NETLIST_OBJECT*>    m_empty;
+};
+
+
+/**
+ * Struct SHEET_ITEMS
+ * holds the connected items of a single sheet, while they are extracted.
+ */
+struct SHEET_ITEMS
+{
+    SCH_SHEET_PATH*     m_Sheet;
+    NETLIST_OBJECT_LIST m_Items;
+};
+
+
 NETLIST_OBJECT_LIST::~NETLIST_OBJECT_LIST()
 {
     if( m_isOwner )
@@ -119,6 +335,26 @@ NETLIST_OBJECT_LIST * SCH_EDIT_FRAME::BuildNetListBase()
     return &s_NetObjectslist;
 }
 
+/**
+ * Function getSheetNetListItems
+ * is the job filling the list of connected items of the sheet \a aSheet.
+ */
+static void getSheetNetListItems( std::vector<SHEET_ITEMS>* aSheets, unsigned aSheet )
+{
+    SCH_SHEET_PATH* sheet = (*aSheets)[aSheet].m_Sheet;
+
+    for( SCH_ITEM* item = sheet->LastScreen()->GetDrawItems(); item; item = item->Next() )
+        item->GetNetListItem( (*aSheets)[aSheet].m_Items, sheet );
+}
+
+
+void NETLIST_OBJECT_LIST::buildSheetConnectionsJob( std::vector<NETLIST_OBJECT_LIST>* aSheets,
+                                                    unsigned aSheet )
+{
+    (*aSheets)[aSheet].buildSheetConnections();
+}
+
+
 /* the master function of NETLIST_OBJECT_LIST class.
  * Build the list of connected objects (pins, labels ...) and
  * all info needed to generate netlists or run ERC diags
@@ -128,17 +364,17 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     s_NetObjectslist.SetOwner( true );
     s_NetObjectslist.FreeList();
 
-    SCH_SHEET_PATH* sheet;
+    // Phase 1: fill lists with connected items of each sheet of the flattened sheet
+    // list, sheets are independent so this is done concurrently
+    std::vector<SHEET_ITEMS> sheetItems( aSheets.GetCount() );
 
-    // Fill list with connected items from the flattened sheet list
-    for( sheet = aSheets.GetFirst(); sheet != NULL;
-         sheet = aSheets.GetNext() )
-    {
-        for( SCH_ITEM* item = sheet->LastScreen()->GetDrawItems(); item; item = item->Next() )
-        {
-            item->GetNetListItem( *this, sheet );
-        }
-    }
+    for( unsigned ii = 0; ii < sheetItems.size(); ii++ )
+        sheetItems[ii].m_Sheet = aSheets.GetSheet( ii );
+
+    ParallelFor( sheetItems.size(), boost::bind( getSheetNetListItems, &sheetItems, _1 ) );
+
+    for( unsigned ii = 0; ii < sheetItems.size(); ii++ )
+        insert( end(), sheetItems[ii].m_Items.begin(), sheetItems[ii].m_Items.end() );
 
     if( size() == 0 )
         return false;
@@ -146,106 +382,52 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     // Sort objects by Sheet
     SortListbySheet();
 
-    sheet = &(GetItem( 0 )->m_SheetPath);
-    m_lastNetCode = m_lastBusNetCode = 1;
+    // Phase 2: connect items inside each sheet, concurrently. Each sheet numbers
+    // its nets from 1.
+    std::vector<NETLIST_OBJECT_LIST> sheetLists;
 
-    for( unsigned ii = 0, istart = 0; ii < size(); ii++ )
+    for( unsigned ii = 0, istart = 0; ii <= size(); ii++ )
     {
-        NETLIST_OBJECT* net_item = GetItem( ii );
-
-        if( net_item->m_SheetPath != *sheet )   // Sheet change
+        if( ii == size() || GetItem( ii )->m_SheetPath != GetItem( istart )->m_SheetPath )
         {
-            sheet  = &(net_item->m_SheetPath);
+            sheetLists.push_back( NETLIST_OBJECT_LIST() );
+            sheetLists.back().assign( begin() + istart, begin() + ii );
             istart = ii;
         }
+    }
 
-        switch( net_item->m_Type )
-        {
-        case NET_ITEM_UNSPECIFIED:
-            wxMessageBox( wxT( "BuildNetListBase() error" ) );
-            break;
-
-        case NET_PIN:
-        case NET_PINLABEL:
-        case NET_SHEETLABEL:
-        case NET_NOCONNECT:
-            if( net_item->GetNet() != 0 )
-                break;
-
-        case NET_SEGMENT:
-            // Test connections point to point type without bus.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
-
-            pointToPointConnect( net_item, IS_WIRE, istart );
-            break;
-
-        case NET_JUNCTION:
-            // Control of the junction outside BUS.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
-
-            segmentToPointConnect( net_item, IS_WIRE, istart );
-
-            /* Control of the junction, on BUS. */
-            if( net_item->m_BusNetCode == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
-
-            segmentToPointConnect( net_item, IS_BUS, istart );
-            break;
-
-        case NET_LABEL:
-        case NET_HIERLABEL:
-        case NET_GLOBLABEL:
-            // Test connections type junction without bus.
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
-
-            segmentToPointConnect( net_item, IS_WIRE, istart );
-            break;
+    ParallelFor( sheetLists.size(), boost::bind( buildSheetConnectionsJob, &sheetLists, _1 ) );
 
-        case NET_SHEETBUSLABELMEMBER:
-            if( net_item->m_BusNetCode != 0 )
-                break;
+    // Phase 3 (serial): give each sheet its own range of net codes, in list order, so
+    // codes are the same as if all sheets were connected one after the other.
+    m_lastNetCode = m_lastBusNetCode = 1;
+    m_netCodes.Clear();
+    m_busNetCodes.Clear();
 
-        case NET_BUS:
-            /* Control type connections point to point mode bus */
-            if( net_item->m_BusNetCode == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
+    bool success = true;
 
-            pointToPointConnect( net_item, IS_BUS, istart );
-            break;
+    for( unsigned ii = 0; ii < sheetLists.size(); ii++ )
+    {
+        NETLIST_OBJECT_LIST& sheetList = sheetLists[ii];
 
-        case NET_BUSLABELMEMBER:
-        case NET_HIERBUSLABELMEMBER:
-        case NET_GLOBBUSLABELMEMBER:
-            /* Control connections similar has on BUS */
-            if( net_item->GetNet() == 0 )
-            {
-                net_item->m_BusNetCode = m_lastBusNetCode;
-                m_lastBusNetCode++;
-            }
+        for( unsigned jj = 0; jj < sheetList.size(); jj++ )
+        {
+            NETLIST_OBJECT* item = sheetList.GetItem( jj );
+            int             net = sheetList.getNet( item );
+            int             busNet = sheetList.getBusNet( item );
 
-            segmentToPointConnect( net_item, IS_BUS, istart );
-            break;
+            item->SetNet( net ? net + m_lastNetCode - 1 : 0 );
+            item->m_BusNetCode = busNet ? busNet + m_lastBusNetCode - 1 : 0;
         }
+
+        m_lastNetCode += sheetList.m_lastNetCode - 1;
+        m_lastBusNetCode += sheetList.m_lastBusNetCode - 1;
+        success &= sheetList.m_connectionsValid;
     }
 
+    if( !success )
+        wxMessageBox( wxT( "BuildNetListBase() error" ) );
+
 #if defined(NETLIST_DEBUG) && defined(DEBUG)
     std::cout << "\n\nafter sheet local\n\n";
     DumpNetTable();
@@ -254,6 +436,8 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     /* Updating the Bus Labels Netcode connected by Bus */
     connectBusLabels();
 
+    LABEL_NAME_INDEX labels( *this );
+
     /* Group objects by label. */
     for( unsigned ii = 0; ii < size(); ii++ )
     {
@@ -272,7 +456,7 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
         case NET_PINLABEL:
         case NET_BUSLABELMEMBER:
         case NET_GLOBBUSLABELMEMBER:
-            labelConnect( GetItem( ii ) );
+            labelConnect( GetItem( ii ), labels );
             break;
 
         case NET_SHEETBUSLABELMEMBER:
@@ -295,9 +479,21 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     {
         if( GetItem( ii )->m_Type == NET_SHEETLABEL
             || GetItem( ii )->m_Type == NET_SHEETBUSLABELMEMBER )
-            sheetLabelConnect( GetItem( ii ) );
+            sheetLabelConnect( GetItem( ii ), labels );
+    }
+
+    // Give each item the code of the net it has been merged into
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* item = GetItem( ii );
+
+        item->SetNet( getNet( item ) );
+        item->m_BusNetCode = getBusNet( item );
     }
 
+    m_netCodes.Clear();
+    m_busNetCodes.Clear();
+
     // Sort objects by NetCode
     SortListbyNetcode();
 
@@ -330,6 +526,116 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     return true;
 }
 
+/*
+ * Connect the items of a list holding the items of a single sheet
+ */
+void NETLIST_OBJECT_LIST::buildSheetConnections()
+{
+    bool success = true;
+
+    m_lastNetCode = m_lastBusNetCode = 1;
+    m_netCodes.Clear();
+    m_busNetCodes.Clear();
+
+    // Items of the sheet, by position
+    SHEET_CONNECTION_INDEX sheetIndex;
+    sheetIndex.Build( *this, 0, size() );
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* net_item = GetItem( ii );
+
+        switch( net_item->m_Type )
+        {
+        case NET_ITEM_UNSPECIFIED:
+            success = false;
+            break;
+
+        case NET_PIN:
+        case NET_PINLABEL:
+        case NET_SHEETLABEL:
+        case NET_NOCONNECT:
+            if( getNet( net_item ) != 0 )
+                break;
+
+        case NET_SEGMENT:
+            // Test connections point to point type without bus.
+            if( getNet( net_item ) == 0 )
+            {
+                net_item->SetNet( m_lastNetCode );
+                m_lastNetCode++;
+            }
+
+            pointToPointConnect( net_item, IS_WIRE, sheetIndex );
+            break;
+
+        case NET_JUNCTION:
+            // Control of the junction outside BUS.
+            if( getNet( net_item ) == 0 )
+            {
+                net_item->SetNet( m_lastNetCode );
+                m_lastNetCode++;
+            }
+
+            segmentToPointConnect( net_item, IS_WIRE, sheetIndex );
+
+            /* Control of the junction, on BUS. */
+            if( getBusNet( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
+            }
+
+            segmentToPointConnect( net_item, IS_BUS, sheetIndex );
+            break;
+
+        case NET_LABEL:
+        case NET_HIERLABEL:
+        case NET_GLOBLABEL:
+            // Test connections type junction without bus.
+            if( getNet( net_item ) == 0 )
+            {
+                net_item->SetNet( m_lastNetCode );
+                m_lastNetCode++;
+            }
+
+            segmentToPointConnect( net_item, IS_WIRE, sheetIndex );
+            break;
+
+        case NET_SHEETBUSLABELMEMBER:
+            if( getBusNet( net_item ) != 0 )
+                break;
+
+        case NET_BUS:
+            /* Control type connections point to point mode bus */
+            if( getBusNet( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
+            }
+
+            pointToPointConnect( net_item, IS_BUS, sheetIndex );
+            break;
+
+        case NET_BUSLABELMEMBER:
+        case NET_HIERBUSLABELMEMBER:
+        case NET_GLOBBUSLABELMEMBER:
+            /* Control connections similar has on BUS */
+            if( getNet( net_item ) == 0 )
+            {
+                net_item->m_BusNetCode = m_lastBusNetCode;
+                m_lastBusNetCode++;
+            }
+
+            segmentToPointConnect( net_item, IS_BUS, sheetIndex );
+            break;
+        }
+    }
+
+    m_connectionsValid = success;
+}
+
+
 // Helper function to give a priority to sort labels:
 // NET_PINLABEL and NET_GLOBLABEL are global labels
 // and the priority is hight
@@ -542,14 +848,18 @@ void NETLIST_OBJECT_LIST::findBestNetNameForEachNet()
  * Propagate net codes from a parent sheet to an include sheet,
  * from a pin sheet connection
  */
-void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
+void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel,
+                                             LABEL_NAME_INDEX& aLabels )
 {
-    if( SheetLabel->GetNet() == 0 )
+    if( getNet( SheetLabel ) == 0 )
         return;
 
-    for( unsigned ii = 0; ii < size(); ii++ )
+    // Only labels having the same name can be connected
+    const std::vector<NETLIST_OBJECT*>& candidates = aLabels.GetLabels( SheetLabel->m_Label );
+
+    for( unsigned ii = 0; ii < candidates.size(); ii++ )
     {
-        NETLIST_OBJECT* ObjetNet = GetItem( ii );
+        NETLIST_OBJECT* ObjetNet = candidates[ii];
 
         if( ObjetNet->m_SheetPath != SheetLabel->m_SheetPathInclude )
             continue;  //use SheetInclude, not the sheet!!
@@ -557,17 +867,17 @@ void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
         if( (ObjetNet->m_Type != NET_HIERLABEL ) && (ObjetNet->m_Type != NET_HIERBUSLABELMEMBER ) )
             continue;
 
-        if( ObjetNet->GetNet() == SheetLabel->GetNet() )
+        if( getNet( ObjetNet ) == getNet( SheetLabel ) )
             continue;  //already connected.
 
         if( ObjetNet->m_Label.CmpNoCase( SheetLabel->m_Label ) != 0 )
             continue;  //different names.
 
         // Propagate Netcode having all the objects of the same Netcode.
-        if( ObjetNet->GetNet() )
-            propageNetCode( ObjetNet->GetNet(), SheetLabel->GetNet(), IS_WIRE );
+        if( getNet( ObjetNet ) )
+            propageNetCode( getNet( ObjetNet ), getNet( SheetLabel ), IS_WIRE );
         else
-            ObjetNet->SetNet( SheetLabel->GetNet() );
+            ObjetNet->SetNet( getNet( SheetLabel ) );
     }
 }
 
@@ -581,6 +891,24 @@ void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
  */
 void NETLIST_OBJECT_LIST::connectBusLabels()
 {
+    // Bus member labels grouped by bus net code and member number, in list order
+    typedef std::pair<int, int> BUS_MEMBER;
+    typedef boost::unordered_map<BUS_MEMBER, std::vector<NETLIST_OBJECT*> > BUS_MEMBER_MAP;
+
+    BUS_MEMBER_MAP busMembers;
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        NETLIST_OBJECT* Label = GetItem( ii );
+
+        if(  (Label->m_Type == NET_SHEETBUSLABELMEMBER)
+          || (Label->m_Type == NET_BUSLABELMEMBER)
+          || (Label->m_Type == NET_HIERBUSLABELMEMBER) )
+        {
+            busMembers[ BUS_MEMBER( getBusNet( Label ), Label->m_Member ) ].push_back( Label );
+        }
+    }
+
     for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* Label = GetItem( ii );
@@ -589,30 +917,27 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
           || (Label->m_Type == NET_BUSLABELMEMBER)
           || (Label->m_Type == NET_HIERBUSLABELMEMBER) )
         {
-            if( Label->GetNet() == 0 )
+            if( getNet( Label ) == 0 )
             {
                 Label->SetNet( m_lastNetCode );
                 m_lastNetCode++;
             }
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
-                if( (LabelInTst->m_Type == NET_SHEETBUSLABELMEMBER)
-                   || (LabelInTst->m_Type == NET_BUSLABELMEMBER)
-                   || (LabelInTst->m_Type == NET_HIERBUSLABELMEMBER) )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+            std::vector<NETLIST_OBJECT*>& group =
+                    busMembers[ BUS_MEMBER( getBusNet( Label ), Label->m_Member ) ];
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+            // Only labels after this one in list are tested
+            std::vector<NETLIST_OBJECT*>::iterator it =
+                    std::find( group.begin(), group.end(), Label );
 
-                    if( LabelInTst->GetNet() == 0 )
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        propageNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
+            for( ++it; it != group.end(); ++it )
+            {
+                NETLIST_OBJECT* LabelInTst = *it;
+
+                if( getNet( LabelInTst ) == 0 )
+                    LabelInTst->SetNet( getNet( Label ) );
+                else
+                    propageNetCode( getNet( LabelInTst ), getNet( Label ), IS_WIRE );
             }
         }
     }
@@ -627,29 +952,11 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
  */
 void NETLIST_OBJECT_LIST::propageNetCode( int aOldNetCode, int aNewNetCode, bool aIsBus )
 {
-    if( aOldNetCode == aNewNetCode )
-        return;
-
+    // Items are not modified, getNet() and getBusNet() take merged codes in account
     if( aIsBus == false )    // Propagate NetCode
-    {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* objet = GetItem( jj );
-
-            if( objet->GetNet() == aOldNetCode )
-                objet->SetNet( aNewNetCode );
-        }
-    }
-    else               // Propagate BusNetCode
-    {
-        for( unsigned jj = 0; jj < size(); jj++ )
-        {
-            NETLIST_OBJECT* objet = GetItem( jj );
-
-            if( objet->m_BusNetCode == aOldNetCode )
-                objet->m_BusNetCode = aNewNetCode;
-        }
-    }
+        m_netCodes.Merge( aOldNetCode, aNewNetCode );
+    else                    // Propagate BusNetCode
+        m_busNetCodes.Merge( aOldNetCode, aNewNetCode );
 }
 
 
@@ -667,102 +974,43 @@ void NETLIST_OBJECT_LIST::propageNetCode( int aOldNetCode, int aNewNetCode, bool
  *
  * The Ref object must have a valid Netcode.
  *
- * The list of objects is SUPPOSED class by SheetPath Croissants,
- * And research is done from the start element, 1st element
- * Leaf schema
+ * aIndex holds the items of the Ref sheet
  * (There can be no physical connection between elements of different sheets)
  */
 void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus,
-                                               int start )
+                                               SHEET_CONNECTION_INDEX& aIndex )
 {
-    int netCode;
+    std::vector<NETLIST_OBJECT*> connected;
+
+    // Items found are of the aIsBus kind
+    aIndex.GetConnectedPoints( aRef, aIsBus, connected );
 
     if( aIsBus == false )    // Objects other than BUS and BUSLABELS
     {
-        netCode = aRef->GetNet();
+        int netCode = getNet( aRef );
 
-        for( unsigned i = start; i < size(); i++ )
+        for( unsigned i = 0; i < connected.size(); i++ )
         {
-            NETLIST_OBJECT* item = GetItem( i );
-
-            if( item->m_SheetPath != aRef->m_SheetPath )  //used to be > (why?)
-                continue;
-
-            switch( item->m_Type )
-            {
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_JUNCTION:
-            case NET_NOCONNECT:
-                if( aRef->m_Start == item->m_Start
-                    || aRef->m_Start == item->m_End
-                    || aRef->m_End   == item->m_Start
-                    || aRef->m_End   == item->m_End )
-                {
-                    if( item->GetNet() == 0 )
-                        item->SetNet( netCode );
-                    else
-                        propageNetCode( item->GetNet(), netCode, IS_WIRE );
-                }
-                break;
+            NETLIST_OBJECT* item = connected[i];
 
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_ITEM_UNSPECIFIED:
-                break;
-            }
+            if( getNet( item ) == 0 )
+                item->SetNet( netCode );
+            else
+                propageNetCode( getNet( item ), netCode, IS_WIRE );
         }
     }
     else    /* Object type BUS, BUSLABELS, and junctions. */
     {
-        netCode = aRef->m_BusNetCode;
+        int netCode = getBusNet( aRef );
 
-        for( unsigned i = start; i < size(); i++ )
+        for( unsigned i = 0; i < connected.size(); i++ )
         {
-            NETLIST_OBJECT* item =  GetItem( i );
-
-            if( item->m_SheetPath != aRef->m_SheetPath )
-                continue;
-
-            switch( item->m_Type )
-            {
-            case NET_ITEM_UNSPECIFIED:
-            case NET_SEGMENT:
-            case NET_PIN:
-            case NET_LABEL:
-            case NET_HIERLABEL:
-            case NET_GLOBLABEL:
-            case NET_SHEETLABEL:
-            case NET_PINLABEL:
-            case NET_NOCONNECT:
-                break;
+            NETLIST_OBJECT* item = connected[i];
 
-            case NET_BUS:
-            case NET_BUSLABELMEMBER:
-            case NET_SHEETBUSLABELMEMBER:
-            case NET_HIERBUSLABELMEMBER:
-            case NET_GLOBBUSLABELMEMBER:
-            case NET_JUNCTION:
-                if(  aRef->m_Start == item->m_Start
-                  || aRef->m_Start == item->m_End
-                  || aRef->m_End   == item->m_Start
-                  || aRef->m_End   == item->m_End )
-                {
-                    if( item->m_BusNetCode == 0 )
-                        item->m_BusNetCode = netCode;
-                    else
-                        propageNetCode( item->m_BusNetCode, netCode, IS_BUS );
-                }
-                break;
-            }
+            if( getBusNet( item ) == 0 )
+                item->m_BusNetCode = netCode;
+            else
+                propageNetCode( getBusNet( item ), netCode, IS_BUS );
         }
     }
 }
@@ -772,48 +1020,34 @@ void NETLIST_OBJECT_LIST::pointToPointConnect( NETLIST_OBJECT* aRef, bool aIsBus
  * Search connections betweena junction and segments
  * Propagate the junction net code to objects connected by this junction.
  * The junction must have a valid net code
- * The list of objects is expected sorted by sheets.
- * Search is done from index aIdxStart to the last element of list
+ * aIndex holds the items of the junction sheet
  */
 void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
-                                                bool aIsBus, int aIdxStart )
+                                                bool aIsBus, SHEET_CONNECTION_INDEX& aIndex )
 {
-    for( unsigned i = aIdxStart; i < size(); i++ )
-    {
-        NETLIST_OBJECT* segment = GetItem( i );
+    std::vector<NETLIST_OBJECT*> segments;
 
-        // if different sheets, obviously no physical connection between elements.
-        if( segment->m_SheetPath != aJonction->m_SheetPath )
-            continue;
+    // Wires (or buses) of the junction sheet passing through the junction
+    aIndex.GetSegmentsAt( aJonction->m_Start, aIsBus, segments );
 
+    for( unsigned i = 0; i < segments.size(); i++ )
+    {
+        NETLIST_OBJECT* segment = segments[i];
+
+        // Propagation Netcode has all the objects of the same Netcode.
         if( aIsBus == IS_WIRE )
         {
-            if( segment->m_Type != NET_SEGMENT )
-                continue;
+            if( getNet( segment ) )
+                propageNetCode( getNet( segment ), getNet( aJonction ), aIsBus );
+            else
+                segment->SetNet( getNet( aJonction ) );
         }
         else
         {
-            if( segment->m_Type != NET_BUS )
-                continue;
-        }
-
-        if( IsPointOnSegment( segment->m_Start, segment->m_End, aJonction->m_Start ) )
-        {
-            // Propagation Netcode has all the objects of the same Netcode.
-            if( aIsBus == IS_WIRE )
-            {
-                if( segment->GetNet() )
-                    propageNetCode( segment->GetNet(), aJonction->GetNet(), aIsBus );
-                else
-                    segment->SetNet( aJonction->GetNet() );
-            }
+            if( getBusNet( segment ) )
+                propageNetCode( getBusNet( segment ), getBusNet( aJonction ), aIsBus );
             else
-            {
-                if( segment->m_BusNetCode )
-                    propageNetCode( segment->m_BusNetCode, aJonction->m_BusNetCode, aIsBus );
-                else
-                    segment->m_BusNetCode = aJonction->m_BusNetCode;
-            }
+                segment->m_BusNetCode = getBusNet( aJonction );
         }
     }
 }
@@ -824,16 +1058,19 @@ void NETLIST_OBJECT_LIST::segmentToPointConnect( NETLIST_OBJECT* aJonction,
  * to labels (wires, bus, pins ... ) when 2 labels are equivalents
  * (i.e. group objects connected by labels)
  */
-void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
+void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef, LABEL_NAME_INDEX& aLabels )
 {
-    if( aLabelRef->GetNet() == 0 )
+    if( getNet( aLabelRef ) == 0 )
         return;
 
-    for( unsigned i = 0; i < size(); i++ )
+    // Only labels having the same name can be connected
+    const std::vector<NETLIST_OBJECT*>& candidates = aLabels.GetLabels( aLabelRef->m_Label );
+
+    for( unsigned i = 0; i < candidates.size(); i++ )
     {
-        NETLIST_OBJECT* item = GetItem( i );
+        NETLIST_OBJECT* item = candidates[i];
 
-        if( item->GetNet() == aLabelRef->GetNet() )
+        if( getNet( item ) == getNet( aLabelRef ) )
             continue;
 
         if( item->m_SheetPath != aLabelRef->m_SheetPath )
@@ -858,10 +1095,10 @@ void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
             if( item->m_Label.CmpNoCase( aLabelRef->m_Label ) != 0 )
                 continue;
 
-            if( item->GetNet() )
-                propageNetCode( item->GetNet(), aLabelRef->GetNet(), IS_WIRE );
+            if( getNet( item ) )
+                propageNetCode( getNet( item ), getNet( aLabelRef ), IS_WIRE );
             else
-                item->SetNet( aLabelRef->GetNet() );
+                item->SetNet( getNet( aLabelRef ) );
         }
     }
 }
@@ -165,7 +165,7 @@ bool SCH_BITMAP::Load( LINE_READER& aLine, wxString& aErrorMsg )
 
         if( strnicmp( line, "Data", 4 ) == 0 )
         {
-            m_Image->LoadData( aLine, aErrorMsg );
+            m_Image->ReadData( aLine, aErrorMsg );
         }
 
         if( strnicmp( line, "$EndBitmap", 4 ) == 0 )
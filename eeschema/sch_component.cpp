@@ -34,6 +34,7 @@
 #include <trigo.h>
 #include <kicad_string.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <wxEeschemaStruct.h>
 #include <plot_common.h>
 #include <msgpanel.h>
@@ -1078,8 +1079,7 @@ bool SCH_COMPONENT::Save( FILE* f ) const
 bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
     int         ii;
-    char        name1[256], name2[256],
-                char1[256], char2[256], char3[256];
+    char        name1[256], name2[256];
     int         newfmt = 0;
     char*       ptcar;
     wxString    fieldName;
@@ -1187,11 +1187,21 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
 
         if( line[0] == 'U' )
         {
-            sscanf( line + 1, "%d %d %lX", &m_unit, &m_convert, &m_TimeStamp );
+            LINE_TOKENIZER  tokens( line + 1 );
+            unsigned long   timeStamp;
+
+            tokens.NextInt( m_unit );
+            tokens.NextInt( m_convert );
+
+            if( tokens.NextHex( timeStamp ) )
+                m_TimeStamp = (time_t) timeStamp;
         }
         else if( line[0] == 'P' )
         {
-            sscanf( line + 1, "%d %d", &m_Pos.x, &m_Pos.y );
+            LINE_TOKENIZER tokens( line + 1 );
+
+            tokens.NextInt( m_Pos.x );
+            tokens.NextInt( m_Pos.y );
 
             // Set fields position to a default position (that is the
             // component position.  For existing fields, the real position
@@ -1298,11 +1308,22 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
             }
 
             GetField( fieldNdx )->SetText( fieldText );
-            memset( char3, 0, sizeof(char3) );
-            int x, y, w, attr;
 
-            if( ( ii = sscanf( ptcar, "%s %d %d %d %X %s %s", char1, &x, &y, &w, &attr,
-                               char2, char3 ) ) < 4 )
+            // Format: orientation x y size attributes hjustify vjustify+style
+            LINE_TOKENIZER  tokens( ptcar );
+            char*           orient = tokens.NextToken();
+            int             x, y, w;
+            unsigned long   attr = 0;
+
+            tokens.NextInt( x );
+            tokens.NextInt( y );
+            tokens.NextInt( w );
+            tokens.NextHex( attr );
+
+            char*           hjustStr = tokens.NextToken();
+            char*           vjustStr = tokens.NextToken();
+
+            if( ( ii = tokens.Parsed() ) < 4 )
             {
                 aErrorMsg.Printf( wxT( "Component Field error line %d, aborted" ),
                                   aLine.LineNumber() );
@@ -1310,7 +1331,7 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
             }
 
             GetField( fieldNdx )->SetTextPosition( wxPoint( x, y ) );
-            GetField( fieldNdx )->SetAttributes( attr );
+            GetField( fieldNdx )->SetAttributes( (int) attr );
 
             if( (w == 0 ) || (ii == 4) )
                 w = DEFAULT_SIZE_TEXT;
@@ -1318,23 +1339,23 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
             GetField( fieldNdx )->SetSize( wxSize( w, w ) );
             GetField( fieldNdx )->SetOrientation( TEXT_ORIENT_HORIZ );
 
-            if( char1[0] == 'V' )
+            if( orient[0] == 'V' )
                 GetField( fieldNdx )->SetOrientation( TEXT_ORIENT_VERT );
 
             if( ii >= 7 )
             {
-                if( *char2 == 'L' )
+                if( *hjustStr == 'L' )
                     hjustify = GR_TEXT_HJUSTIFY_LEFT;
-                else if( *char2 == 'R' )
+                else if( *hjustStr == 'R' )
                     hjustify = GR_TEXT_HJUSTIFY_RIGHT;
 
-                if( char3[0] == 'B' )
+                if( vjustStr[0] == 'B' )
                     vjustify = GR_TEXT_VJUSTIFY_BOTTOM;
-                else if( char3[0] == 'T' )
+                else if( vjustStr[0] == 'T' )
                     vjustify = GR_TEXT_VJUSTIFY_TOP;
 
-                GetField( fieldNdx )->SetItalic( char3[1] == 'I' );
-                GetField( fieldNdx )->SetBold( char3[2] == 'B' );
+                GetField( fieldNdx )->SetItalic( vjustStr[1] == 'I' );
+                GetField( fieldNdx )->SetBold( vjustStr[1] && vjustStr[2] == 'B' );
                 GetField( fieldNdx )->SetHorizJustify( hjustify );
                 GetField( fieldNdx )->SetVertJustify( vjustify );
             }
@@ -1349,19 +1370,34 @@ bool SCH_COMPONENT::Load( LINE_READER& aLine, wxString& aErrorMsg )
         }
     }
 
-    if( sscanf( line, "%d %d %d", &m_unit, &m_Pos.x, &m_Pos.y ) != 3 )
+    LINE_TOKENIZER unitTokens( line );
+
+    unitTokens.NextInt( m_unit );
+    unitTokens.NextInt( m_Pos.x );
+    unitTokens.NextInt( m_Pos.y );
+
+    if( unitTokens.Parsed() != 3 )
     {
         aErrorMsg.Printf( wxT( "Component unit & pos error at line %d, aborted" ),
                           aLine.LineNumber() );
         return false;
     }
 
-    if( !(line = aLine.ReadLine()) ||
-        sscanf( line, "%d %d %d %d",
-                &m_transform.x1,
-                &m_transform.y1,
-                &m_transform.x2,
-                &m_transform.y2 ) != 4 )
+    if( !(line = aLine.ReadLine()) )
+    {
+        aErrorMsg.Printf( wxT( "Component orient error at line %d, aborted" ),
+                          aLine.LineNumber() );
+        return false;
+    }
+
+    LINE_TOKENIZER transformTokens( line );
+
+    transformTokens.NextInt( m_transform.x1 );
+    transformTokens.NextInt( m_transform.y1 );
+    transformTokens.NextInt( m_transform.x2 );
+    transformTokens.NextInt( m_transform.y2 );
+
+    if( transformTokens.Parsed() != 4 )
     {
         aErrorMsg.Printf( wxT( "Component orient error at line %d, aborted" ),
                           aLine.LineNumber() );
@@ -33,6 +33,7 @@
 #include <trigo.h>
 #include <common.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <plot_common.h>
 
 #include <sch_junction.h>
@@ -80,13 +81,18 @@ void SCH_JUNCTION::SwapData( SCH_ITEM* aItem )
 
 bool SCH_JUNCTION::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
-    char name[256];
     char* line = (char*) aLine;
 
     while( (*line != ' ' ) && *line )
         line++;
 
-    if( sscanf( line, "%s %d %d", name, &m_pos.x, &m_pos.y ) != 3 )
+    LINE_TOKENIZER tokens( line );
+
+    tokens.NextToken();
+    tokens.NextInt( m_pos.x );
+    tokens.NextInt( m_pos.y );
+
+    if( tokens.Parsed() != 3 )
     {
         aErrorMsg.Printf( wxT( "Eeschema file connection load error at line %d, aborted" ),
                           aLine.LineNumber() );
@@ -33,6 +33,7 @@
 #include <class_drawpanel.h>
 #include <trigo.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <plot_common.h>
 #include <base_units.h>
 #include <eeschema_config.h>
@@ -169,14 +170,17 @@ bool SCH_LINE::Save( FILE* aFile ) const
 
 bool SCH_LINE::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
-    char  Name1[256];
-    char  Name2[256];
     char* line = (char*) aLine;
 
     while( (*line != ' ' ) && *line )
         line++;
 
-    if( sscanf( line, "%s %s", Name1, Name2 ) != 2  )
+    LINE_TOKENIZER  tokens( line );
+    char*           name1 = tokens.NextToken();
+
+    tokens.NextToken();
+
+    if( tokens.Parsed() != 2 )
     {
         aErrorMsg.Printf( wxT( "Eeschema file segment error at line %d, aborted" ),
                           aLine.LineNumber() );
@@ -186,14 +190,26 @@ bool SCH_LINE::Load( LINE_READER& aLine, wxString& aErrorMsg )
 
     m_Layer = LAYER_NOTES;
 
-    if( Name1[0] == 'W' )
+    if( name1[0] == 'W' )
         m_Layer = LAYER_WIRE;
 
-    if( Name1[0] == 'B' )
+    if( name1[0] == 'B' )
         m_Layer = LAYER_BUS;
 
-    if( !aLine.ReadLine() || sscanf( (char*) aLine, "%d %d %d %d ",
-                                      &m_start.x, &m_start.y, &m_end.x, &m_end.y ) != 4 )
+    bool ok = aLine.ReadLine() != NULL;
+
+    if( ok )
+    {
+        LINE_TOKENIZER coords( (char*) aLine );
+
+        coords.NextInt( m_start.x );
+        coords.NextInt( m_start.y );
+        coords.NextInt( m_end.x );
+        coords.NextInt( m_end.y );
+        ok = coords.Parsed() == 4;
+    }
+
+    if( !ok )
     {
         aErrorMsg.Printf( wxT( "Eeschema file Segment struct error at line %d, aborted" ),
                           aLine.LineNumber() );
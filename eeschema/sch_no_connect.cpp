@@ -34,6 +34,7 @@
 #include <common.h>
 #include <trigo.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <plot_common.h>
 
 #include <general.h>
@@ -98,13 +99,18 @@ bool SCH_NO_CONNECT::Save( FILE* aFile ) const
 
 bool SCH_NO_CONNECT::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
-    char name[256];
     char* line = (char*) aLine;
 
     while( (*line != ' ' ) && *line )
         line++;
 
-    if( sscanf( line, "%s %d %d", name, &m_pos.x, &m_pos.y ) != 3 )
+    LINE_TOKENIZER tokens( line );
+
+    tokens.NextToken();
+    tokens.NextInt( m_pos.x );
+    tokens.NextInt( m_pos.y );
+
+    if( tokens.Parsed() != 3 )
     {
         aErrorMsg.Printf( wxT( "Eeschema file No Connect load error at line %d" ),
                           aLine.LineNumber() );
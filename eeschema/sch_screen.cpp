@@ -53,6 +53,8 @@
 #include <sch_text.h>
 #include <lib_pin.h>
 
+#include <geometry/rtree.h>
+
 #include <boost/foreach.hpp>
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
@@ -161,9 +163,44 @@ void SCH_SCREEN::FreeDrawList()
 }
 
 
+void SCH_SCREEN::Append( SCH_ITEM* aItem )
+{
+    bool indexed = m_itemIndex.IsUpToDate( m_drawList );
+
+    m_drawList.Append( aItem );
+
+    if( indexed )
+        m_itemIndex.Add( aItem, m_drawList );
+}
+
+
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    bool indexed = m_itemIndex.IsUpToDate( m_drawList );
+
     m_drawList.Remove( aItem );
+
+    if( indexed )
+        m_itemIndex.Remove( aItem, m_drawList );
+}
+
+
+SCH_SCREEN_INDEX& SCH_SCREEN::getIndex() const
+{
+    if( !m_itemIndex.IsUpToDate( m_drawList ) )
+        m_itemIndex.Build( m_drawList );
+
+    return m_itemIndex;
+}
+
+
+void SCH_SCREEN::itemsAt( const wxPoint& aPosition, int aAccuracy,
+                          std::vector< SCH_ITEM* >& aItems ) const
+{
+    EDA_RECT area( aPosition, wxSize( 0, 0 ) );
+
+    area.Inflate( aAccuracy );
+    getIndex().Query( area, aItems );
 }
 
 
@@ -208,8 +245,14 @@ bool SCH_SCREEN::CheckIfOnDrawList( SCH_ITEM* aItem )
 
 SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    std::vector< SCH_ITEM* > items;
+
+    itemsAt( aPosition, aAccuracy, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
+        SCH_ITEM* item = items[ii];
+
         if( item->HitTest( aPosition, aAccuracy ) && (aType == NOT_USED) )
             return item;
 
@@ -617,16 +660,18 @@ void SCH_SCREEN::ClearDrawingState()
 LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponent,
                              bool aEndPointOnly ) const
 {
-    SCH_ITEM* item;
     SCH_COMPONENT* component = NULL;
     LIB_PIN* pin = NULL;
+    std::vector< SCH_ITEM* > items;
 
-    for( item = m_drawList.begin(); item != NULL; item = item->Next() )
+    itemsAt( aPosition, 0, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
-        if( item->Type() != SCH_COMPONENT_T )
+        if( items[ii]->Type() != SCH_COMPONENT_T )
             continue;
 
-        component = (SCH_COMPONENT*) item;
+        component = (SCH_COMPONENT*) items[ii];
 
         if( aEndPointOnly )
         {
@@ -689,13 +734,16 @@ SCH_SHEET* SCH_SCREEN::GetSheet( const wxString& aName )
 SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = NULL;
+    std::vector< SCH_ITEM* > items;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    itemsAt( aPosition, 0, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
-        if( item->Type() != SCH_SHEET_T )
+        if( items[ii]->Type() != SCH_SHEET_T )
             continue;
 
-        SCH_SHEET* sheet = (SCH_SHEET*) item;
+        SCH_SHEET* sheet = (SCH_SHEET*) items[ii];
         sheetPin = sheet->GetPin( aPosition );
 
         if( sheetPin )
@@ -708,15 +756,17 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 
 int SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions ) const
 {
-    SCH_ITEM* item;
     int       count = 0;
+    std::vector< SCH_ITEM* > items;
 
-    for( item = m_drawList.begin(); item != NULL; item = item->Next() )
+    itemsAt( aPos, 0, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
-        if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
+        if( items[ii]->Type() == SCH_JUNCTION_T  && !aTestJunctions )
             continue;
 
-        if( item->IsConnected( aPos ) )
+        if( items[ii]->IsConnected( aPos ) )
             count++;
     }
 
@@ -903,18 +953,141 @@ int SCH_SCREEN::UpdatePickList()
 }
 
 
+/**
+ * Class END_POINT_VISITOR
+ * collects the indices of the connection points found by an R-tree search.
+ */
+class END_POINT_VISITOR
+{
+public:
+    END_POINT_VISITOR( std::vector< unsigned >& aResult ) :
+        m_result( aResult )
+    {
+    }
+
+    bool operator()( unsigned aIndex )
+    {
+        m_result.push_back( aIndex );
+
+        return true;
+    }
+
+private:
+    std::vector< unsigned >& m_result;
+};
+
+
+/**
+ * Class END_POINT_INDEX
+ * finds the connection points of a screen close to the connection points of an item, so
+ * TestDanglingEnds() does not test every item against every connection point.
+ *
+ * Wire and bus start points are indexed by the area of their segment, because labels are
+ * connected anywhere on a wire or bus.
+ */
+class END_POINT_INDEX
+{
+public:
+    END_POINT_INDEX( const std::vector< DANGLING_END_ITEM >& aEndPoints ) :
+        m_endPoints( aEndPoints )
+    {
+        for( unsigned ii = 0; ii < m_endPoints.size(); ii++ )
+        {
+            EDA_RECT area( m_endPoints[ii].GetPosition(), wxSize( 0, 0 ) );
+
+            if( isSegmentStart( ii ) )
+                area.SetEnd( m_endPoints[ii + 1].GetPosition() );
+
+            area.Normalize();
+
+            const int mmin[2] = { area.GetX(), area.GetY() };
+            const int mmax[2] = { area.GetRight(), area.GetBottom() };
+
+            m_tree.Insert( mmin, mmax, ii );
+        }
+    }
+
+    /**
+     * Function Query
+     * fills \a aResult with the connection points which can touch the area covered by
+     * the connection points \a aFirst to \a aLast - 1, in the same order as the full list.
+     * Segment start points are always followed by their end point.
+     */
+    void Query( unsigned aFirst, unsigned aLast, std::vector< DANGLING_END_ITEM >& aResult )
+    {
+        aResult.clear();
+
+        if( aFirst >= aLast )
+            return;
+
+        EDA_RECT area( m_endPoints[aFirst].GetPosition(), wxSize( 0, 0 ) );
+
+        for( unsigned ii = aFirst + 1; ii < aLast; ii++ )
+            area.Merge( m_endPoints[ii].GetPosition() );
+
+        const int mmin[2] = { area.GetX(), area.GetY() };
+        const int mmax[2] = { area.GetRight(), area.GetBottom() };
+
+        END_POINT_VISITOR visitor( m_found );
+
+        m_found.clear();
+        m_tree.Search( mmin, mmax, visitor );
+
+        unsigned count = m_found.size();
+
+        for( unsigned ii = 0; ii < count; ii++ )
+        {
+            if( isSegmentStart( m_found[ii] ) )
+                m_found.push_back( m_found[ii] + 1 );
+        }
+
+        std::sort( m_found.begin(), m_found.end() );
+        m_found.erase( std::unique( m_found.begin(), m_found.end() ), m_found.end() );
+
+        for( unsigned ii = 0; ii < m_found.size(); ii++ )
+            aResult.push_back( m_endPoints[ m_found[ii] ] );
+    }
+
+private:
+    bool isSegmentStart( unsigned aIndex ) const
+    {
+        DANGLING_END_T type = m_endPoints[aIndex].GetType();
+
+        return ( type == WIRE_START_END || type == BUS_START_END )
+               && aIndex + 1 < m_endPoints.size();
+    }
+
+    const std::vector< DANGLING_END_ITEM >& m_endPoints;
+    RTree<unsigned, int, 2, float>          m_tree;
+    std::vector< unsigned >                 m_found;
+};
+
+
 bool SCH_SCREEN::TestDanglingEnds( EDA_DRAW_PANEL* aCanvas, wxDC* aDC )
 {
     SCH_ITEM* item;
     std::vector< DANGLING_END_ITEM > endPoints;
+    std::vector< unsigned > firstEndPoint;      // Index of the first end point of each item
     bool hasDanglingEnds = false;
 
     for( item = m_drawList.begin(); item != NULL; item = item->Next() )
+    {
+        firstEndPoint.push_back( endPoints.size() );
         item->GetEndPoints( endPoints );
+    }
+
+    firstEndPoint.push_back( endPoints.size() );
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    END_POINT_INDEX index( endPoints );
+    std::vector< DANGLING_END_ITEM > nearEndPoints;
+    unsigned ii = 0;
+
+    for( item = m_drawList.begin(); item; item = item->Next(), ii++ )
     {
-        if( item->IsDanglingStateChanged( endPoints ) && ( aCanvas != NULL ) && ( aDC != NULL ) )
+        index.Query( firstEndPoint[ii], firstEndPoint[ii + 1], nearEndPoints );
+
+        if( item->IsDanglingStateChanged( nearEndPoints )
+            && ( aCanvas != NULL ) && ( aDC != NULL ) )
         {
             item->Draw( aCanvas, aDC, wxPoint( 0, 0 ), g_XorMode );
             item->Draw( aCanvas, aDC, wxPoint( 0, 0 ), GR_DEFAULT_DRAWMODE );
@@ -988,8 +1161,14 @@ bool SCH_SCREEN::BreakSegmentsOnJunctions()
 
 int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    std::vector< SCH_ITEM* > items;
+
+    itemsAt( aPosition, 0, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
+        SCH_ITEM* item = items[ii];
+
         if( item->Type() == SCH_LINE_T && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
         {
@@ -1007,8 +1186,14 @@ int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 
 SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    std::vector< SCH_ITEM* > items;
+
+    itemsAt( aPosition, 0, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
+        SCH_ITEM* item = items[ii];
+
         if( (item->Type() == SCH_LINE_T) && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
         {
@@ -1023,8 +1208,14 @@ SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    std::vector< SCH_ITEM* > items;
+
+    itemsAt( aPosition, aAccuracy, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
+        SCH_ITEM* item = items[ii];
+
         if( item->Type() != SCH_LINE_T )
             continue;
 
@@ -1056,8 +1247,14 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
 
 SCH_TEXT* SCH_SCREEN::GetLabel( const wxPoint& aPosition, int aAccuracy )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item != NULL; item = item->Next() )
+    std::vector< SCH_ITEM* > items;
+
+    itemsAt( aPosition, aAccuracy, items );
+
+    for( unsigned ii = 0; ii < items.size(); ii++ )
     {
+        SCH_ITEM* item = items[ii];
+
         switch( item->Type() )
         {
         case SCH_LABEL_T:
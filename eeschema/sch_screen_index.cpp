@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_screen_index.cpp
+ * @brief Spatial index of the draw items of a SCH_SCREEN used by schematic hit-testing.
+ */
+
+#include <fctsys.h>
+#include <algorithm>
+
+#include <general.h>
+#include <sch_item_struct.h>
+#include <sch_sheet.h>
+
+#include <sch_screen_index.h>
+
+
+/**
+ * Class QUERY_VISITOR
+ * collects items found by an R-tree search.
+ */
+class QUERY_VISITOR
+{
+public:
+    QUERY_VISITOR( std::vector<SCH_ITEM*>& aResult ) :
+        m_result( aResult )
+    {
+    }
+
+    bool operator()( SCH_ITEM* aItem )
+    {
+        m_result.push_back( aItem );
+
+        return true;
+    }
+
+private:
+    std::vector<SCH_ITEM*>& m_result;
+};
+
+
+SCH_SCREEN_INDEX::SCH_SCREEN_INDEX() :
+    m_valid( false ), m_stamp( 0 ), m_nextRank( 0 )
+{
+}
+
+
+void SCH_SCREEN_INDEX::Build( const DLIST<SCH_ITEM>& aList )
+{
+    clear();
+
+    for( SCH_ITEM* item = aList.begin(); item; item = item->Next() )
+        insert( item );
+
+    m_stamp = aList.GetChangeCount();
+    m_valid = true;
+}
+
+
+void SCH_SCREEN_INDEX::Add( SCH_ITEM* aItem, const DLIST<SCH_ITEM>& aList )
+{
+    insert( aItem );
+    m_stamp = aList.GetChangeCount();
+}
+
+
+void SCH_SCREEN_INDEX::Remove( SCH_ITEM* aItem, const DLIST<SCH_ITEM>& aList )
+{
+    ENTRIES::iterator it = m_entries.find( aItem );
+
+    if( it != m_entries.end() )
+    {
+        const EDA_RECT& bbox = it->second.bbox;
+        const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        m_tree.Remove( mmin, mmax, aItem );
+        m_entries.erase( it );
+    }
+
+    m_stamp = aList.GetChangeCount();
+}
+
+
+void SCH_SCREEN_INDEX::Query( const EDA_RECT& aArea, std::vector<SCH_ITEM*>& aResult )
+{
+    EDA_RECT               area = aArea;
+    area.Normalize();
+
+    const int              mmin[2] = { area.GetX(), area.GetY() };
+    const int              mmax[2] = { area.GetRight(), area.GetBottom() };
+    std::vector<SCH_ITEM*> found;
+    QUERY_VISITOR          visitor( found );
+
+    m_tree.Search( mmin, mmax, visitor );
+
+    // Callers expect the first item of the draw list matching their criteria
+    std::vector< std::pair<unsigned, SCH_ITEM*> > ranked;
+    ranked.reserve( found.size() );
+
+    for( unsigned ii = 0; ii < found.size(); ii++ )
+        ranked.push_back( std::make_pair( m_entries[ found[ii] ].rank, found[ii] ) );
+
+    std::sort( ranked.begin(), ranked.end() );
+
+    for( unsigned ii = 0; ii < ranked.size(); ii++ )
+        aResult.push_back( ranked[ii].second );
+}
+
+
+void SCH_SCREEN_INDEX::clear()
+{
+    m_tree.RemoveAll();
+    m_entries.clear();
+    m_nextRank = 0;
+
+    m_valid = false;
+}
+
+
+EDA_RECT SCH_SCREEN_INDEX::itemBBox( const SCH_ITEM* aItem )
+{
+    EDA_RECT bbox = aItem->GetBoundingBox();
+
+    // Sheet pins stick out of the sheet
+    if( aItem->Type() == SCH_SHEET_T )
+    {
+        const SCH_SHEET* sheet = static_cast<const SCH_SHEET*>( aItem );
+
+        BOOST_FOREACH( const SCH_SHEET_PIN& pin, sheet->GetPins() )
+            bbox.Merge( pin.GetBoundingBox() );
+    }
+
+    bbox.Normalize();
+
+    // Some items (no connects) are hit-tested a pen width away from their bounding box
+    bbox.Inflate( std::max( GetDefaultLineThickness(), 1 ) );
+
+    return bbox;
+}
+
+
+void SCH_SCREEN_INDEX::insert( SCH_ITEM* aItem )
+{
+    if( m_entries.count( aItem ) )
+        return;
+
+    ENTRY entry;
+    entry.bbox = itemBBox( aItem );
+    entry.rank = m_nextRank++;
+
+    const int mmin[2] = { entry.bbox.GetX(), entry.bbox.GetY() };
+    const int mmax[2] = { entry.bbox.GetRight(), entry.bbox.GetBottom() };
+
+    m_tree.Insert( mmin, mmax, aItem );
+    m_entries[aItem] = entry;
+}
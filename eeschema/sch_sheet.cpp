@@ -754,38 +754,56 @@ bool SCH_SHEET::Load( SCH_EDIT_FRAME* aFrame )
 {
     bool success = true;
 
-    if( !m_screen )
+    // The hierarchy is loaded one level at a time: the files of the sheets of a level
+    // are independent, and are read concurrently.
+    std::vector<SCH_SHEET*> level( 1, this );
+
+    while( !level.empty() )
     {
-        SCH_SCREEN* screen = NULL;
-        g_RootSheet->SearchHierarchy( m_fileName, &screen );
+        std::vector<SCH_SHEET*>     loaded;
+        std::vector<SCH_SCREEN*>    screens;
+        wxArrayString               fileNames;
 
-        if( screen )
+        for( unsigned ii = 0; ii < level.size(); ii++ )
         {
-            SetScreen( screen );
+            SCH_SHEET*  sheet = level[ii];
+            SCH_SCREEN* screen = NULL;
 
-            //do not need to load the sub-sheets - this has already been done.
-        }
-        else
-        {
-            SetScreen( new SCH_SCREEN() );
-            success = aFrame->LoadOneEEFile( m_screen, m_fileName );
+            if( sheet->m_screen )
+                continue;
+
+            g_RootSheet->SearchHierarchy( sheet->m_fileName, &screen );
 
-            if( success )
+            if( screen )
             {
-                EDA_ITEM* bs = m_screen->GetDrawItems();
+                sheet->SetScreen( screen );
 
-                while( bs )
-                {
-                    if( bs->Type() ==  SCH_SHEET_T )
-                    {
-                        SCH_SHEET* sheetstruct = (SCH_SHEET*) bs;
+                //do not need to load the sub-sheets - this has already been done.
+                continue;
+            }
 
-                        if( !sheetstruct->Load( aFrame ) )
-                            success = false;
-                    }
+            // The file name is set now, so the next sheets using this file find the screen.
+            screen = new SCH_SCREEN();
+            screen->SetFileName( sheet->m_fileName );
+            sheet->SetScreen( screen );
 
-                    bs = bs->Next();
-                }
+            loaded.push_back( sheet );
+            screens.push_back( screen );
+            fileNames.Add( sheet->m_fileName );
+        }
+
+        if( !aFrame->LoadEEFiles( screens, fileNames ) )
+            success = false;
+
+        level.clear();
+
+        for( unsigned ii = 0; ii < loaded.size(); ii++ )
+        {
+            for( EDA_ITEM* item = loaded[ii]->m_screen->GetDrawItems(); item;
+                 item = item->Next() )
+            {
+                if( item->Type() == SCH_SHEET_T )
+                    level.push_back( (SCH_SHEET*) item );
             }
         }
     }
@@ -34,6 +34,7 @@
 #include <plot_common.h>
 #include <trigo.h>
 #include <richio.h>
+#include <line_tokenizer.h>
 #include <wxEeschemaStruct.h>
 
 #include <general.h>
@@ -263,39 +264,36 @@ bool SCH_SHEET_PIN::Save( FILE* aFile ) const
 bool SCH_SHEET_PIN::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
     int     size;
-    char    number[256];
     char    name[256];
-    char    connectType[256];
-    char    sheetSide[256];
     char*   line = aLine.Line();
-    char*   cp;
-
-    static const char delims[] = " \t";
+    char*   connectType = NULL;
+    char*   sheetSide = NULL;
 
     // Read coordinates.
     // D( printf( "line: \"%s\"\n", line );)
 
-    cp = strtok( line, delims );
-
-    strncpy( number, cp, sizeof(number) );
-    number[sizeof(number)-1] = 0;
+    // Sheets are loaded by several threads, do not use strtok() here.
+    LINE_TOKENIZER tokens( line );
 
-    cp += strlen( number ) + 1;
+    if( tokens.NextToken() )    // the pin number
+    {
+        char* cp = tokens.Position();
 
-    cp += ReadDelimitedText( name, cp, sizeof(name) );
+        cp += ReadDelimitedText( name, cp, sizeof(name) );
 
-    cp = strtok( cp, delims );
-    strncpy( connectType, cp, sizeof(connectType) );
-    connectType[sizeof(connectType)-1] = 0;
+        LINE_TOKENIZER tail( cp );
 
-    cp = strtok( NULL, delims );
-    strncpy( sheetSide, cp, sizeof(sheetSide) );
-    sheetSide[sizeof(sheetSide)-1] = 0;
+        connectType = tail.NextToken();
+        sheetSide   = tail.NextToken();
+        tail.NextInt( m_Pos.x );
+        tail.NextInt( m_Pos.y );
+        tail.NextInt( size );
 
-    cp += strlen( sheetSide ) + 1;
+        if( tail.Parsed() != 5 )
+            connectType = NULL;
+    }
 
-    int r = sscanf( cp, "%d %d %d", &m_Pos.x, &m_Pos.y, &size );
-    if( r != 3 )
+    if( connectType == NULL )
     {
         aErrorMsg.Printf( wxT( "Eeschema file sheet hierarchical label error at line %d.\n" ),
                           aLine.LineNumber() );
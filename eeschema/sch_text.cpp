@@ -412,6 +412,26 @@ bool SCH_TEXT::Save( FILE* aFile ) const
 }
 
 
+/**
+ * Function readTextLine
+ * null terminates the text of \a aLine at its first end of line character, as
+ * strtok( aLine, "\n\r" ) does, but without the hidden state of strtok(): schematic
+ * files are loaded by several threads.
+ * @return char* - the text, or NULL if \a aLine holds no text.
+ */
+static char* readTextLine( char* aLine )
+{
+    char* text = aLine + strspn( aLine, "\n\r" );
+
+    if( *text == 0 )
+        return NULL;
+
+    text[ strcspn( text, "\n\r" ) ] = 0;
+
+    return text;
+}
+
+
 bool SCH_TEXT::Load( LINE_READER& aLine, wxString& aErrorMsg )
 {
     char      Name1[256];
@@ -447,7 +467,7 @@ bool SCH_TEXT::Load( LINE_READER& aLine, wxString& aErrorMsg )
     if( size == 0 )
         size = DEFAULT_SIZE_TEXT;
 
-    char* text = strtok( (char*) aLine, "\n\r" );
+    char* text = readTextLine( (char*) aLine );
 
     if( text == NULL )
     {
@@ -932,7 +952,7 @@ bool SCH_LABEL::Load( LINE_READER& aLine, wxString& aErrorMsg )
     if( size == 0 )
         size = DEFAULT_SIZE_TEXT;
 
-    char* text = strtok( (char*) aLine, "\n\r" );
+    char* text = readTextLine( (char*) aLine );
 
     if( text == NULL )
     {
@@ -1095,7 +1115,7 @@ bool SCH_GLOBALLABEL::Load( LINE_READER& aLine, wxString& aErrorMsg )
     if( size == 0 )
         size = DEFAULT_SIZE_TEXT;
 
-    char* text = strtok( (char*) aLine, "\n\r" );
+    char* text = readTextLine( (char*) aLine );
 
     if( text == NULL )
     {
@@ -1526,7 +1546,7 @@ bool SCH_HIERLABEL::Load( LINE_READER& aLine, wxString& aErrorMsg )
     if( size == 0 )
         size = DEFAULT_SIZE_TEXT;
 
-    char* text = strtok( (char*) aLine, "\n\r" );
+    char* text = readTextLine( (char*) aLine );
 
     if( text == NULL )
     {
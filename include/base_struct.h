@@ -110,6 +110,18 @@ public:
      *          stop the scan, else #SEARCH_CONTINUE;
      */
     virtual SEARCH_RESULT Inspect( EDA_ITEM* aItem, const void* aTestData ) = 0;
+
+    /**
+     * Function GetSearchArea
+     * lets containers holding a spatial index skip the items that cannot match.
+     *
+     * @param aArea is set to the area outside of which Inspect() never matches an item.
+     * @return bool - true if \a aArea has been set, false if all items have to be inspected.
+     */
+    virtual bool GetSearchArea( EDA_RECT& aArea ) const
+    {
+        return false;
+    }
 };
 
 
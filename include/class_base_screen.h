@@ -307,7 +307,14 @@ public:
         return m_RedoList.m_CommandsList.size();
     }
 
-    void SetModify()        { m_FlagModified = true; }
+    /**
+     * Function SetModify
+     * flags the screen as modified.  It is virtual because a screen may have to update
+     * its own data when it is modified, and common code like DIALOG_PAGES_SETTINGS calls
+     * it through a BASE_SCREEN pointer.
+     */
+    virtual void SetModify() { m_FlagModified = true; }
+
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
     void ClrSave()          { m_FlagSave = false; }
@@ -55,6 +55,9 @@ private:
                                     // to internal KiCad units
                                     // Usually does not change
     int       m_ppi;                // the bitmap definition. the default is 300PPI
+    std::string m_pngData;          // png data read by ReadData(), not converted to
+                                    // m_image yet
+    bool      m_pngDataRead;        // true when m_pngData waits for BuildImage()
 
 
 public: BITMAP_BASE( const wxPoint& pos = wxPoint( 0, 0 ) );
@@ -182,6 +185,25 @@ public: BITMAP_BASE( const wxPoint& pos = wxPoint( 0, 0 ) );
      */
     bool     LoadData( LINE_READER& aLine, wxString& aErrorMsg );
 
+    /**
+     * Function ReadData
+     * reads an image data saved by SaveData, like LoadData(), but only keeps the png
+     * data: no wxImage or wxBitmap is created, so it can be called by any thread.
+     * BuildImage() has to be called by the main thread before the image is used.
+     * @param aLine - the LINE_READER used to read the data file.
+     * @param aErrorMsg - Description of the error if an error occurs while reading the
+     *                    png bimap data.
+     * @return true if the png data was read successfully.
+     */
+    bool     ReadData( LINE_READER& aLine, wxString& aErrorMsg );
+
+    /**
+     * Function BuildImage
+     * creates the image and the bitmap from the png data read by ReadData(), if any.
+     * It must be called by the main thread, like anything creating a wxBitmap.
+     */
+    void     BuildImage();
+
 
     /**
      * Function Mirror
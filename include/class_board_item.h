@@ -41,6 +41,9 @@
 #define FMT_IU     BOARD_ITEM::FormatInternalUnits
 #define FMT_ANGLE  BOARD_ITEM::FormatAngle
 
+/// Size of a buffer large enough for any value written by BOARD_ITEM::FormatInternalUnits().
+#define FMT_IU_BUFSIZE  16
+
 class BOARD;
 class EDA_DRAW_PANEL;
 
@@ -80,6 +83,14 @@ class BOARD_ITEM : public EDA_ITEM
 protected:
     LAYER_NUM m_Layer;
 
+    /**
+     * Function updateSpatialIndex
+     * tells the parent board, if any, that the area or the layer of this item changed, so
+     * its lookups by position still find it.  To be called by the setters of the items the
+     * board indexes.
+     */
+    void updateSpatialIndex();
+
 public:
 
     BOARD_ITEM( BOARD_ITEM* aParent, KICAD_T idtype ) :
@@ -121,6 +132,7 @@ public:
         // trap any invalid layers, then go find the caller and fix it.
         // wxASSERT( unsigned( aLayer ) < unsigned( NB_PCB_LAYERS ) );
         m_Layer = aLayer;
+        updateSpatialIndex();
     }
 
     /**
@@ -277,6 +289,27 @@ public:
      */
     static std::string FormatInternalUnits( int aValue );
 
+    /**
+     * Function FormatInternalUnits
+     * writes \a aValue the same way as FormatInternalUnits( int ), but in \a aBuffer
+     * rather than in a new string.
+     *
+     * @param aValue A coordinate value to convert.
+     * @param aBuffer Where to write the null terminated text, at least #FMT_IU_BUFSIZE bytes.
+     * @return int - the length of the text.
+     */
+    static int FormatInternalUnits( int aValue, char* aBuffer );
+
+    /**
+     * Function FormatInternalUnits
+     * writes the coordinates of \a aPoint separated by a space in \a aBuffer.
+     *
+     * @param aPoint A point to convert.
+     * @param aBuffer Where to write the null terminated text, at least 2 * #FMT_IU_BUFSIZE bytes.
+     * @return int - the length of the text.
+     */
+    static int FormatInternalUnits( const wxPoint& aPoint, char* aBuffer );
+
     /**
      * Function FormatAngle
      * converts \a aAngle from board units to a string appropriate for writing to file.
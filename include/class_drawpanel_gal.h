@@ -163,6 +163,10 @@ protected:
 
     /// Processes and forwards events to tools
     TOOL_DISPATCHER*         m_eventDispatcher;
+
+    /// File to save the rendering profile to (if profiling was requested by the
+    /// KICAD_GAL_PROFILE environment variable)
+    wxString                 m_profileFile;
 };
 
 #endif
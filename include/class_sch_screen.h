@@ -35,6 +35,7 @@
 #include <sch_item_struct.h>
 #include <class_base_screen.h>
 #include <class_title_block.h>
+#include <sch_screen_index.h>
 
 #include <../eeschema/general.h>
 
@@ -79,6 +80,22 @@ private:
     DLIST< SCH_ITEM > m_drawList;     ///< Object list for the screen.
                                       /// @todo use DLIST<SCH_ITEM> or superior container
 
+    mutable SCH_SCREEN_INDEX m_itemIndex; ///< Draw list items by position, see getIndex().
+
+    /**
+     * Function getIndex
+     * returns the index of the draw items by position, rebuilt if the draw list has been
+     * modified other than by Append() or Remove() or if SetModify() has been called.
+     */
+    SCH_SCREEN_INDEX& getIndex() const;
+
+    /**
+     * Function itemsAt
+     * appends to \a aItems the draw items whose bounding box is within \a aAccuracy of
+     * \a aPosition, in the draw list order.
+     */
+    void itemsAt( const wxPoint& aPosition, int aAccuracy, std::vector< SCH_ITEM* >& aItems ) const;
+
     /**
      * Function addConnectedItemsToBlock
      * add items connected at \a aPosition to the block pick list.
@@ -131,7 +148,7 @@ public:
      */
     SCH_ITEM* GetDrawItems() const          { return m_drawList.begin(); }
 
-    void Append( SCH_ITEM* aItem )          { m_drawList.Append( aItem ); }
+    void Append( SCH_ITEM* aItem );
 
     /**
      * Function Append
@@ -155,6 +172,28 @@ public:
      */
     void SetCurItem( SCH_ITEM* aItem ) { BASE_SCREEN::SetCurItem( (EDA_ITEM*) aItem ); }
 
+    /**
+     * Function SetModify
+     * flags the screen as modified, overriding BASE_SCREEN::SetModify().  Because items
+     * may have been moved or edited in place, the index of the draw items by position is
+     * rebuilt before the next lookup.
+     */
+    virtual void SetModify()
+    {
+        m_itemIndex.Invalidate();
+        BASE_SCREEN::SetModify();
+    }
+
+    /**
+     * Function InvalidateIndex
+     * has to be called after draw items have been moved, resized or edited without calling
+     * SetModify(), so the index by position is rebuilt before the next lookup.
+     */
+    void InvalidateIndex()
+    {
+        m_itemIndex.Invalidate();
+    }
+
     /**
      * Function Clear
      * deletes all draw items and clears the project settings.
@@ -138,6 +138,8 @@ public:
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
+    size_t      m_memoryUsage;    /* estimated size in bytes of the item copies owned by
+                                   * this command, set by the editor that filled it */
 
 public:
     PICKED_ITEMS_LIST();
@@ -292,6 +294,19 @@ public:
      * @param aSource The list of items to copy to the list.
      */
     void CopyList( const PICKED_ITEMS_LIST& aSource );
+
+    /**
+     * Function SetMemoryUsage
+     * records the estimated size in bytes of the item copies owned by this command.
+     */
+    void SetMemoryUsage( size_t aBytes ) { m_memoryUsage = aBytes; }
+
+    /**
+     * Function GetMemoryUsage
+     * @return The estimated size in bytes of the item copies owned by this command, or 0
+     *         if the editor does not estimate it.
+     */
+    size_t GetMemoryUsage() const { return m_memoryUsage; }
 };
 
 
@@ -315,6 +330,12 @@ public:
     PICKED_ITEMS_LIST* PopCommand();
 
     void ClearCommandList();
+
+    /**
+     * Function GetMemoryUsage
+     * @return The estimated size in bytes of the item copies held by all the commands.
+     */
+    size_t GetMemoryUsage() const;
 };
 
 
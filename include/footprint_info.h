@@ -75,6 +75,25 @@ public:
 #endif
     }
 
+    /**
+     * Constructor
+     * makes an already loaded footprint info, from what a library index tells about the
+     * footprint.
+     */
+    FOOTPRINT_INFO( FOOTPRINT_LIST* aOwner, const wxString& aNickname,
+                    const wxString& aFootprintName, const wxString& aDoc,
+                    const wxString& aKeywords, int aPadCount ) :
+        m_owner( aOwner ),
+        m_loaded( true ),
+        m_nickname( aNickname ),
+        m_fpname( aFootprintName ),
+        m_num( 0 ),
+        m_pad_count( aPadCount ),
+        m_doc( aDoc ),
+        m_keywords( aKeywords )
+    {
+    }
+
     const wxString& GetDoc()
     {
         ensure_loaded();
@@ -172,8 +191,18 @@ class FOOTPRINT_LIST
      *
      * @param aNicknameList is a wxString[] holding libraries to load all footprints from.
      * @param aJobZ is the size of the job, i.e. the count of nicknames.
+     * @param aThreadBudget is the number of threads each library may be read with,
+     *  0 to let the plugins decide.
+     */
+    void loader_job( const wxString* aNicknameList, int aJobZ, unsigned aThreadBudget );
+
+    /**
+     * Function loadFromIndex
+     * fills in the footprints of a KiCad library from its #FP_INFO_INDEX, without
+     * parsing the footprint files.
+     * @return bool - false if the library has no up to date index.
      */
-    void loader_job( const wxString* aNicknameList, int aJobZ );
+    bool loadFromIndex( const wxString& aNickname );
 
     void addItem( FOOTPRINT_INFO* aItem )
     {
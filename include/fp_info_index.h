@@ -0,0 +1,108 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file fp_info_index.h
+ * @brief Summary of the footprints of a *.pretty library, saved in the user's cache.
+ */
+
+#ifndef FP_INFO_INDEX_H_
+#define FP_INFO_INDEX_H_
+
+#include <vector>
+
+#include <wx/string.h>
+#include <wx/datetime.h>
+
+#include <richio.h>
+
+
+/**
+ * Class FP_INFO_INDEX
+ * holds what the footprint browsers show about each footprint of a *.pretty library
+ * directory: its name, description, keywords and pad count, along with the modification
+ * time of its file.
+ *
+ * The index is written when the library is loaded, and lets the footprint lists be filled
+ * without parsing any footprint file, as long as none of them has been added, removed or
+ * modified since.  It is only a cache: it can be missing or outdated, in which case the
+ * library is parsed as usual.  The indexes are kept in the user's cache directory, never
+ * in the library directories, one file per library, named after its path.
+ */
+class FP_INFO_INDEX
+{
+public:
+    ///> Summary of one footprint file
+    struct ENTRY
+    {
+        wxString    m_Name;         ///< Footprint name, i.e. file name without extension
+        wxString    m_Doc;          ///< Footprint description
+        wxString    m_Keywords;     ///< Footprint keywords
+        int         m_PadCount;     ///< Pad count, not including NPTH pads
+        wxDateTime  m_ModTime;      ///< Modification time of the footprint file
+    };
+
+    typedef std::vector<ENTRY>  ENTRIES;
+
+    FP_INFO_INDEX( const wxString& aLibraryPath );
+
+    const ENTRIES& GetEntries() const { return m_entries; }
+
+    /**
+     * Function Add
+     * appends the summary of a footprint file to the index.
+     */
+    void Add( const wxString& aName, const wxString& aDoc, const wxString& aKeywords,
+              int aPadCount, const wxDateTime& aModTime );
+
+    /**
+     * Function Read
+     * reads the cached index of the library and checks it against the footprint files found
+     * in the library directory.
+     * @return bool - true if the index is up to date, false if it is missing, unreadable or
+     *                outdated, in which case the index is left empty.
+     */
+    bool Read();
+
+    /**
+     * Function Write
+     * saves the index in the user's cache directory.
+     * @throw IO_ERROR if the index file cannot be written.
+     */
+    void Write() throw( IO_ERROR );
+
+private:
+    ///> Full path of the index file
+    wxString indexFileName() const;
+
+    ///> Directory of the index files, in the user's cache directory
+    static wxString indexDirectory();
+
+    ///> Checks the entries against the footprint files of the library
+    bool isUpToDate() const;
+
+    wxString    m_lib_path;         ///< Library directory, normalized
+    ENTRIES     m_entries;
+};
+
+#endif  // FP_INFO_INDEX_H_
@@ -370,13 +370,15 @@ public:
      *
      * @param aNickname is a locator for the "library", it is a "name"
      *     in FP_LIB_TABLE::ROW
+     * @param aThreadBudget is the number of threads the plugin may use to read the
+     *     library, or 0 to let it decide, see #PROPERTY_THREAD_BUDGET.
      *
      * @return wxArrayString - is the array of available footprint names inside
      *   a library
      *
      * @throw IO_ERROR if the library cannot be found, or footprint cannot be loaded.
      */
-    wxArrayString FootprintEnumerate( const wxString& aNickname );
+    wxArrayString FootprintEnumerate( const wxString& aNickname, unsigned aThreadBudget = 0 );
 
     /**
      * Function FootprintLoad
@@ -114,6 +114,10 @@ public:
     /// @copydoc GAL::DrawPolyline()
     virtual void DrawPolyline( std::deque<VECTOR2D>& aPointList );
 
+    /// @copydoc GAL::DrawPolylines()
+    virtual void DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                                const std::vector<unsigned int>& aStarts );
+
     /// @copydoc GAL::DrawPolygon()
     virtual void DrawPolygon( const std::deque<VECTOR2D>& aPointList );
 
@@ -131,6 +135,17 @@ public:
     /// @brief Shows/hides the GAL canvas
     virtual bool Show( bool aShow );
 
+    /**
+     * Function SetOffscreen()
+     * In the offscreen mode, the rendered image is kept in the memory buffer and it is not
+     * transferred to the window. It is meant for benchmarking and batch rendering.
+     * @param aOffscreen tells if the offscreen mode should be enabled.
+     */
+    void SetOffscreen( bool aOffscreen )
+    {
+        isOffscreen = aOffscreen;
+    }
+
     /// @copydoc GAL::Flush()
     virtual void Flush();
 
@@ -269,6 +284,7 @@ private:
     unsigned int            overlayBuffer;          ///< Handle to the overlay buffer
     RENDER_TARGET           currentTarget;          ///< Current rendering target
     bool                    validCompositor;        ///< Compositor initialization flag
+    bool                    isOffscreen;            ///< Do not transfer the image to the window
 
     // Variables related to wxWidgets
     wxWindow*               parentWindow;           ///< Parent window
@@ -0,0 +1,205 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file frame_profiler.h
+ * @brief Lightweight per-frame timers and counters for the GAL rendering pipeline.
+ */
+
+#ifndef FRAME_PROFILER_H_
+#define FRAME_PROFILER_H_
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <profile.h>
+
+namespace KIGFX
+{
+/**
+ * Class FRAME_PROFILER
+ * collects timings and counters for the frames rendered by the GAL. Every rendering stage
+ * that wants to be measured creates a FRAME_PROFILER_SCOPE; counters are increased with
+ * AddCount(). Statistics of a limited number of the most recent frames are kept, and they can
+ * be saved as a Chrome trace (chrome://tracing) to see where the time goes.
+ * Profiling is disabled by default and it costs only a flag check until enabled.
+ */
+class FRAME_PROFILER
+{
+public:
+    ///> Counters collected for every frame
+    enum COUNTER
+    {
+        ITEMS_QUERIED,      ///< Items returned by the VIEW R-tree queries
+        ITEMS_DRAWN,        ///< Items drawn by the VIEW
+        ITEMS_CULLED,       ///< Items skipped by the VIEW as too small to be seen
+        GROUPS_CACHED,      ///< Cached groups (re)created
+        BYTES_UPLOADED,     ///< Bytes of vertex data uploaded to the GPU
+
+        COUNTERS_NUMBER
+    };
+
+    ///> Time spent in a single rendering stage
+    struct EVENT
+    {
+        const char* name;   ///< Stage name (has to be a string literal)
+        uint64_t    start;  ///< Start time [us]
+        uint64_t    end;    ///< End time [us]
+        int         depth;  ///< Nesting level of the stage
+    };
+
+    ///> Statistics of a single frame
+    struct FRAME
+    {
+        uint64_t            start;
+        uint64_t            end;
+        int64_t             counters[COUNTERS_NUMBER];
+        std::vector<EVENT>  events;
+    };
+
+    /**
+     * Function Instance()
+     * Returns the profiler shared by all GALs and VIEWs.
+     */
+    static FRAME_PROFILER& Instance();
+
+    /**
+     * Function Enable()
+     * Turns profiling on or off. Turning it off discards the collected frames.
+     * @param aEnable tells if profiling should be enabled.
+     */
+    void Enable( bool aEnable );
+
+    /**
+     * Function IsEnabled()
+     * Returns true if profiling is enabled.
+     */
+    inline bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /**
+     * Function SetHistorySize()
+     * Sets the number of most recent frames that are kept.
+     */
+    void SetHistorySize( unsigned int aSize );
+
+    /**
+     * Function BeginFrame()
+     * Starts collecting data for a new frame.
+     */
+    void BeginFrame();
+
+    /**
+     * Function EndFrame()
+     * Finishes the current frame and stores it in the history.
+     */
+    void EndFrame();
+
+    /**
+     * Function AddCount()
+     * Increases a counter of the current frame.
+     * @param aCounter is the counter to be increased.
+     * @param aValue is the amount to be added.
+     */
+    inline void AddCount( COUNTER aCounter, int64_t aValue = 1 )
+    {
+        if( m_enabled )
+            m_current.counters[aCounter] += aValue;
+    }
+
+    /**
+     * Function GetFrames()
+     * Returns the recently finished frames, the oldest one first.
+     */
+    const std::deque<FRAME>& GetFrames() const
+    {
+        return m_frames;
+    }
+
+    /**
+     * Function SaveTrace()
+     * Saves the recently finished frames in the Chrome trace event format (JSON).
+     * @param aFileName is the output file name.
+     * @return true if the file was written successfully.
+     */
+    bool SaveTrace( const std::string& aFileName ) const;
+
+private:
+    friend class FRAME_PROFILER_SCOPE;
+
+    FRAME_PROFILER();
+
+    ///> Opens a stage, returns its index in the current frame event list
+    int beginEvent( const char* aName );
+
+    ///> Closes a stage opened by beginEvent()
+    void endEvent( int aEvent );
+
+    ///> Clears the statistics of the current frame
+    void resetCurrent();
+
+    bool                m_enabled;
+    bool                m_inFrame;
+    int                 m_depth;
+    unsigned int        m_historySize;
+    FRAME               m_current;
+    std::deque<FRAME>   m_frames;
+};
+
+
+/**
+ * Class FRAME_PROFILER_SCOPE
+ * measures the time spent in a rendering stage, from its construction until its destruction.
+ */
+class FRAME_PROFILER_SCOPE
+{
+public:
+    /**
+     * @param aName is the name of the measured stage. It has to be a string literal, as
+     * only the pointer is stored.
+     */
+    FRAME_PROFILER_SCOPE( const char* aName ) :
+        m_event( -1 )
+    {
+        FRAME_PROFILER& profiler = FRAME_PROFILER::Instance();
+
+        if( profiler.IsEnabled() )
+            m_event = profiler.beginEvent( aName );
+    }
+
+    ~FRAME_PROFILER_SCOPE()
+    {
+        if( m_event >= 0 )
+            FRAME_PROFILER::Instance().endEvent( m_event );
+    }
+
+private:
+    int m_event;
+};
+} // namespace KIGFX
+
+#endif /* FRAME_PROFILER_H_ */
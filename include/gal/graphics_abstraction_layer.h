@@ -28,6 +28,7 @@
 #define GRAPHICSABSTRACTIONLAYER_H_
 
 #include <deque>
+#include <vector>
 #include <stack>
 #include <limits>
 
@@ -106,6 +107,16 @@ public:
      */
     virtual void DrawPolyline( std::deque<VECTOR2D>& aPointList ) = 0;
 
+    /**
+     * @brief Draw a set of polylines that share the same attributes (e.g. all strokes of a text).
+     *
+     * @param aPoints contains points of all the polylines.
+     * @param aStarts contains indices of the first point of every polyline. A polyline ends
+     *                where the next one starts, the last one ends at the end of aPoints.
+     */
+    virtual void DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                                const std::vector<unsigned int>& aStarts );
+
     /**
      * @brief Draw a circle using world coordinates.
      *
@@ -122,6 +122,10 @@ public:
     /// @copydoc GAL::DrawPolyline()
     virtual void DrawPolyline( std::deque<VECTOR2D>& aPointList );
 
+    /// @copydoc GAL::DrawPolylines()
+    virtual void DrawPolylines( const std::vector<VECTOR2D>& aPoints,
+                                const std::vector<unsigned int>& aStarts );
+
     /// @copydoc GAL::DrawPolygon()
     virtual void DrawPolygon( const std::deque<VECTOR2D>& aPointList );
 
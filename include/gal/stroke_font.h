@@ -30,7 +30,10 @@
 #define STROKE_FONT_H_
 
 #include <deque>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 #include <utf8.h>
+#include <stroke_glyph_table.h>
 
 #include <eda_text.h>
 
@@ -40,13 +43,12 @@ namespace KIGFX
 {
 class GAL;
 
-typedef std::deque< std::deque<VECTOR2D> > GLYPH;
-typedef std::vector<GLYPH>                 GLYPH_LIST;
-
 /**
  * @brief Class STROKE_FONT implements stroke font drawing.
  *
- * A stroke font is composed of lines.
+ * A stroke font is composed of lines. By default the newstroke font shared with the legacy
+ * text drawing code (STROKE_GLYPH_TABLE::NewStroke()) is used. Every line of text is
+ * tessellated into a single set of polylines and passed to the GAL at once.
  */
 class STROKE_FONT
 {
@@ -55,7 +57,8 @@ public:
     STROKE_FONT( GAL* aGal );
 
     /**
-     * @brief Load the new stroke font.
+     * @brief Load the new stroke font. It is needed only to use a font different than
+     * the default one.
      *
      * @param aNewStrokeFont is the pointer to the font data.
      * @param aNewStrokeFontSize is the size of the font data.
@@ -144,8 +147,10 @@ public:
 
 private:
     GAL*                m_gal;                                    ///< Pointer to the GAL
-    GLYPH_LIST          m_glyphs;                                 ///< Glyph list
-    std::vector<BOX2D>  m_glyphBoundingBoxes;                     ///< Bounding boxes of the glyphs
+    const STROKE_GLYPH_TABLE* m_glyphs;                           ///< Glyph table in use
+    boost::shared_ptr<STROKE_GLYPH_TABLE> m_ownGlyphs;            ///< Glyphs loaded by LoadNewStrokeFont()
+    std::vector<VECTOR2D>       m_points;                         ///< Tessellated text (reused buffer)
+    std::vector<unsigned int>   m_strokeStarts;                   ///< Polylines in m_points
     VECTOR2D            m_glyphSize;                              ///< Size of the glyphs
     EDA_TEXT_HJUSTIFY_T m_horizontalJustify;                      ///< Horizontal justification
     EDA_TEXT_VJUSTIFY_T m_verticalJustify;                        ///< Vertical justification
@@ -159,13 +164,14 @@ private:
     int getInterline() const;
 
     /**
-     * @brief Compute the bounding box of a given glyph.
-     *
-     * @param aGlyph is the glyph.
-     * @param aGlyphBoundingX is the x-component of the bounding box size.
-     * @return is the complete bounding box size.
+     * @brief Adds a single line (e.g. an overbar) to the tessellated text.
      */
-    BOX2D computeBoundingBox( const GLYPH& aGlyph, const VECTOR2D& aGlyphBoundingX ) const;
+    inline void addLine( const VECTOR2D& aStart, const VECTOR2D& aEnd )
+    {
+        m_strokeStarts.push_back( m_points.size() );
+        m_points.push_back( aStart );
+        m_points.push_back( aEnd );
+    }
 
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
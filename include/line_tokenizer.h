@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file line_tokenizer.h
+ * @brief In place tokenizer of the lines of legacy file formats.
+ */
+
+#ifndef LINE_TOKENIZER_H_
+#define LINE_TOKENIZER_H_
+
+#include <cctype>
+#include <cstdlib>
+
+
+/**
+ * Class LINE_TOKENIZER
+ * reads blank separated values from a line read by a LINE_READER, as sscanf() does with
+ * "%s", "%d" and "%X" conversions, but without parsing a format string and without
+ * copying string tokens: NextToken() terminates the token in the line itself.
+ *
+ * Like sscanf(), the reading stops at the first value which cannot be read: all the
+ * following Next...() calls fail, and Parsed() gives the number of values read.
+ */
+class LINE_TOKENIZER
+{
+public:
+    LINE_TOKENIZER( char* aLine ) :
+        m_pos( aLine ),
+        m_parsed( 0 ),
+        m_failed( false )
+    {
+    }
+
+    /**
+     * Function NextToken
+     * reads the next blank separated token, and null terminates it in the line.
+     * @return char* - the token, or NULL if the end of line is reached.
+     */
+    char* NextToken()
+    {
+        if( m_failed || !skipBlanks() )
+        {
+            fail();
+            return NULL;
+        }
+
+        char* token = m_pos;
+
+        while( *m_pos && !isspace( (unsigned char) *m_pos ) )
+            m_pos++;
+
+        if( *m_pos )
+            *m_pos++ = 0;
+
+        m_parsed++;
+
+        return token;
+    }
+
+    /**
+     * Function NextInt
+     * reads the next value as a decimal integer.
+     * @return bool - true if a value was read, \a aValue is not modified otherwise.
+     */
+    bool NextInt( int& aValue )
+    {
+        if( m_failed || !skipBlanks() )
+            return fail();
+
+        char* end;
+        long value = strtol( m_pos, &end, 10 );
+
+        if( end == m_pos )
+            return fail();
+
+        m_pos = end;
+        m_parsed++;
+        aValue = (int) value;
+        return true;
+    }
+
+    /**
+     * Function NextHex
+     * reads the next value as an hexadecimal unsigned integer.
+     * @return bool - true if a value was read, \a aValue is not modified otherwise.
+     */
+    bool NextHex( unsigned long& aValue )
+    {
+        if( m_failed || !skipBlanks() )
+            return fail();
+
+        char* end;
+        unsigned long value = strtoul( m_pos, &end, 16 );
+
+        if( end == m_pos )
+            return fail();
+
+        m_pos = end;
+        m_parsed++;
+        aValue = value;
+        return true;
+    }
+
+    /**
+     * Function Parsed
+     * @return int - the count of values successfully read.
+     */
+    int Parsed() const { return m_parsed; }
+
+    /**
+     * Function Position
+     * @return char* - the first character not read yet.
+     */
+    char* Position() const { return m_pos; }
+
+private:
+    ///> Skips blanks, returns false if the end of line is reached
+    bool skipBlanks()
+    {
+        while( *m_pos && isspace( (unsigned char) *m_pos ) )
+            m_pos++;
+
+        return *m_pos != 0;
+    }
+
+    ///> Stops the reading, returns false
+    bool fail()
+    {
+        m_failed = true;
+        return false;
+    }
+
+    char*   m_pos;          ///< Read position in the line
+    int     m_parsed;       ///< Count of values read
+    bool    m_failed;       ///< A value could not be read, nothing else is read
+};
+
+#endif  // LINE_TOKENIZER_H_
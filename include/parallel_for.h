@@ -0,0 +1,140 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file parallel_for.h
+ * @brief Run independent jobs on worker threads.
+ */
+
+#ifndef PARALLEL_FOR_H_
+#define PARALLEL_FOR_H_
+
+#include <boost/thread.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+
+/**
+ * Function ParallelThreadCount
+ * returns the number of threads ParallelFor() uses for \a aJobCount jobs.
+ * <p>
+ * Without a budget, this is the number of cores when called from the main thread, and
+ * 1 from an other thread: a worker thread is already one of a set of threads keeping
+ * the cores busy, it must not start a full set of threads again.
+ *
+ * @param aJobCount is the number of jobs to run.
+ * @param aThreadBudget is the number of threads the caller may use, or 0 to use the
+ *  default policy.  It is still limited to the number of cores.
+ * @return unsigned - the thread count, at least 1 and at most \a aJobCount, the calling
+ *  thread included.
+ */
+unsigned ParallelThreadCount( unsigned aJobCount, unsigned aThreadBudget = 0 );
+
+
+/**
+ * Class PARALLEL_FOR_WORKER
+ * is the job of a thread of ParallelFor(), it calls the functor for the indexes
+ * \a aFirst, \a aFirst + \a aStep, \a aFirst + 2 * \a aStep ...
+ */
+template <class FUNCTOR>
+class PARALLEL_FOR_WORKER
+{
+public:
+    PARALLEL_FOR_WORKER( FUNCTOR* aFunctor, unsigned aCount, unsigned aFirst, unsigned aStep ) :
+        m_functor( aFunctor ),
+        m_count( aCount ),
+        m_first( aFirst ),
+        m_step( aStep )
+    {
+    }
+
+    void operator()()
+    {
+        for( unsigned ii = m_first; ii < m_count; ii += m_step )
+            (*m_functor)( ii );
+    }
+
+private:
+    FUNCTOR*    m_functor;      ///< Shared by all the workers
+    unsigned    m_count;
+    unsigned    m_first;
+    unsigned    m_step;
+};
+
+
+/**
+ * Function ParallelFor
+ * calls \a aFunctor( ii ) for each ii from 0 to \a aCount - 1, spreading the calls
+ * over ParallelThreadCount() threads, and returns when all of them are done.
+ * <p>
+ * The calls are made in any order and at the same time: each one must only modify
+ * the data of its own index.  The functor is typically made with boost::bind() from
+ * a job function taking the job data and the index.
+ * <p>
+ * Nothing may be thrown out of a worker thread, so the functor must catch its
+ * exceptions and store them with the data of its index, for the caller to report
+ * once ParallelFor() returns.
+ *
+ * @param aCount is the number of jobs.
+ * @param aFunctor is called with the index of each job.  It is copied once, all the
+ *  threads use the same copy.
+ * @param aThreadBudget is the number of threads the caller may use, see
+ *  ParallelThreadCount().
+ */
+template <class FUNCTOR>
+void ParallelFor( unsigned aCount, FUNCTOR aFunctor, unsigned aThreadBudget = 0 )
+{
+    if( aCount == 0 )
+        return;
+
+    unsigned threadCount = ParallelThreadCount( aCount, aThreadBudget );
+
+    // Something which will not invoke a thread copy constructor
+    boost::ptr_vector<boost::thread> threads;
+
+    for( unsigned ii = 1; ii < threadCount; ii++ )
+    {
+        threads.push_back( new boost::thread(
+                PARALLEL_FOR_WORKER<FUNCTOR>( &aFunctor, aCount, ii, threadCount ) ) );
+    }
+
+    PARALLEL_FOR_WORKER<FUNCTOR> share( &aFunctor, aCount, 0, threadCount );
+
+    try
+    {
+        // The current thread does its share too
+        share();
+    }
+    catch( ... )
+    {
+        // The workers use the caller's data, they must be done before it is released.
+        for( unsigned ii = 0; ii < threads.size(); ii++ )
+            threads[ii].join();
+
+        throw;
+    }
+
+    for( unsigned ii = 0; ii < threads.size(); ii++ )
+        threads[ii].join();
+}
+
+#endif  // PARALLEL_FOR_H_
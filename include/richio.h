@@ -529,6 +529,22 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... ) throw( IO_ERROR );
 
+    /**
+     * Function Write
+     * outputs \a aCount bytes of \a aText as they are.  This is a faster alternative to
+     * Print() for callers which build their text themselves, since nothing goes through
+     * printf().
+     *
+     * @param aText is the text to output, it does not need to be null terminated.
+     * @param aCount is the number of bytes to output.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const char* aText, int aCount ) throw( IO_ERROR )
+    {
+        if( aCount > 0 )
+            write( aText, aCount );
+    }
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination.
@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_screen_index.h
+ * @brief Spatial index of the draw items of a SCH_SCREEN used by schematic hit-testing.
+ */
+
+#ifndef SCH_SCREEN_INDEX_H_
+#define SCH_SCREEN_INDEX_H_
+
+#include <vector>
+#include <boost/unordered/unordered_map.hpp>
+
+#include <dlist.h>
+#include <base_struct.h>
+#include <geometry/rtree.h>
+
+class SCH_ITEM;
+
+/**
+ * Class SCH_SCREEN_INDEX
+ * keeps an R-tree of the draw items of a SCH_SCREEN, so lookups by position do not have
+ * to walk the whole draw list.
+ *
+ * The index is owned by the SCH_SCREEN and is not meant to be used directly:
+ * SCH_SCREEN::Append() and SCH_SCREEN::Remove() update it, and any other change of the draw
+ * list is detected using its change counter and causes a rebuild on the next query.  Items
+ * moved or edited in place are not detected; SCH_SCREEN::SetModify() invalidates the index.
+ *
+ * Queries return candidates whose bounding box (as of the time they were indexed) intersects
+ * the given area, in draw list order; callers still have to hit-test them.
+ */
+class SCH_SCREEN_INDEX
+{
+public:
+    SCH_SCREEN_INDEX();
+
+    /**
+     * Function IsUpToDate
+     * tells if the index reflects the current content of \a aList.
+     */
+    bool IsUpToDate( const DLIST<SCH_ITEM>& aList ) const
+    {
+        return m_valid && m_stamp == aList.GetChangeCount();
+    }
+
+    /**
+     * Function Invalidate
+     * marks the index as outdated, it is rebuilt by the next Build() call.
+     */
+    void Invalidate()
+    {
+        m_valid = false;
+    }
+
+    /**
+     * Function Build
+     * indexes all items of \a aList, discarding the previous content.
+     */
+    void Build( const DLIST<SCH_ITEM>& aList );
+
+    /**
+     * Function Add
+     * adds an item that has been just appended to \a aList.
+     */
+    void Add( SCH_ITEM* aItem, const DLIST<SCH_ITEM>& aList );
+
+    /**
+     * Function Remove
+     * removes an item that has been just removed from \a aList.
+     */
+    void Remove( SCH_ITEM* aItem, const DLIST<SCH_ITEM>& aList );
+
+    /**
+     * Function Query
+     * appends the items touching \a aArea to \a aResult, in the draw list order.
+     */
+    void Query( const EDA_RECT& aArea, std::vector<SCH_ITEM*>& aResult );
+
+private:
+    typedef RTree<SCH_ITEM*, int, 2, float>     ITEM_TREE;
+
+    ///> Where an item has been indexed, and its rank in the draw list
+    struct ENTRY
+    {
+        EDA_RECT    bbox;
+        unsigned    rank;
+    };
+
+    typedef boost::unordered_map<SCH_ITEM*, ENTRY> ENTRIES;
+
+    // The tree is not copyable
+    SCH_SCREEN_INDEX( const SCH_SCREEN_INDEX& );
+    SCH_SCREEN_INDEX& operator=( const SCH_SCREEN_INDEX& );
+
+    ///> Removes all items
+    void clear();
+
+    ///> Returns the area covered by an item, including the pins of sheets
+    static EDA_RECT itemBBox( const SCH_ITEM* aItem );
+
+    ///> Adds an item after the ones already indexed
+    void insert( SCH_ITEM* aItem );
+
+    ITEM_TREE   m_tree;
+    ENTRIES     m_entries;
+
+    bool        m_valid;
+    unsigned    m_stamp;            ///< Draw list change count when indexed
+    unsigned    m_nextRank;         ///< Rank given to the next item added
+};
+
+#endif /* SCH_SCREEN_INDEX_H_ */
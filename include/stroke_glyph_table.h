@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file stroke_glyph_table.h
+ * @brief Decoded Hershey (newstroke) glyphs stored in contiguous arrays.
+ */
+
+#ifndef STROKE_GLYPH_TABLE_H_
+#define STROKE_GLYPH_TABLE_H_
+
+#include <vector>
+
+/**
+ * Class STROKE_GLYPH_TABLE
+ * holds a stroke font decoded from its Hershey string representation. All the points of all
+ * glyphs are kept in a single array, strokes and glyphs only store offsets, so drawing a glyph
+ * does not require any decoding nor memory allocation.
+ *
+ * Coordinates are expressed in Hershey units (1/21 of the glyph height): X is relative to the
+ * left side of the glyph, Y is the raw Hershey value (the baseline is at 10).
+ */
+class STROKE_GLYPH_TABLE
+{
+public:
+    ///> Single point of a stroke
+    struct POINT
+    {
+        signed char x;
+        signed char y;
+    };
+
+    ///> Glyph metrics and its strokes
+    struct GLYPH
+    {
+        int         advance;        ///< Glyph width, including the spacing
+        unsigned    firstStroke;    ///< Index of the first stroke in the stroke table
+        unsigned    strokeCount;    ///< Number of strokes
+    };
+
+    /**
+     * Function NewStroke()
+     * Returns the newstroke font table, shared by all text drawing code. It is decoded
+     * on the first use.
+     */
+    static const STROKE_GLYPH_TABLE& NewStroke();
+
+    /**
+     * Constructor
+     * decodes a font in the Hershey string representation.
+     * @param aFont is the font data, one string per glyph, starting from the space character.
+     * @param aGlyphCount is the number of glyphs in aFont.
+     */
+    STROKE_GLYPH_TABLE( const char* const aFont[], int aGlyphCount );
+
+    /**
+     * Function GlyphCount()
+     * Returns the number of glyphs.
+     */
+    inline int GlyphCount() const
+    {
+        return m_glyphs.size();
+    }
+
+    /**
+     * Function GetGlyph()
+     * Returns the glyph for a character. Control characters are replaced with space,
+     * characters missing in the font are replaced with '?'.
+     * @param aCode is the unicode value of the character.
+     */
+    inline const GLYPH& GetGlyph( int aCode ) const
+    {
+        if( aCode < ' ' )
+            aCode = ' ';
+        else if( aCode >= ' ' + (int) m_glyphs.size() )
+            aCode = '?';
+
+        return m_glyphs[aCode - ' '];
+    }
+
+    /**
+     * Function StrokeBegin()
+     * Returns the first point of a stroke.
+     * @param aStroke is the index of the stroke in the stroke table.
+     */
+    inline const POINT* StrokeBegin( unsigned aStroke ) const
+    {
+        return &m_points[m_strokes[aStroke]];
+    }
+
+    /**
+     * Function StrokeEnd()
+     * Returns the point past the last point of a stroke.
+     * @param aStroke is the index of the stroke in the stroke table.
+     */
+    inline const POINT* StrokeEnd( unsigned aStroke ) const
+    {
+        return &m_points[0] + m_strokes[aStroke + 1];
+    }
+
+private:
+    std::vector<POINT>      m_points;   ///< Points of all strokes
+    std::vector<unsigned>   m_strokes;  ///< Stroke offsets in m_points, with a sentinel at the end
+    std::vector<GLYPH>      m_glyphs;   ///< Glyphs, starting from the space character
+};
+
+#endif /* STROKE_GLYPH_TABLE_H_ */
@@ -78,6 +78,15 @@ public:
      */
     void Add( VIEW_ITEM* aItem );
 
+    /**
+     * Function Add()
+     * Adds a set of VIEW_ITEMs to the view. It is much faster than adding items one by one,
+     * especially if the view is empty (e.g. when a board is loaded), as the spatial index is
+     * then built in a single pass.
+     * @param aItems: items to be added. No ownership is given
+     */
+    void Add( const std::vector<VIEW_ITEM*>& aItems );
+
     /**
      * Function Remove()
      * Removes a VIEW_ITEM from the view.
@@ -308,6 +317,40 @@ public:
         m_layers[aLayer].target = aTarget;
     }
 
+    /**
+     * Function SetLayerMinScreenSize()
+     * Sets the minimal size (in pixels) that an item has to have on the screen to be drawn on
+     * a particular layer. Items whose bounding box is smaller than that at the current zoom are
+     * skipped during redraws.
+     * @param aLayer is the layer.
+     * @param aSize is the minimal size in pixels (0 disables culling).
+     */
+    inline void SetLayerMinScreenSize( int aLayer, double aSize )
+    {
+        m_layers[aLayer].minScreenSize = aSize;
+        MarkTargetDirty( m_layers[aLayer].target );
+    }
+
+    /**
+     * Function GetDrawnItemsCount()
+     * Returns the number of items drawn during the last Redraw() call (an item drawn on
+     * several layers is counted once per layer).
+     */
+    inline int GetDrawnItemsCount() const
+    {
+        return m_drawnItems;
+    }
+
+    /**
+     * Function GetCulledItemsCount()
+     * Returns the number of items that were skipped during the last Redraw() call, as they
+     * were too small to be seen at the current zoom level.
+     */
+    inline int GetCulledItemsCount() const
+    {
+        return m_culledItems;
+    }
+
     /**
      * Function SetLayerOrder()
      * Sets rendering order of a particular layer. Lower values are rendered first.
@@ -508,6 +551,7 @@ private:
         int                     id;              ///* layer ID
         RENDER_TARGET           target;          ///* where the layer should be rendered
         std::set<int>           requiredLayers;  ///* layers that have to be enabled to show the layer
+        double                  minScreenSize;   ///* items smaller than that (in pixels) are not drawn
     };
 
     // Convenience typedefs
@@ -629,6 +673,12 @@ private:
     /// static (eg. image/PDF) - does not.
     bool m_dynamic;
 
+    /// Number of items drawn during the last redraw
+    int m_drawnItems;
+
+    /// Number of items skipped during the last redraw, as they were too small to be visible
+    int m_culledItems;
+
     /// Flags to mark targets as dirty, so they have to be redrawn on the next refresh event
     bool m_dirtyTargets[TARGETS_NUMBER];
 
@@ -25,6 +25,12 @@
 #ifndef __VIEW_RTREE_H
 #define __VIEW_RTREE_H
 
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <boost/unordered/unordered_map.hpp>
+
 #include <math/box2.h>
 
 #include <geometry/rtree.h>
@@ -44,33 +50,114 @@ public:
 
     /**
      * Function Insert()
-     * Inserts an item into the tree. Item's bounding box is taken via its ViewBBox() method.
+     * Inserts an item into the tree. Item's bounding box is taken via its ViewBBox() method
+     * and cached, so the item can be found later even if its geometry has changed meanwhile.
      */
     void Insert( VIEW_ITEM* aItem )
     {
-        const BOX2I&    bbox    = aItem->ViewBBox();
-        const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
-        const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+        const BOX2I bbox = aItem->ViewBBox();
+        const int   mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int   mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
 
         VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
+        m_bboxCache[aItem] = bbox;
     }
 
     /**
      * Function Remove()
      * Removes an item from the tree. Removal is done by comparing pointers, attepmting to remove a copy
-     * of the item will fail.
+     * of the item will fail. The search is limited to the bounding box the item had when it was
+     * inserted, so removal costs O(log n) instead of a full tree scan.
      */
     void Remove( VIEW_ITEM* aItem )
     {
-        // const BOX2I&    bbox    = aItem->ViewBBox();
+        BBOX_CACHE::iterator it = m_bboxCache.find( aItem );
+
+        if( it != m_bboxCache.end() )
+        {
+            const BOX2I& bbox = it->second;
+            Rect         rect;
+
+            rect.m_min[0] = bbox.GetX();
+            rect.m_min[1] = bbox.GetY();
+            rect.m_max[0] = bbox.GetRight();
+            rect.m_max[1] = bbox.GetBottom();
+
+            m_bboxCache.erase( it );
+
+            // RemoveRect() returns false if the item was found and removed
+            if( !RemoveRect( &rect, aItem, &m_root ) )
+                return;
+        }
 
-        // FIXME: use cached bbox or ptr_map to speed up pointer <-> node lookups.
-        const int       mmin[2] = { INT_MIN, INT_MIN };
-        const int       mmax[2] = { INT_MAX, INT_MAX };
+        // The item was not indexed by this tree or its cached bbox is not normalized,
+        // so fall back to scanning the whole tree
+        const int mmin[2] = { INT_MIN, INT_MIN };
+        const int mmax[2] = { INT_MAX, INT_MAX };
 
         VIEW_RTREE_BASE::Remove( mmin, mmax, aItem );
     }
 
+    /**
+     * Function BulkLoad()
+     * Inserts a set of items at once. If the tree is empty, it is built bottom-up using the
+     * Sort-Tile-Recursive packing algorithm, which is much faster than inserting items one by
+     * one and produces nodes with less overlap. Otherwise items are inserted one at a time.
+     * @param aItems are the items to be inserted.
+     */
+    void BulkLoad( const std::vector<VIEW_ITEM*>& aItems )
+    {
+        if( m_root->m_count > 0 || aItems.size() <= (unsigned) MAXNODES )
+        {
+            for( unsigned int i = 0; i < aItems.size(); ++i )
+                Insert( aItems[i] );
+
+            return;
+        }
+
+        std::vector<Branch> level( aItems.size() );
+
+        for( unsigned int i = 0; i < aItems.size(); ++i )
+        {
+            const BOX2I bbox = aItems[i]->ViewBBox();
+
+            level[i].m_rect.m_min[0] = bbox.GetX();
+            level[i].m_rect.m_min[1] = bbox.GetY();
+            level[i].m_rect.m_max[0] = bbox.GetRight();
+            level[i].m_rect.m_max[1] = bbox.GetBottom();
+            level[i].m_data = aItems[i];
+
+            m_bboxCache[aItems[i]] = bbox;
+        }
+
+        int nodeLevel = 0;
+
+        // Pack branches into nodes level by level, until everything fits in a single node
+        while( level.size() > (unsigned) MAXNODES )
+        {
+            packLevel( level, nodeLevel++ );
+        }
+
+        Node* root = AllocNode();
+        root->m_level = nodeLevel;
+
+        for( unsigned int i = 0; i < level.size(); ++i )
+            root->m_branch[root->m_count++] = level[i];
+
+        FreeNode( m_root );
+        m_root = root;
+    }
+
+    /**
+     * Function RemoveAll()
+     * Removes all items from the tree.
+     */
+    void RemoveAll()
+    {
+        VIEW_RTREE_BASE::RemoveAll();
+        m_bboxCache.clear();
+    }
+
     /**
      * Function Query()
      * Executes a function object aVisitor for each item whose bounding box intersects
@@ -86,6 +173,65 @@ public:
     }
 
 private:
+    ///> Bounding boxes of items at the moment they were inserted
+    typedef boost::unordered_map<VIEW_ITEM*, BOX2I> BBOX_CACHE;
+    BBOX_CACHE m_bboxCache;
+
+    ///> Functors used to sort branches by the center of their bounding boxes
+    template <int AXIS>
+    struct compareCenter
+    {
+        bool operator()( const Branch& aA, const Branch& aB ) const
+        {
+            return (long long) aA.m_rect.m_min[AXIS] + aA.m_rect.m_max[AXIS] <
+                   (long long) aB.m_rect.m_min[AXIS] + aB.m_rect.m_max[AXIS];
+        }
+    };
+
+    /**
+     * Function packLevel()
+     * Groups branches into nodes of the given level (Sort-Tile-Recursive): branches are sorted
+     * by X and cut into vertical slices, then every slice is sorted by Y and cut into nodes.
+     * @param aBranches are the branches to be packed. On return, it contains branches pointing
+     * to the newly created nodes.
+     * @param aLevel is the level of created nodes (0 for leaves).
+     */
+    void packLevel( std::vector<Branch>& aBranches, int aLevel )
+    {
+        const int nodeCount  = ( aBranches.size() + MAXNODES - 1 ) / MAXNODES;
+        const int sliceCount = (int) ceil( sqrt( (double) nodeCount ) );
+        const int sliceSize  = sliceCount * MAXNODES;
+
+        std::vector<Branch> parents;
+        parents.reserve( nodeCount );
+
+        std::sort( aBranches.begin(), aBranches.end(), compareCenter<0>() );
+
+        for( unsigned int slice = 0; slice < aBranches.size(); slice += sliceSize )
+        {
+            std::vector<Branch>::iterator sliceBegin = aBranches.begin() + slice;
+            std::vector<Branch>::iterator sliceEnd = aBranches.begin() +
+                    std::min<unsigned int>( slice + sliceSize, aBranches.size() );
+
+            std::sort( sliceBegin, sliceEnd, compareCenter<1>() );
+
+            for( std::vector<Branch>::iterator it = sliceBegin; it != sliceEnd; )
+            {
+                Node* node = AllocNode();
+                node->m_level = aLevel;
+
+                while( it != sliceEnd && node->m_count < MAXNODES )
+                    node->m_branch[node->m_count++] = *it++;
+
+                Branch parent;
+                parent.m_rect  = NodeCover( node );
+                parent.m_child = node;
+                parents.push_back( parent );
+            }
+        }
+
+        aBranches.swap( parents );
+    }
 };
 } // namespace KIGFX
 
@@ -674,6 +674,18 @@ public:
      */
     bool LoadOneEEFile( SCH_SCREEN* aScreen, const wxString& aFullFileName, bool append = false );
 
+    /**
+     * Function LoadEEFiles
+     * loads several schematic (.sch) files at once, each one into its own screen.  The
+     * files are read by worker threads; messages are displayed afterwards, in the order
+     * of the files.
+     *
+     * @param aScreens The screens to load the files into, one per file.
+     * @param aFileNames The absolute paths of the files.
+     * @return True if all files have been loaded (at least partially.)
+     */
+    bool LoadEEFiles( const std::vector<SCH_SCREEN*>& aScreens, const wxArrayString& aFileNames );
+
     /**
      * Function ReadCmpToFootprintLinkFile
      * Loads a .cmp file from CvPcb and update the footprin field
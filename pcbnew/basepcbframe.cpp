@@ -779,6 +779,9 @@ void PCB_BASE_FRAME::LoadSettings()
 
         view->SetLayerOrder( layer, i );
 
+        // Do not waste time on drawing items that are smaller than a pixel
+        view->SetLayerMinScreenSize( layer, 1.0 );
+
         if( IsCopperLayer( layer ) )
         {
             // Copper layers are required for netname layers
@@ -855,6 +858,10 @@ void PCB_BASE_FRAME::OnModify()
 {
     GetScreen()->SetModify();
     GetScreen()->SetSave();
+
+    // Items may have been moved or resized in place
+    if( GetBoard() )
+        GetBoard()->InvalidateSpatialIndex();
 }
 
 
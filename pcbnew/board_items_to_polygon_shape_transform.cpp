@@ -22,6 +22,25 @@
 #include <class_module.h>
 #include <class_edge_mod.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <shape_templates.h>
+
+
+/* Appends the contours of a shape template to aCornerBuffer, moved to aPosition
+ */
+static void appendShapeTemplate( CPOLYGONS_LIST& aCornerBuffer, const CPOLYGONS_LIST& aTemplate,
+                                 const wxPoint& aPosition )
+{
+    const std::vector<CPolyPt>& corners = aTemplate.GetList();
+
+    for( unsigned ii = 0; ii < corners.size(); ii++ )
+    {
+        CPolyPt corner( corners[ii] );
+
+        corner.x += aPosition.x;
+        corner.y += aPosition.y;
+        aCornerBuffer.Append( corner );
+    }
+}
 
 /* generate pads shapes on layer aLayer as polygons,
  * and adds these polygons to aCornerBuffer
@@ -370,11 +389,13 @@ void DRAWSEGMENT::TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerB
  * @param aCorrectionFactor = the correction to apply to circles radius to keep
  * clearance when the circle is approximated by segment bigger or equal
  * to the real clearance value (usually near from 1.0)
+ * @param aTemplates = the via shapes shared during a zone fill, or NULL
  */
 void TRACK:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer,
                                                    int                      aClearanceValue,
                                                    int                      aCircleToSegmentsCount,
-                                                   double                   aCorrectionFactor ) const
+                                                   double                   aCorrectionFactor,
+                                                   SHAPE_TEMPLATES*         aTemplates ) const
 {
     switch( Type() )
     {
@@ -382,7 +403,22 @@ void TRACK:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer
     {
         int radius = (m_Width / 2) + aClearanceValue;
         radius = KiROUND( radius * aCorrectionFactor );
-        TransformCircleToPolygon( aCornerBuffer, m_Start, radius, aCircleToSegmentsCount );
+
+        if( !aTemplates )
+        {
+            TransformCircleToPolygon( aCornerBuffer, m_Start, radius, aCircleToSegmentsCount );
+            break;
+        }
+
+        SHAPE_TEMPLATE_KEY key( VIA_CLEARANCE_SHAPE, 0, wxSize( radius, radius ), 0, 0,
+                                aCircleToSegmentsCount, 0 );
+        bool               isNew;
+        CPOLYGONS_LIST&    shape = aTemplates->GetTemplate( key, isNew );
+
+        if( isNew )
+            TransformCircleToPolygon( shape, wxPoint( 0, 0 ), radius, aCircleToSegmentsCount );
+
+        appendShapeTemplate( aCornerBuffer, shape, m_Start );
     }
         break;
 
@@ -396,35 +432,28 @@ void TRACK:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer
 }
 
 
-/* Function TransformShapeWithClearanceToPolygon
- * Convert the pad shape to a closed polygon
- * Used in filling zones calculations and 3D view generation
- * Circles and arcs are approximated by segments
- * aCornerBuffer = a CPOLYGONS_LIST to store the polygon corners
- * aClearanceValue = the clearance around the pad
- * aCircleToSegmentsCount = the number of segments to approximate a circle
- * aCorrectionFactor = the correction to apply to circles radius to keep
- * clearance when the circle is approximated by segment bigger or equal
- * to the real clearance value (usually near from 1.0)
+/* Builds the polygon of the pad shape with clearance, for TransformShapeWithClearanceToPolygon(),
+ * the shape being at aShapePos
  */
-void D_PAD:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer,
-                                                   int             aClearanceValue,
-                                                   int             aCircleToSegmentsCount,
-                                                   double          aCorrectionFactor ) const
+static void buildPadShapeWithClearance( CPOLYGONS_LIST& aCornerBuffer,
+                                        const D_PAD&    aPad,
+                                        const wxPoint&  aShapePos,
+                                        int             aClearanceValue,
+                                        int             aCircleToSegmentsCount,
+                                        double          aCorrectionFactor )
 {
     wxPoint corner_position;
     double  angle;
-    int     dx = (m_Size.x / 2) + aClearanceValue;
-    int     dy = (m_Size.y / 2) + aClearanceValue;
+    int     dx = (aPad.GetSize().x / 2) + aClearanceValue;
+    int     dy = (aPad.GetSize().y / 2) + aClearanceValue;
 
     double  delta = 3600.0 / aCircleToSegmentsCount; // rot angle in 0.1 degree
-    wxPoint PadShapePos = ReturnShapePos();         /* Note: for pad having a shape offset,
-                                                     * the pad position is NOT the shape position */
-    wxSize  psize = m_Size;                         /* pad size unsed in RECT and TRAPEZOIDAL pads
+    wxPoint PadShapePos = aShapePos;
+    wxSize  psize = aPad.GetSize();                 /* pad size unsed in RECT and TRAPEZOIDAL pads
                                                      * trapezoidal pads are considered as rect
                                                      * pad shape having they boudary box size */
 
-    switch( GetShape() )
+    switch( aPad.GetShape() )
     {
     case PAD_CIRCLE:
         dx = KiROUND( dx * aCorrectionFactor );
@@ -434,7 +463,7 @@ void D_PAD:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer
 
     case PAD_OVAL:
         // An oval pad has the same shape as a segment with rounded ends
-        angle = m_Orient;
+        angle = aPad.GetOrientation();
         {
         int width;
         wxPoint shape_offset;
@@ -460,13 +489,13 @@ void D_PAD:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer
         break;
 
     case PAD_TRAPEZOID:
-        psize.x += std::abs( m_DeltaSize.y );
-        psize.y += std::abs( m_DeltaSize.x );
+        psize.x += std::abs( aPad.GetDelta().y );
+        psize.y += std::abs( aPad.GetDelta().x );
 
     // fall through
     case PAD_RECT:
         // Easy implementation for rectangular cutouts with rounded corners
-        angle = m_Orient;
+        angle = aPad.GetOrientation();
 
         // Corner rounding radius
         int rounding_radius = KiROUND( aClearanceValue * aCorrectionFactor );
@@ -535,6 +564,47 @@ void D_PAD:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer
     }
 }
 
+
+/* Function TransformShapeWithClearanceToPolygon
+ * Convert the pad shape to a closed polygon
+ * Used in filling zones calculations and 3D view generation
+ * Circles and arcs are approximated by segments
+ * aCornerBuffer = a CPOLYGONS_LIST to store the polygon corners
+ * aClearanceValue = the clearance around the pad
+ * aCircleToSegmentsCount = the number of segments to approximate a circle
+ * aCorrectionFactor = the correction to apply to circles radius to keep
+ * clearance when the circle is approximated by segment bigger or equal
+ * to the real clearance value (usually near from 1.0)
+ * aTemplates = the pad shapes shared during a zone fill, or NULL
+ */
+void D_PAD:: TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer,
+                                                   int             aClearanceValue,
+                                                   int             aCircleToSegmentsCount,
+                                                   double          aCorrectionFactor,
+                                                   SHAPE_TEMPLATES* aTemplates ) const
+{
+    /* Note: for pad having a shape offset, the pad position is NOT the shape position */
+    if( !aTemplates )
+    {
+        buildPadShapeWithClearance( aCornerBuffer, *this, ReturnShapePos(), aClearanceValue,
+                                    aCircleToSegmentsCount, aCorrectionFactor );
+        return;
+    }
+
+    SHAPE_TEMPLATE_KEY key( PAD_CLEARANCE_SHAPE, GetShape(), m_Size, m_Orient, aClearanceValue,
+                            aCircleToSegmentsCount, aCorrectionFactor );
+    key.m_Delta = m_DeltaSize;
+
+    bool            isNew;
+    CPOLYGONS_LIST& shape = aTemplates->GetTemplate( key, isNew );
+
+    if( isNew )
+        buildPadShapeWithClearance( shape, *this, wxPoint( 0, 0 ), aClearanceValue,
+                                    aCircleToSegmentsCount, aCorrectionFactor );
+
+    appendShapeTemplate( aCornerBuffer, shape, ReturnShapePos() );
+}
+
 /*
  * Function BuildPadShapePolygon
  * Build the Corner list of the polygonal shape,
@@ -652,18 +722,18 @@ bool D_PAD::BuildPadDrillShapePolygon( CPOLYGONS_LIST& aCornerBuffer,
  *      and are used in microwave applications and they *DO NOT* have a thermal relief that
  *      change the shape by creating stubs and destroy their properties.
  */
-void    CreateThermalReliefPadPolygon( CPOLYGONS_LIST& aCornerBuffer,
-                                       D_PAD&          aPad,
-                                       int             aThermalGap,
-                                       int             aCopperThickness,
-                                       int             aMinThicknessValue,
-                                       int             aCircleToSegmentsCount,
-                                       double          aCorrectionFactor,
-                                       double          aThermalRot )
+static void buildThermalReliefPadPolygon( CPOLYGONS_LIST& aCornerBuffer,
+                                          const D_PAD&    aPad,
+                                          const wxPoint&  aShapePos,
+                                          int             aThermalGap,
+                                          int             aCopperThickness,
+                                          int             aMinThicknessValue,
+                                          int             aCircleToSegmentsCount,
+                                          double          aCorrectionFactor,
+                                          double          aThermalRot )
 {
     wxPoint corner, corner_end;
-    wxPoint PadShapePos = aPad.ReturnShapePos();    /* Note: for pad having a shape offset,
-                                                     * the pad position is NOT the shape position */
+    wxPoint PadShapePos = aShapePos;
     wxSize  copper_thickness;
 
     int     dx = aPad.GetSize().x / 2;
@@ -1002,3 +1072,44 @@ void    CreateThermalReliefPadPolygon( CPOLYGONS_LIST& aCornerBuffer,
         ;
     }
 }
+
+
+/* The thermal relief holes built by buildThermalReliefPadPolygon() are shared by all the pads
+ * having the same shape, size and orientation when aTemplates is not NULL
+ */
+void    CreateThermalReliefPadPolygon( CPOLYGONS_LIST&  aCornerBuffer,
+                                       D_PAD&           aPad,
+                                       int              aThermalGap,
+                                       int              aCopperThickness,
+                                       int              aMinThicknessValue,
+                                       int              aCircleToSegmentsCount,
+                                       double           aCorrectionFactor,
+                                       double           aThermalRot,
+                                       SHAPE_TEMPLATES* aTemplates )
+{
+    /* Note: for pad having a shape offset, the pad position is NOT the shape position */
+    if( !aTemplates )
+    {
+        buildThermalReliefPadPolygon( aCornerBuffer, aPad, aPad.ReturnShapePos(), aThermalGap,
+                                      aCopperThickness, aMinThicknessValue,
+                                      aCircleToSegmentsCount, aCorrectionFactor, aThermalRot );
+        return;
+    }
+
+    SHAPE_TEMPLATE_KEY key( PAD_THERMAL_RELIEF_SHAPE, aPad.GetShape(), aPad.GetSize(),
+                            aPad.GetOrientation(), aThermalGap, aCircleToSegmentsCount,
+                            aCorrectionFactor );
+    key.m_CopperThickness = aCopperThickness;
+    key.m_MinThickness    = aMinThicknessValue;
+    key.m_ThermalRot      = aThermalRot;
+
+    bool            isNew;
+    CPOLYGONS_LIST& shape = aTemplates->GetTemplate( key, isNew );
+
+    if( isNew )
+        buildThermalReliefPadPolygon( shape, aPad, wxPoint( 0, 0 ), aThermalGap,
+                                      aCopperThickness, aMinThicknessValue,
+                                      aCircleToSegmentsCount, aCorrectionFactor, aThermalRot );
+
+    appendShapeTemplate( aCornerBuffer, shape, aPad.ReturnShapePos() );
+}
@@ -0,0 +1,328 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_spatial_index.cpp
+ * @brief Spatial index of board tracks, vias and footprints used by BOARD hit-testing.
+ */
+
+#include <fctsys.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+
+#include <board_spatial_index.h>
+
+
+/**
+ * Class QUERY_VISITOR
+ * collects items found by an R-tree search.
+ */
+template <class T>
+class QUERY_VISITOR
+{
+public:
+    QUERY_VISITOR( std::vector<T*>& aResult ) :
+        m_result( aResult )
+    {
+    }
+
+    bool operator()( BOARD_ITEM* aItem )
+    {
+        m_result.push_back( static_cast<T*>( aItem ) );
+
+        return true;
+    }
+
+private:
+    std::vector<T*>& m_result;
+};
+
+
+BOARD_SPATIAL_INDEX::BOARD_SPATIAL_INDEX() :
+    m_valid( false ), m_trackStamp( 0 ), m_moduleStamp( 0 )
+{
+}
+
+
+bool BOARD_SPATIAL_INDEX::IsUpToDate( const BOARD* aBoard ) const
+{
+    return m_valid && m_trackStamp == aBoard->m_Track.GetChangeCount()
+                   && m_moduleStamp == aBoard->m_Modules.GetChangeCount();
+}
+
+
+void BOARD_SPATIAL_INDEX::Build( const BOARD* aBoard )
+{
+    clear();
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+        insert( track );
+
+    for( MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+        insert( module );
+
+    updateStamps( aBoard );
+    m_valid = true;
+}
+
+
+void BOARD_SPATIAL_INDEX::Add( BOARD_ITEM* aItem, const BOARD* aBoard )
+{
+    insert( aItem );
+    updateStamps( aBoard );
+}
+
+
+void BOARD_SPATIAL_INDEX::Remove( BOARD_ITEM* aItem, const BOARD* aBoard )
+{
+    ENTRIES::iterator it = m_entries.find( aItem );
+
+    if( it != m_entries.end() )
+    {
+        const EDA_RECT& bbox = it->second.bbox;
+        const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        it->second.tree->Remove( mmin, mmax, aItem );
+        m_entries.erase( it );
+    }
+
+    updateStamps( aBoard );
+}
+
+
+void BOARD_SPATIAL_INDEX::Update( BOARD_ITEM* aItem )
+{
+    // An outdated index is rebuilt anyway before the next query
+    if( !m_valid )
+        return;
+
+    ENTRIES::iterator it = m_entries.find( aItem );
+
+    if( it != m_entries.end() && !reindex( aItem, it->second ) )
+        m_entries.erase( it );
+}
+
+
+void BOARD_SPATIAL_INDEX::UpdateMovedItems()
+{
+    for( ENTRIES::iterator it = m_entries.begin(); it != m_entries.end(); )
+    {
+        if( reindex( it->first, it->second ) )
+            ++it;
+        else
+            it = m_entries.erase( it );
+    }
+}
+
+
+void BOARD_SPATIAL_INDEX::QuerySegments( const EDA_RECT& aArea, LAYER_MSK aLayerMask,
+                                         std::vector<TRACK*>& aResult )
+{
+    for( LAYER_NUM layer = FIRST_LAYER; layer < NB_PCB_LAYERS; ++layer )
+    {
+        if( GetLayerMask( layer ) & aLayerMask )
+            query( m_segments[layer], aArea, aResult );
+    }
+}
+
+
+void BOARD_SPATIAL_INDEX::QueryVias( const EDA_RECT& aArea, std::vector<TRACK*>& aResult )
+{
+    query( m_vias, aArea, aResult );
+}
+
+
+void BOARD_SPATIAL_INDEX::QueryModules( const EDA_RECT& aArea, std::vector<MODULE*>& aResult )
+{
+    query( m_modules, aArea, aResult );
+}
+
+
+void BOARD_SPATIAL_INDEX::clear()
+{
+    for( LAYER_NUM layer = FIRST_LAYER; layer < NB_PCB_LAYERS; ++layer )
+        m_segments[layer].RemoveAll();
+
+    m_vias.RemoveAll();
+    m_modules.RemoveAll();
+    m_entries.clear();
+
+    m_valid = false;
+}
+
+
+BOARD_SPATIAL_INDEX::ITEM_TREE* BOARD_SPATIAL_INDEX::treeFor( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    {
+        LAYER_NUM layer = aItem->GetLayer();
+
+        if( layer < FIRST_LAYER || layer >= NB_PCB_LAYERS )
+            return NULL;
+
+        return &m_segments[layer];
+    }
+
+    case PCB_VIA_T:
+        return &m_vias;
+
+    case PCB_MODULE_T:
+        return &m_modules;
+
+    default:
+        return NULL;
+    }
+}
+
+
+int BOARD_SPATIAL_INDEX::localMargin( const MODULE* aModule )
+{
+    int margin = std::max( aModule->GetLocalClearance(), aModule->GetThermalGap() );
+
+    for( const D_PAD* pad = aModule->Pads(); pad; pad = pad->Next() )
+    {
+        margin = std::max( margin, pad->GetLocalClearance() );
+        margin = std::max( margin, pad->GetThermalGap() );
+    }
+
+    return std::max( margin, 0 );
+}
+
+
+EDA_RECT BOARD_SPATIAL_INDEX::itemBBox( const BOARD_ITEM* aItem )
+{
+    EDA_RECT bbox;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    {
+        const TRACK* track = static_cast<const TRACK*>( aItem );
+
+        bbox.SetOrigin( track->GetStart() );
+        bbox.SetEnd( track->GetEnd() );
+        bbox.Normalize();
+        bbox.Inflate( ( track->GetWidth() + 1 ) / 2 + 1 );
+        break;
+    }
+
+    case PCB_VIA_T:
+    {
+        const TRACK* via = static_cast<const TRACK*>( aItem );
+
+        bbox.SetOrigin( via->GetStart() );
+        bbox.SetEnd( via->GetStart() );
+        bbox.Inflate( via->GetWidth() + 1 );
+        break;
+    }
+
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+
+        bbox = module->GetFootprintRect();
+        bbox.Normalize();
+        bbox.Inflate( localMargin( module ) + 1 );
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return bbox;
+}
+
+
+void BOARD_SPATIAL_INDEX::insert( BOARD_ITEM* aItem )
+{
+    ITEM_TREE* tree = treeFor( aItem );
+
+    if( tree == NULL || m_entries.count( aItem ) )
+        return;
+
+    ENTRY entry;
+    entry.tree = tree;
+    entry.bbox = itemBBox( aItem );
+
+    const int mmin[2] = { entry.bbox.GetX(), entry.bbox.GetY() };
+    const int mmax[2] = { entry.bbox.GetRight(), entry.bbox.GetBottom() };
+
+    tree->Insert( mmin, mmax, aItem );
+    m_entries[aItem] = entry;
+}
+
+
+bool BOARD_SPATIAL_INDEX::reindex( BOARD_ITEM* aItem, ENTRY& aEntry )
+{
+    ITEM_TREE*  tree = treeFor( aItem );
+    EDA_RECT    bbox = tree ? itemBBox( aItem ) : EDA_RECT();
+
+    if( tree == aEntry.tree && bbox.GetOrigin() == aEntry.bbox.GetOrigin()
+        && bbox.GetSize() == aEntry.bbox.GetSize() )
+        return true;
+
+    const int oldMin[2] = { aEntry.bbox.GetX(), aEntry.bbox.GetY() };
+    const int oldMax[2] = { aEntry.bbox.GetRight(), aEntry.bbox.GetBottom() };
+
+    aEntry.tree->Remove( oldMin, oldMax, aItem );
+
+    if( tree == NULL )
+        return false;
+
+    const int mmin[2] = { bbox.GetX(), bbox.GetY() };
+    const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+    tree->Insert( mmin, mmax, aItem );
+    aEntry.tree = tree;
+    aEntry.bbox = bbox;
+
+    return true;
+}
+
+
+void BOARD_SPATIAL_INDEX::updateStamps( const BOARD* aBoard )
+{
+    m_trackStamp  = aBoard->m_Track.GetChangeCount();
+    m_moduleStamp = aBoard->m_Modules.GetChangeCount();
+}
+
+
+template <class T>
+void BOARD_SPATIAL_INDEX::query( ITEM_TREE& aTree, const EDA_RECT& aArea,
+                                 std::vector<T*>& aResult )
+{
+    EDA_RECT         area = aArea;
+    area.Normalize();
+
+    const int        mmin[2] = { area.GetX(), area.GetY() };
+    const int        mmax[2] = { area.GetRight(), area.GetBottom() };
+    QUERY_VISITOR<T> visitor( aResult );
+
+    aTree.Search( mmin, mmax, visitor );
+}
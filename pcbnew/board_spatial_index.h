@@ -0,0 +1,187 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_spatial_index.h
+ * @brief Spatial index of board tracks, vias and footprints used by BOARD hit-testing.
+ */
+
+#ifndef BOARD_SPATIAL_INDEX_H_
+#define BOARD_SPATIAL_INDEX_H_
+
+#include <vector>
+#include <boost/unordered/unordered_map.hpp>
+
+#include <base_struct.h>
+#include <layers_id_colors_and_visibility.h>
+#include <geometry/rtree.h>
+
+class BOARD;
+class BOARD_ITEM;
+class TRACK;
+class MODULE;
+
+/**
+ * Class BOARD_SPATIAL_INDEX
+ * keeps R-trees of the track segments (one per layer), vias and footprints of a BOARD, so
+ * lookups by position do not have to walk the whole track and module lists.
+ *
+ * The index is owned by the BOARD and is not meant to be used directly: BOARD::Add() and
+ * BOARD::Remove() update it, and any other change of the track or module lists is detected
+ * using DLIST change counters and causes a rebuild on the next query. Tracks and modules
+ * moved, resized or put on an other layer using their setters and Move(), Rotate() or Flip()
+ * are re-indexed by BOARD::UpdateSpatialIndex().  Code changing their members directly has
+ * to call BOARD::InvalidateSpatialIndex(), and UpdateMovedItems() is there for the queries
+ * which must not miss any item.
+ *
+ * Queries return candidates whose bounding box (as of the time they were indexed) intersects
+ * the given area; callers still have to hit-test them.
+ */
+class BOARD_SPATIAL_INDEX
+{
+public:
+    BOARD_SPATIAL_INDEX();
+
+    /**
+     * Function IsUpToDate
+     * tells if the index reflects the current track and module lists of \a aBoard.
+     */
+    bool IsUpToDate( const BOARD* aBoard ) const;
+
+    /**
+     * Function Invalidate
+     * marks the index as outdated, it is rebuilt by the next Build() call.
+     */
+    void Invalidate()
+    {
+        m_valid = false;
+    }
+
+    /**
+     * Function Build
+     * indexes all tracks, vias and modules of \a aBoard, discarding the previous content.
+     */
+    void Build( const BOARD* aBoard );
+
+    /**
+     * Function Add
+     * adds an item that has been just added to \a aBoard. Items of types that are not
+     * indexed are ignored.
+     */
+    void Add( BOARD_ITEM* aItem, const BOARD* aBoard );
+
+    /**
+     * Function Remove
+     * removes an item that has been just removed from \a aBoard.
+     */
+    void Remove( BOARD_ITEM* aItem, const BOARD* aBoard );
+
+    /**
+     * Function Update
+     * re-indexes \a aItem if its area or layer changed since it was indexed.  Items which
+     * are not indexed are ignored.
+     */
+    void Update( BOARD_ITEM* aItem );
+
+    /**
+     * Function UpdateMovedItems
+     * re-indexes the items whose area or layer changed since they were indexed, i.e. the
+     * items moved, resized or put on an other layer in place.  It checks all the items,
+     * so it is meant for the users which cannot afford to miss one, like the zone filling.
+     */
+    void UpdateMovedItems();
+
+    /**
+     * Function QuerySegments
+     * appends track segments located on \a aLayerMask layers and touching \a aArea.
+     */
+    void QuerySegments( const EDA_RECT& aArea, LAYER_MSK aLayerMask,
+                        std::vector<TRACK*>& aResult );
+
+    /**
+     * Function QueryVias
+     * appends vias touching \a aArea.
+     */
+    void QueryVias( const EDA_RECT& aArea, std::vector<TRACK*>& aResult );
+
+    /**
+     * Function QueryModules
+     * appends modules whose footprint (pads and drawings) touches \a aArea. The footprint
+     * is enlarged by the biggest local clearance or thermal gap of the module and its pads,
+     * so clearance areas can be looked up using only the netclass clearances.
+     */
+    void QueryModules( const EDA_RECT& aArea, std::vector<MODULE*>& aResult );
+
+private:
+    typedef RTree<BOARD_ITEM*, int, 2, float>   ITEM_TREE;
+
+    ///> Where an item has been indexed (its layer or geometry may have changed since then)
+    struct ENTRY
+    {
+        ITEM_TREE*  tree;
+        EDA_RECT    bbox;
+    };
+
+    typedef boost::unordered_map<BOARD_ITEM*, ENTRY> ENTRIES;
+
+    // The trees are not copyable
+    BOARD_SPATIAL_INDEX( const BOARD_SPATIAL_INDEX& );
+    BOARD_SPATIAL_INDEX& operator=( const BOARD_SPATIAL_INDEX& );
+
+    ///> Removes all items
+    void clear();
+
+    ///> Returns the tree holding aItem, or NULL if aItem type is not indexed
+    ITEM_TREE* treeFor( const BOARD_ITEM* aItem );
+
+    ///> Returns the biggest local clearance or thermal gap of a module and its pads
+    static int localMargin( const MODULE* aModule );
+
+    ///> Returns the area covered by an item
+    static EDA_RECT itemBBox( const BOARD_ITEM* aItem );
+
+    ///> Adds an item without updating the list change counters
+    void insert( BOARD_ITEM* aItem );
+
+    ///> Moves aItem to its current area and layer in the trees if they changed, returns
+    ///> false if aItem cannot be indexed anymore (it is then removed from the trees)
+    bool reindex( BOARD_ITEM* aItem, ENTRY& aEntry );
+
+    ///> Stores the change counters of aBoard lists
+    void updateStamps( const BOARD* aBoard );
+
+    ///> Appends the items of aTree touching aArea
+    template <class T>
+    static void query( ITEM_TREE& aTree, const EDA_RECT& aArea, std::vector<T*>& aResult );
+
+    ITEM_TREE   m_segments[NB_PCB_LAYERS];  ///< Track segments, one tree per layer
+    ITEM_TREE   m_vias;
+    ITEM_TREE   m_modules;
+    ENTRIES     m_entries;
+
+    bool        m_valid;
+    unsigned    m_trackStamp;               ///< BOARD::m_Track change count when indexed
+    unsigned    m_moduleStamp;              ///< BOARD::m_Modules change count when indexed
+};
+
+#endif /* BOARD_SPATIAL_INDEX_H_ */
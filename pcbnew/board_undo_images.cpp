@@ -0,0 +1,211 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_undo_images.cpp
+ * @brief Copies of footprints and zones saved by the board editor undo commands.
+ */
+
+#include <fctsys.h>
+
+#include <class_pad.h>
+#include <class_edge_mod.h>
+#include <class_text_mod.h>
+#include <board_undo_images.h>
+
+
+/**
+ * Function sameItem
+ * tests if two footprint items have the same properties and the same position on board.
+ */
+static bool sameItem( const BOARD_ITEM* aItem, const BOARD_ITEM* aOther )
+{
+    if( aItem->Type() != aOther->Type() )
+        return false;
+
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+        return ( (const D_PAD*) aItem )->IsSameAs( *(const D_PAD*) aOther );
+
+    case PCB_MODULE_EDGE_T:
+        return ( (const EDGE_MODULE*) aItem )->IsSameAs( *(const EDGE_MODULE*) aOther );
+
+    case PCB_MODULE_TEXT_T:
+        return ( (const TEXTE_MODULE*) aItem )->IsSameAs( *(const TEXTE_MODULE*) aOther );
+
+    default:
+        return false;       // Unknown, keep it
+    }
+}
+
+
+/**
+ * Function compactList
+ * deletes the items of \a aImageList that are identical to the item at the same position
+ * in \a aList, and stores the position of the remaining ones in \a aIndex.
+ */
+template <class T>
+static void compactList( DLIST<T>& aImageList, const DLIST<T>& aList,
+                         std::vector<unsigned>& aIndex )
+{
+    const T*    item = aList;
+    unsigned    pos = 0;
+    T*          next;
+
+    for( T* image = aImageList;  image;  image = next, item = item->Next(), ++pos )
+    {
+        next = image->Next();
+
+        if( sameItem( image, item ) )
+            delete aImageList.Remove( image );
+        else
+            aIndex.push_back( pos );
+    }
+}
+
+
+/**
+ * Function swapListItems
+ * exchanges the items of \a aImageList with the items of \a aList at the positions
+ * given by \a aIndex.  Items are moved from one list to the other, not copied.
+ */
+template <class T>
+static void swapListItems( DLIST<T>& aList, DLIST<T>& aImageList,
+                           const std::vector<unsigned>& aIndex,
+                           EDA_ITEM* aParent, EDA_ITEM* aImageParent )
+{
+    std::vector<T*> items;
+    unsigned        pos = 0;
+
+    items.reserve( aIndex.size() );
+
+    for( T* item = aList;  item && items.size() < aIndex.size();  item = item->Next(), ++pos )
+    {
+        if( pos == aIndex[items.size()] )
+            items.push_back( item );
+    }
+
+    wxASSERT( items.size() == aIndex.size() && items.size() == aImageList.GetCount() );
+
+    T* image = aImageList;
+
+    for( unsigned ii = 0;  ii < items.size() && image;  ++ii )
+    {
+        T* item      = items[ii];
+        T* next      = item->Next();
+        T* nextImage = image->Next();
+
+        aList.Remove( item );
+        aImageList.Remove( image );
+
+        aList.Insert( image, next );
+        aImageList.Insert( item, nextImage );
+
+        image->SetParent( aParent );
+        item->SetParent( aImageParent );
+
+        image = nextImage;
+    }
+}
+
+
+MODULE_UNDO_IMAGE::MODULE_UNDO_IMAGE( const MODULE& aModule ) :
+    MODULE( aModule ),
+    m_compacted( false )
+{
+}
+
+
+void MODULE_UNDO_IMAGE::Compact( MODULE* aNextImage )
+{
+    // Items are matched by position in their lists, and their coordinates on board
+    // depend on the footprint placement.
+    if( m_compacted
+        || GetPosition() != aNextImage->GetPosition()
+        || GetOrientation() != aNextImage->GetOrientation()
+        || GetLayer() != aNextImage->GetLayer()
+        || Pads().GetCount() != aNextImage->Pads().GetCount()
+        || GraphicalItems().GetCount() != aNextImage->GraphicalItems().GetCount() )
+        return;
+
+    compactList( Pads(), aNextImage->Pads(), m_padIndex );
+    compactList( GraphicalItems(), aNextImage->GraphicalItems(), m_drawingIndex );
+    m_compacted = true;
+}
+
+
+void MODULE_UNDO_IMAGE::Swap( MODULE* aModule )
+{
+    if( !m_compacted )
+    {
+        aModule->SwapContents( this );
+        return;
+    }
+
+    aModule->SwapProperties( this );
+    swapListItems( aModule->Pads(), Pads(), m_padIndex, aModule, this );
+    swapListItems( aModule->GraphicalItems(), GraphicalItems(), m_drawingIndex,
+                   aModule, this );
+    aModule->CalculateBoundingBox();
+}
+
+
+ZONE_UNDO_IMAGE::ZONE_UNDO_IMAGE( const ZONE_CONTAINER& aZone ) :
+    ZONE_CONTAINER( aZone ),
+    m_fillShared( false )
+{
+}
+
+
+void ZONE_UNDO_IMAGE::Compact( ZONE_CONTAINER* aNextImage )
+{
+    if( m_fillShared )
+        return;
+
+    if( GetFilledPolysList().GetList() != aNextImage->GetFilledPolysList().GetList() )
+        return;
+
+    const std::vector<SEGMENT>& segments = FillSegments();
+    const std::vector<SEGMENT>& other = aNextImage->FillSegments();
+
+    if( segments.size() != other.size() )
+        return;
+
+    for( unsigned ii = 0; ii < segments.size(); ii++ )
+    {
+        if( segments[ii].m_Start != other[ii].m_Start
+            || segments[ii].m_End != other[ii].m_End )
+            return;
+    }
+
+    ClearFilledPolysList();
+    std::vector<SEGMENT>().swap( FillSegments() );
+    m_fillShared = true;
+}
+
+
+void ZONE_UNDO_IMAGE::Swap( ZONE_CONTAINER* aZone )
+{
+    aZone->SwapContents( this, !m_fillShared );
+}
@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_undo_images.h
+ * @brief Copies of footprints and zones saved by the board editor undo commands.
+ */
+
+#ifndef BOARD_UNDO_IMAGES_H_
+#define BOARD_UNDO_IMAGES_H_
+
+#include <vector>
+
+#include <class_module.h>
+#include <class_zone.h>
+
+
+/**
+ * Class MODULE_UNDO_IMAGE
+ * is the copy of a footprint saved by a UR_CHANGED command.  It starts as a full copy,
+ * and Compact() reduces it to the footprint properties and the pads and drawings changed
+ * by the command, so editing one pad of a large connector does not keep a copy of all
+ * the other pads.
+ */
+class MODULE_UNDO_IMAGE : public MODULE
+{
+public:
+    MODULE_UNDO_IMAGE( const MODULE& aModule );
+
+    /**
+     * Function Compact
+     * deletes the pads and drawings identical to the ones of \a aNextImage, the copy of
+     * the same footprint saved by the next command that changes it, i.e. the footprint
+     * as it was when this command was complete.  Nothing is dropped if the pads and
+     * drawings cannot be matched one to one.  An image is compacted only once.
+     */
+    void Compact( MODULE* aNextImage );
+
+    /**
+     * Function Swap
+     * exchanges the data of this image with \a aModule.
+     */
+    void Swap( MODULE* aModule );
+
+    bool IsCompacted() const { return m_compacted; }
+
+private:
+    bool                    m_compacted;
+    std::vector<unsigned>   m_padIndex;         ///< Position in the footprint of the kept pads
+    std::vector<unsigned>   m_drawingIndex;     ///< Position in the footprint of the kept drawings
+};
+
+
+/**
+ * Class ZONE_UNDO_IMAGE
+ * is the copy of a zone saved by a UR_CHANGED command.  The filled areas, the largest part
+ * of a zone, are dropped by Compact() if the command did not change them.
+ */
+class ZONE_UNDO_IMAGE : public ZONE_CONTAINER
+{
+public:
+    ZONE_UNDO_IMAGE( const ZONE_CONTAINER& aZone );
+
+    /**
+     * Function Compact
+     * deletes the filled areas if they are identical to the ones of \a aNextImage, the
+     * copy of the same zone saved by the next command that changes it.
+     */
+    void Compact( ZONE_CONTAINER* aNextImage );
+
+    /**
+     * Function Swap
+     * exchanges the data of this image with \a aZone.
+     */
+    void Swap( ZONE_CONTAINER* aZone );
+
+    bool IsCompacted() const { return m_fillShared; }
+
+private:
+    bool    m_fillShared;   ///< The filled areas were dropped, they are the same as the zone ones
+};
+
+#endif  // BOARD_UNDO_IMAGES_H_
@@ -39,6 +39,9 @@
 #include <class_dimension.h>
 #include <class_zone.h>
 #include <class_edge_mod.h>
+#include <class_pad.h>
+#include <class_text_mod.h>
+#include <board_undo_images.h>
 
 
 /* Functions to undo and redo edit commands.
@@ -92,9 +95,162 @@
  *      mirror (Y) and flip list of items (undo/redo is made by mirror or flip items)
  *      so they are handled specifically.
  *
+ *   Copies of footprints and zones (the large items) are made as MODULE_UNDO_IMAGE and
+ *   ZONE_UNDO_IMAGE.  When a new command saves a copy of an item, this copy is the state
+ *   of the item after the previous command that changed it: the parts of the previous
+ *   copy identical to the new one are dropped, only the changed pads and drawings of a
+ *   footprint, and the filled areas of a zone if they were changed, are kept.  Undo and
+ *   redo swap the remaining data with the current item.  Copies are compared to each
+ *   other, never to the current item, which can be modified without undo command.
  */
 
 
+/**
+ * Function makeUndoImage
+ * creates the copy of \a aItem saved by a UR_CHANGED command.
+ */
+static BOARD_ITEM* makeUndoImage( BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+        return new MODULE_UNDO_IMAGE( *(MODULE*) aItem );
+
+    case PCB_ZONE_AREA_T:
+        return new ZONE_UNDO_IMAGE( *(ZONE_CONTAINER*) aItem );
+
+    default:
+        return (BOARD_ITEM*) aItem->Clone();
+    }
+}
+
+
+/**
+ * Function undoCopySize
+ * returns the estimated memory size of \a aItem, a copy held by an undo or redo command.
+ */
+static size_t undoCopySize( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = (const MODULE*) aItem;
+
+        return sizeof( MODULE ) + 2 * sizeof( TEXTE_MODULE )
+               + module->Pads().GetCount() * sizeof( D_PAD )
+               + module->GraphicalItems().GetCount() * sizeof( EDGE_MODULE );
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER*   zone = (const ZONE_CONTAINER*) aItem;
+        const CPolyLine*        outline = zone->Outline();
+
+        return sizeof( ZONE_CONTAINER ) + sizeof( CPolyLine )
+               + outline->m_CornersList.GetCornersCount() * sizeof( CPolyPt )
+               + outline->m_HatchLines.size() * sizeof( CSegment )
+               + zone->GetFilledPolysList().GetCornersCount() * sizeof( CPolyPt )
+               + zone->FillSegments().size() * sizeof( SEGMENT );
+    }
+
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+        return sizeof( SEGVIA );
+
+    case PCB_LINE_T:
+        return sizeof( DRAWSEGMENT );
+
+    case PCB_TEXT_T:
+        return sizeof( TEXTE_PCB );
+
+    case PCB_TARGET_T:
+        return sizeof( PCB_TARGET );
+
+    case PCB_DIMENSION_T:
+        return sizeof( DIMENSION );
+
+    default:
+        return sizeof( BOARD_ITEM );
+    }
+}
+
+
+/**
+ * Function updateMemoryUsage
+ * computes the estimated size of the item copies owned by \a aCommand: copies of changed
+ * items, and deleted items.
+ */
+static void updateMemoryUsage( PICKED_ITEMS_LIST* aCommand )
+{
+    size_t total = 0;
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+    {
+        EDA_ITEM* copy = NULL;
+
+        switch( aCommand->GetPickedItemStatus( ii ) )
+        {
+        case UR_CHANGED:
+            copy = aCommand->GetPickedItemLink( ii );
+            break;
+
+        case UR_DELETED:
+            copy = aCommand->GetPickedItem( ii );
+            break;
+
+        default:
+            break;
+        }
+
+        if( copy )
+            total += undoCopySize( (BOARD_ITEM*) copy );
+    }
+
+    aCommand->SetMemoryUsage( total );
+}
+
+
+/**
+ * Function compactPreviousImage
+ * drops the parts of the copy of \a aItem saved by the previous command of \a aList which
+ * are identical to \a aImage, the copy of \a aItem just made for a new command.  Only the
+ * most recent command involving \a aItem is considered, and only if it saved a copy of
+ * \a aItem: \a aImage is then the state of \a aItem when this command was complete.
+ */
+static void compactPreviousImage( UNDO_REDO_CONTAINER& aList, BOARD_ITEM* aItem,
+                                  EDA_ITEM* aImage )
+{
+    for( int cmd = (int) aList.m_CommandsList.size() - 1;  cmd >= 0;  cmd-- )
+    {
+        PICKED_ITEMS_LIST* command = aList.m_CommandsList[cmd];
+
+        for( int ii = (int) command->GetCount() - 1;  ii >= 0;  ii-- )
+        {
+            if( command->GetPickedItem( ii ) != aItem )
+                continue;
+
+            // This command moved, flipped.. the item without saving a copy: older copies
+            // cannot be compared to aImage.
+            if( command->GetPickedItemStatus( ii ) != UR_CHANGED )
+                return;
+
+            // A copy made by the caller before the command (pre-made link, e.g. by
+            // PlaceModule()) is a plain MODULE or ZONE_CONTAINER, which is never compacted.
+            EDA_ITEM* link = command->GetPickedItemLink( ii );
+
+            if( MODULE_UNDO_IMAGE* module = dynamic_cast<MODULE_UNDO_IMAGE*>( link ) )
+                module->Compact( (MODULE*) aImage );
+            else if( ZONE_UNDO_IMAGE* zone = dynamic_cast<ZONE_UNDO_IMAGE*>( link ) )
+                zone->Compact( (ZONE_CONTAINER*) aImage );
+
+            updateMemoryUsage( command );
+            return;
+        }
+    }
+}
+
+
 /**
  * Function TestForExistingItem
  * test if aItem exists somewhere in lists of items
@@ -188,19 +344,23 @@ void BOARD_ITEM::SwapData( BOARD_ITEM* aImage )
     {
     case PCB_MODULE_T:
     {
-        MODULE* tmp = (MODULE*) aImage->Clone();
-        ( (MODULE*) aImage )->Copy( (MODULE*) this );
-        ( (MODULE*) this )->Copy( tmp );
-        delete tmp;
+        MODULE_UNDO_IMAGE* image = dynamic_cast<MODULE_UNDO_IMAGE*>( aImage );
+
+        if( image )
+            image->Swap( (MODULE*) this );
+        else
+            ( (MODULE*) this )->SwapContents( (MODULE*) aImage );
     }
         break;
 
     case PCB_ZONE_AREA_T:
     {
-        ZONE_CONTAINER* tmp = (ZONE_CONTAINER*) aImage->Clone();
-        ( (ZONE_CONTAINER*) aImage )->Copy( (ZONE_CONTAINER*) this );
-        ( (ZONE_CONTAINER*) this )->Copy( tmp );
-        delete tmp;
+        ZONE_UNDO_IMAGE* image = dynamic_cast<ZONE_UNDO_IMAGE*>( aImage );
+
+        if( image )
+            image->Swap( (ZONE_CONTAINER*) this );
+        else
+            ( (ZONE_CONTAINER*) this )->SwapContents( (ZONE_CONTAINER*) aImage );
     }
         break;
 
@@ -292,6 +452,9 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( BOARD_ITEM*    aItem,
     if( aItem == NULL )     // Nothing to save
         return;
 
+    // The item is about to be modified in place
+    GetBoard()->InvalidateSpatialIndex();
+
     PICKED_ITEMS_LIST* commandToUndo = new PICKED_ITEMS_LIST();
 
     commandToUndo->m_TransformPoint = aTransformPoint;
@@ -302,7 +465,11 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( BOARD_ITEM*    aItem,
     {
     case UR_CHANGED:                        // Create a copy of item
         if( itemWrapper.GetLink() == NULL ) // When not null, the copy is already done
-            itemWrapper.SetLink( aItem->Clone() );
+        {
+            itemWrapper.SetLink( makeUndoImage( aItem ) );
+            compactPreviousImage( GetScreen()->m_UndoList, aItem, itemWrapper.GetLink() );
+        }
+
         commandToUndo->PushItem( itemWrapper );
         break;
 
@@ -333,6 +500,8 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( BOARD_ITEM*    aItem,
 
     if( commandToUndo->GetCount() )
     {
+        updateMemoryUsage( commandToUndo );
+
         /* Save the copy in undo list */
         GetScreen()->PushCommandToUndoList( commandToUndo );
 
@@ -350,6 +519,9 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( PICKED_ITEMS_LIST& aItemsList,
                                          UNDO_REDO_T        aTypeCommand,
                                          const wxPoint&     aTransformPoint )
 {
+    // The items are about to be modified in place
+    GetBoard()->InvalidateSpatialIndex();
+
     PICKED_ITEMS_LIST* commandToUndo = new PICKED_ITEMS_LIST();
 
     commandToUndo->m_TransformPoint = aTransformPoint;
@@ -380,7 +552,11 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( PICKED_ITEMS_LIST& aItemsList,
              * If this link is not null, the copy is already done
              */
             if( commandToUndo->GetPickedItemLink( ii ) == NULL )
-                commandToUndo->SetPickedItemLink( item->Clone(), ii );
+            {
+                commandToUndo->SetPickedItemLink( makeUndoImage( item ), ii );
+                compactPreviousImage( GetScreen()->m_UndoList, item,
+                                      commandToUndo->GetPickedItemLink( ii ) );
+            }
             break;
 
         case UR_MOVED:
@@ -405,6 +581,8 @@ void PCB_EDIT_FRAME::SaveCopyInUndoList( PICKED_ITEMS_LIST& aItemsList,
 
     if( commandToUndo->GetCount() )
     {
+        updateMemoryUsage( commandToUndo );
+
         /* Save the copy in undo list */
         GetScreen()->PushCommandToUndoList( commandToUndo );
 
@@ -531,6 +709,9 @@ void PCB_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool aRed
     if( not_found )
         wxMessageBox( wxT( "Incomplete undo/redo operation: some items not found" ) );
 
+    // Items have been swapped or moved in place
+    GetBoard()->InvalidateSpatialIndex();
+
     // Rebuild pointers and ratsnest that can be changed.
     if( reBuild_ratsnest && aRebuildRatsnet )
         Compile_Ratsnest( NULL, true );
@@ -549,6 +730,7 @@ void PCB_EDIT_FRAME::GetBoardFromUndoList( wxCommandEvent& event )
 
     /* Put the old list in RedoList */
     List->ReversePickersListOrder();
+    updateMemoryUsage( List );
     GetScreen()->PushCommandToRedoList( List );
 
     OnModify();
@@ -570,6 +752,7 @@ void PCB_EDIT_FRAME::GetBoardFromRedoList( wxCommandEvent& event )
 
     /* Put the old list in UndoList */
     List->ReversePickersListOrder();
+    updateMemoryUsage( List );
     GetScreen()->PushCommandToUndoList( List );
 
     OnModify();
@@ -53,6 +53,9 @@
 #include <class_track.h>
 #include <class_zone.h>
 #include <class_marker_pcb.h>
+#include <module_index.h>
+
+#include <boost/unordered/unordered_map.hpp>
 
 
 /* This is an odd place for this, but CvPcb won't link if it is
@@ -187,6 +190,7 @@ void BOARD::chainMarkedSegments( wxPoint aPosition, LAYER_MSK aLayerMask, TRACK_
     TRACK* via;                 // The via identified, eventually destroy
     TRACK* candidate;           // The end segment to destroy (or NULL = segment)
     int NbSegm;
+    std::vector<TRACK*> connected;
 
     if( m_Track == NULL )
         return;
@@ -216,13 +220,24 @@ void BOARD::chainMarkedSegments( wxPoint aPosition, LAYER_MSK aLayerMask, TRACK_
          * is found we do not know at this time the number of connected items
          * and we do not know if this via is on the track or finish the track
          */
-        via = m_Track->GetVia( NULL, aPosition, aLayerMask );
+        getConnectedTracks( aPosition, aLayerMask, connected );
+        via = NULL;
+
+        for( unsigned i = 0; i < connected.size(); ++i )
+        {
+            if( connected[i]->Type() == PCB_VIA_T )
+            {
+                via = connected[i];
+                break;
+            }
+        }
 
         if( via )
         {
             aLayerMask = via->GetLayerMask();
 
             aList->push_back( via );
+            getConnectedTracks( aPosition, aLayerMask, connected );
         }
 
         /* Now we search all segments connected to point aPosition
@@ -230,29 +245,21 @@ void BOARD::chainMarkedSegments( wxPoint aPosition, LAYER_MSK aLayerMask, TRACK_
          *  if > 1 segment:
          *      end of track (more than 2 segment connected at this location)
          */
-        segment = m_Track; candidate = NULL;
-        NbSegm  = 0;
+        candidate = NULL;
+        NbSegm    = 0;
 
-        while( ( segment = ::GetTrace( segment, NULL, aPosition, aLayerMask ) ) != NULL )
+        for( unsigned i = 0; i < connected.size(); ++i )
         {
-            if( segment->GetState( BUSY ) ) // already found and selected: skip it
-            {
-                segment = segment->Next();
-                continue;
-            }
+            segment = connected[i];
 
             if( segment == via ) // just previously found: skip it
-            {
-                segment = segment->Next();
                 continue;
-            }
 
             NbSegm++;
 
             if( NbSegm == 1 ) /* First time we found a connected item: segment is candidate */
             {
                 candidate = segment;
-                segment = segment->Next();
             }
             else /* More than 1 segment connected -> this location is an end of the track */
             {
@@ -277,8 +284,6 @@ void BOARD::chainMarkedSegments( wxPoint aPosition, LAYER_MSK aLayerMask, TRACK_
                 aPosition = candidate->GetStart();
             }
 
-            segment = m_Track; /* restart list of tracks to analyze */
-
             /* flag this item an push it in list of selected items */
             aList->push_back( candidate );
             candidate->SetState( BUSY, true );
@@ -776,6 +781,9 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, int aControl )
         return;
     }
 
+    // An up to date index is updated, otherwise it is rebuilt when needed
+    bool indexed = m_spatialIndex.IsUpToDate( this );
+
     switch( aBoardItem->Type() )
     {
     // this one uses a vector
@@ -842,6 +850,36 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, int aControl )
         }
         break;
     }
+
+    if( indexed )
+        m_spatialIndex.Add( aBoardItem, this );
+}
+
+
+void BOARD::AddTracks( const TRACK_PTRS& aTracks )
+{
+    TRACK* insertAid = m_Track;
+
+    for( unsigned ii = 0; ii < aTracks.size(); ii++ )
+    {
+        TRACK* track = aTracks[ii];
+
+        wxASSERT( track->Type() == PCB_TRACE_T || track->Type() == PCB_VIA_T );
+        wxASSERT_MSG( ii == 0 || aTracks[ii - 1]->GetNet() <= track->GetNet(),
+                      wxT( "BOARD::AddTracks() tracks not sorted by net" ) );
+
+        // Before the first track of the net, as TRACK::GetBestInsertPoint() does, but
+        // insertAid stays there, so the next tracks of the net follow this one.
+        while( insertAid && insertAid->GetNet() < track->GetNet() )
+            insertAid = insertAid->Next();
+
+        track->SetParent( this );
+        m_Track.Insert( track, insertAid );
+    }
+
+    // Cheaper to rebuild it than to add each track
+    if( aTracks.size() )
+        m_spatialIndex.Invalidate();
 }
 
 
@@ -850,6 +888,8 @@ BOARD_ITEM* BOARD::Remove( BOARD_ITEM* aBoardItem )
     // find these calls and fix them!  Don't send me no stinking' NULL.
     wxASSERT( aBoardItem );
 
+    bool indexed = m_spatialIndex.IsUpToDate( this );
+
     switch( aBoardItem->Type() )
     {
     case PCB_MARKER_T:
@@ -905,6 +945,9 @@ BOARD_ITEM* BOARD::Remove( BOARD_ITEM* aBoardItem )
         wxFAIL_MSG( wxT( "BOARD::Remove() needs more ::Type() support" ) );
     }
 
+    if( indexed )
+        m_spatialIndex.Remove( aBoardItem, this );
+
     return aBoardItem;
 }
 
@@ -1198,12 +1241,12 @@ SEARCH_RESULT BOARD::Visit( INSPECTOR* inspector, const void* testData,
 
 #else
         case PCB_VIA_T:
-            result = IterateForward( m_Track, inspector, testData, p );
+            result = visitTracks( inspector, testData, p );
             ++p;
             break;
 
         case PCB_TRACE_T:
-            result = IterateForward( m_Track, inspector, testData, p );
+            result = visitTracks( inspector, testData, p );
             ++p;
             break;
 #endif
@@ -1254,6 +1297,68 @@ SEARCH_RESULT BOARD::Visit( INSPECTOR* inspector, const void* testData,
 }
 
 
+SEARCH_RESULT BOARD::visitTracks( INSPECTOR* inspector, const void* testData,
+                                  const KICAD_T scanTypes[] )
+{
+    EDA_RECT area;
+
+    if( !inspector->GetSearchArea( area ) )
+        return IterateForward( m_Track, inspector, testData, scanTypes );
+
+    std::vector<TRACK*> candidates;
+    BOARD_SPATIAL_INDEX& index = GetSpatialIndex();
+
+    index.QueryVias( area, candidates );
+    index.QuerySegments( area, ALL_LAYERS, candidates );
+
+    for( unsigned i = 0; i < candidates.size(); ++i )
+    {
+        if( candidates[i]->Visit( inspector, testData, scanTypes ) == SEARCH_QUIT )
+            return SEARCH_QUIT;
+    }
+
+    return SEARCH_CONTINUE;
+}
+
+
+BOARD_SPATIAL_INDEX& BOARD::GetSpatialIndex()
+{
+    if( !m_spatialIndex.IsUpToDate( this ) )
+        m_spatialIndex.Build( this );
+
+    return m_spatialIndex;
+}
+
+
+void BOARD::getConnectedTracks( const wxPoint& aPosition, LAYER_MSK aLayerMask,
+                                std::vector<TRACK*>& aList )
+{
+    std::vector<TRACK*>  candidates;
+    BOARD_SPATIAL_INDEX& index = GetSpatialIndex();
+    EDA_RECT             area( aPosition, wxSize( 0, 0 ) );
+
+    index.QueryVias( area, candidates );
+    index.QuerySegments( area, aLayerMask, candidates );
+
+    aList.clear();
+
+    // Same criteria as ::GetTrace()
+    for( unsigned i = 0; i < candidates.size(); ++i )
+    {
+        TRACK* track = candidates[i];
+
+        if( track->GetState( BUSY | IS_DELETED ) )
+            continue;
+
+        if( aPosition != track->GetStart() && aPosition != track->GetEnd() )
+            continue;
+
+        if( aLayerMask & track->GetLayerMask() )
+            aList.push_back( track );
+    }
+}
+
+
 /*  now using PcbGeneralLocateAndDisplay(), but this remains a useful example
  *   of how the INSPECTOR can be used in a lightweight way.
  *  // see pcbstruct.h
@@ -1629,12 +1734,13 @@ int BOARD::SetAreasNetCodesFromNetNames( void )
 
 TRACK* BOARD::GetViaByPosition( const wxPoint& aPosition, LAYER_NUM aLayer)
 {
-    TRACK* track;
+    std::vector<TRACK*> vias;
+
+    GetSpatialIndex().QueryVias( EDA_RECT( aPosition, wxSize( 0, 0 ) ), vias );
 
-    for( track = m_Track;  track; track = track->Next() )
+    for( unsigned i = 0; i < vias.size(); ++i )
     {
-        if( track->Type() != PCB_VIA_T )
-            continue;
+        TRACK* track = vias[i];
 
         if( track->GetStart() != aPosition )
             continue;
@@ -1642,28 +1748,26 @@ TRACK* BOARD::GetViaByPosition( const wxPoint& aPosition, LAYER_NUM aLayer)
         if( track->GetState( BUSY | IS_DELETED ) )
             continue;
 
-        if( aLayer == UNDEFINED_LAYER )
-            break;
-
-        if( track->IsOnLayer( aLayer ) )
-            break;
+        if( aLayer == UNDEFINED_LAYER || track->IsOnLayer( aLayer ) )
+            return track;
     }
 
-    return track;
+    return NULL;
 }
 
 
 D_PAD* BOARD::GetPad( const wxPoint& aPosition, LAYER_MSK aLayerMask )
 {
-    D_PAD* pad = NULL;
+    D_PAD*               pad = NULL;
+    std::vector<MODULE*> modules;
 
-    for( MODULE* module = m_Modules;  module && ( pad == NULL );  module = module->Next() )
-    {
-        if( aLayerMask )
-            pad = module->GetPad( aPosition, aLayerMask );
-        else
-            pad = module->GetPad( aPosition, ALL_LAYERS );
-    }
+    if( aLayerMask == 0 )
+        aLayerMask = ALL_LAYERS;
+
+    GetSpatialIndex().QueryModules( EDA_RECT( aPosition, wxSize( 0, 0 ) ), modules );
+
+    for( unsigned i = 0; i < modules.size() && pad == NULL; ++i )
+        pad = modules[i]->GetPad( aPosition, aLayerMask );
 
     return pad;
 }
@@ -1685,13 +1789,12 @@ D_PAD* BOARD::GetPad( TRACK* aTrace, int aEndPoint )
         aPosition = aTrace->GetEnd();
     }
 
-    for( MODULE* module = m_Modules;  module;  module = module->Next() )
-    {
-        pad = module->GetPad( aPosition, aLayerMask );
+    std::vector<MODULE*> modules;
 
-        if( pad != NULL )
-            break;
-    }
+    GetSpatialIndex().QueryModules( EDA_RECT( aPosition, wxSize( 0, 0 ) ), modules );
+
+    for( unsigned i = 0; i < modules.size() && pad == NULL; ++i )
+        pad = modules[i]->GetPad( aPosition, aLayerMask );
 
     return pad;
 }
@@ -1843,31 +1946,48 @@ void BOARD::GetSortedPadListByXthenYCoord( std::vector<D_PAD*>& aVector, int aNe
 }
 
 
+bool BOARD::isTraceHit( TRACK* aTrack, const wxPoint& aPosition, LAYER_MSK aLayerMask ) const
+{
+    LAYER_NUM layer = aTrack->GetLayer();
+
+    if( aTrack->GetState( BUSY | IS_DELETED ) )
+        return false;
+
+    if( m_designSettings.IsLayerVisible( layer ) == false )
+        return false;
+
+    if( aTrack->Type() != PCB_VIA_T && ( GetLayerMask( layer ) & aLayerMask ) == 0 )
+        return false;   /* Segments on different layers. */
+
+    return aTrack->HitTest( aPosition );
+}
+
+
 TRACK* BOARD::GetTrace( TRACK* aTrace, const wxPoint& aPosition, LAYER_MSK aLayerMask )
 {
-    for( TRACK* track = aTrace;   track;  track =  track->Next() )
+    if( aTrace && aTrace == m_Track.GetFirst() )
     {
-        LAYER_NUM layer = track->GetLayer();
+        // The whole list is searched, the spatial index gives the same candidates
+        std::vector<TRACK*>  candidates;
+        BOARD_SPATIAL_INDEX& index = GetSpatialIndex();
+        EDA_RECT             area( aPosition, wxSize( 0, 0 ) );
 
-        if( track->GetState( BUSY | IS_DELETED ) )
-            continue;
+        index.QueryVias( area, candidates );
+        index.QuerySegments( area, aLayerMask, candidates );
 
-        if( m_designSettings.IsLayerVisible( layer ) == false )
-            continue;
-
-        if( track->Type() == PCB_VIA_T )    /* VIA encountered. */
+        for( unsigned i = 0; i < candidates.size(); ++i )
         {
-            if( track->HitTest( aPosition ) )
-                return track;
+            if( isTraceHit( candidates[i], aPosition, aLayerMask ) )
+                return candidates[i];
         }
-        else
-        {
-            if( (GetLayerMask( layer ) & aLayerMask) == 0 )
-                continue;   /* Segments on different layers. */
 
-            if( track->HitTest( aPosition ) )
-                return track;
-        }
+        return NULL;
+    }
+
+    for( TRACK* track = aTrace;   track;  track =  track->Next() )
+    {
+        if( isTraceHit( track, aPosition, aLayerMask ) )
+            return track;
     }
 
     return NULL;
@@ -1911,20 +2031,18 @@ TRACK* BOARD::MarkTrace( TRACK*  aTrace, int* aCount,
      */
     if( aTrace->Type() == PCB_VIA_T )
     {
-        TRACK* Segm1, * Segm2 = NULL, * Segm3 = NULL;
-        Segm1 = ::GetTrace( m_Track, NULL, aTrace->GetStart(), layerMask );
+        TRACK* Segm1 = NULL, * Segm2 = NULL;
+        std::vector<TRACK*> connected;
 
-        if( Segm1 )
-        {
-            Segm2 = ::GetTrace( Segm1->Next(), NULL, aTrace->GetStart(), layerMask );
-        }
+        getConnectedTracks( aTrace->GetStart(), layerMask, connected );
 
-        if( Segm2 )
-        {
-            Segm3 = ::GetTrace( Segm2->Next(), NULL, aTrace->GetStart(), layerMask );
-        }
+        if( connected.size() > 0 )
+            Segm1 = connected[0];
 
-        if( Segm3 ) // More than 2 segments are connected to this via. the track" is only this via
+        if( connected.size() > 1 )
+            Segm2 = connected[1];
+
+        if( connected.size() > 2 ) // More than 2 segments are connected to this via. the track" is only this via
         {
             if( aCount )
                 *aCount = 1;
@@ -1969,12 +2087,13 @@ TRACK* BOARD::MarkTrace( TRACK*  aTrace, int* aCount,
 
         layerMask = via->GetLayerMask();
 
-        TRACK* track = ::GetTrace( m_Track, NULL, via->GetStart(), layerMask );
+        std::vector<TRACK*> connected;
+        getConnectedTracks( via->GetStart(), layerMask, connected );
 
-        // GetTrace does not consider tracks flagged BUSY.
+        // getConnectedTracks does not consider tracks flagged BUSY.
         // So if no connected track found, this via is on the current track
         // only: keep it
-        if( track == NULL )
+        if( connected.empty() )
             continue;
 
         /* If a track is found, this via connects also others segments of an
@@ -1989,11 +2108,11 @@ TRACK* BOARD::MarkTrace( TRACK*  aTrace, int* aCount,
          * if there are on the same layer, the via is on the selected track
          * if there are on different layers, the via is on an other track
          */
-        LAYER_NUM layer = track->GetLayer();
+        LAYER_NUM layer = connected[0]->GetLayer();
 
-        while( ( track = ::GetTrace( track->Next(), NULL, via->GetStart(), layerMask ) ) != NULL )
+        for( unsigned j = 1; j < connected.size(); ++j )
         {
-            if( layer != track->GetLayer() )
+            if( layer != connected[j]->GetLayer() )
             {
                 // The via connects segments of an other track: it is removed
                 // from list because it is member of an other track
@@ -2124,8 +2243,13 @@ MODULE* BOARD::GetFootprint( const wxPoint& aPosition, LAYER_NUM aActiveLayer,
     int     alt_min_dim = 0x7FFFFFFF;
     bool    current_layer_back = IsBackLayer( aActiveLayer );
 
-    for( pt_module = m_Modules;  pt_module;  pt_module = (MODULE*) pt_module->Next() )
+    std::vector<MODULE*> candidates;
+    GetSpatialIndex().QueryModules( EDA_RECT( aPosition, wxSize( 0, 0 ) ), candidates );
+
+    for( unsigned i = 0; i < candidates.size(); ++i )
     {
+        pt_module = candidates[i];
+
         // is the ref point within the module's bounds?
         if( !pt_module->HitTest( aPosition ) )
             continue;
@@ -2184,21 +2308,26 @@ MODULE* BOARD::GetFootprint( const wxPoint& aPosition, LAYER_NUM aActiveLayer,
 
 BOARD_CONNECTED_ITEM* BOARD::GetLockPoint( const wxPoint& aPosition, LAYER_MSK aLayerMask )
 {
-    for( MODULE* module = m_Modules; module; module = module->Next() )
+    std::vector<MODULE*> modules;
+
+    GetSpatialIndex().QueryModules( EDA_RECT( aPosition, wxSize( 0, 0 ) ), modules );
+
+    for( unsigned i = 0; i < modules.size(); ++i )
     {
-        D_PAD* pad = module->GetPad( aPosition, aLayerMask );
+        D_PAD* pad = modules[i]->GetPad( aPosition, aLayerMask );
 
         if( pad )
             return pad;
     }
 
     /* No pad has been located so check for a segment of the trace. */
-    TRACK* segment = ::GetTrace( m_Track, NULL, aPosition, aLayerMask );
+    std::vector<TRACK*> connected;
+    getConnectedTracks( aPosition, aLayerMask, connected );
 
-    if( segment == NULL )
-        segment = GetTrace( m_Track, aPosition, aLayerMask );
+    if( !connected.empty() )
+        return connected[0];
 
-    return segment;
+    return GetTrace( m_Track, aPosition, aLayerMask );
 }
 
 
@@ -2430,6 +2559,9 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
 
     m_Status_Pcb = 0;
 
+    // Looking up each component with FindModule() would walk the module list every time.
+    MODULE_INDEX modules( this );
+
     for( i = 0;  i < aNetlist.GetCount();  i++ )
     {
         COMPONENT* component = aNetlist.GetComponent( i );
@@ -2452,9 +2584,9 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
         }
 
         if( aNetlist.IsFindByTimeStamp() )
-            footprint = FindModule( aNetlist.GetComponent( i )->GetTimeStamp(), true );
+            footprint = modules.FindModule( aNetlist.GetComponent( i )->GetTimeStamp(), true );
         else
-            footprint = FindModule( aNetlist.GetComponent( i )->GetReference() );
+            footprint = modules.FindModule( aNetlist.GetComponent( i )->GetReference() );
 
         if( footprint == NULL )        // A new footprint.
         {
@@ -2491,6 +2623,7 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
                 footprint->SetPosition( bestPosition );
                 footprint->SetTimeStamp( GetNewTimeStamp() );
                 Add( footprint, ADD_APPEND );
+                modules.Append( footprint );
             }
         }
         else                           // An existing footprint.
@@ -2539,8 +2672,10 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
                             newFootprint->SetPath( footprint->GetPath() );
 
                         footprint->CopyNetlistSettings( newFootprint );
+                        modules.Remove( footprint );
                         Remove( footprint );
                         Add( newFootprint, ADD_APPEND );
+                        modules.Append( newFootprint );
                         footprint = newFootprint;
                     }
                 }
@@ -2559,7 +2694,10 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
                 }
 
                 if( !aNetlist.IsDryRun() )
+                {
                     footprint->SetReference( component->GetReference() );
+                    modules.Update( footprint );
+                }
             }
 
             // Test for value field change.
@@ -2592,7 +2730,10 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
                 }
 
                 if( !aNetlist.IsDryRun() )
+                {
                     footprint->SetPath( component->GetTimeStamp() );
+                    modules.Update( footprint );
+                }
             }
         }
 
@@ -2650,6 +2791,23 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
         MODULE* nextModule;
         const COMPONENT* component;
 
+        // The first component of each reference and time stamp, as NETLIST::GetComponentBy...()
+        // would find them.
+        typedef boost::unordered_map< wxString, const COMPONENT*,
+                                      wxStringHash, wxStringEqual > COMPONENT_MAP;
+
+        COMPONENT_MAP byKey;
+
+        for( i = 0; i < aNetlist.GetCount(); i++ )
+        {
+            component = aNetlist.GetComponent( i );
+
+            const wxString& key = aNetlist.IsFindByTimeStamp() ? component->GetTimeStamp()
+                                                                : component->GetReference();
+
+            byKey.insert( std::make_pair( key, component ) );
+        }
+
         for( MODULE* module = m_Modules;  module != NULL;  module = nextModule )
         {
             nextModule = module->Next();
@@ -2657,12 +2815,11 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
             if( module->IsLocked() )
                 continue;
 
-            if( aNetlist.IsFindByTimeStamp() )
-                component = aNetlist.GetComponentByTimeStamp( module->GetPath() );
-            else
-                component = aNetlist.GetComponentByReference( module->GetReference() );
+            COMPONENT_MAP::const_iterator it = byKey.find( aNetlist.IsFindByTimeStamp() ?
+                                                           module->GetPath() :
+                                                           module->GetReference() );
 
-            if( component == NULL )
+            if( it == byKey.end() )
             {
                 if( aReporter && aReporter->ReportWarnings() )
                 {
@@ -2673,7 +2830,10 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
                 }
 
                 if( !aNetlist.IsDryRun() )
+                {
+                    modules.Remove( module );
                     module->DeleteStructure();
+                }
             }
         }
     }
@@ -2737,7 +2897,7 @@ void BOARD::ReplaceNetlist( NETLIST& aNetlist, bool aDeleteSinglePadNets,
         for( i = 0; i < aNetlist.GetCount(); i++ )
         {
             const COMPONENT* component = aNetlist.GetComponent( i );
-            MODULE* footprint = FindModuleByReference( component->GetReference() );
+            MODULE* footprint = modules.FindModuleByReference( component->GetReference() );
 
             if( footprint == NULL )    // It can be missing in partial designs
                 continue;
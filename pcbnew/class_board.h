@@ -42,6 +42,7 @@
 #include <class_title_block.h>
 #include <class_zone_settings.h>
 #include <pcb_plot_params.h>
+#include <board_spatial_index.h>
 
 
 class PCB_BASE_FRAME;
@@ -252,6 +253,31 @@ private:
     // Index for m_TrackWidthList to select the value.
     unsigned                m_trackWidthIndex;
 
+    /// Tracks, vias and modules by position, use GetSpatialIndex() to access it.
+    BOARD_SPATIAL_INDEX     m_spatialIndex;
+
+    /**
+     * Function visitTracks
+     * calls Visit() on items of m_Track. If the inspector is interested only in a limited
+     * area, items outside of it are skipped using the spatial index.
+     */
+    SEARCH_RESULT visitTracks( INSPECTOR* inspector, const void* testData,
+                               const KICAD_T scanTypes[] );
+
+    /**
+     * Function getConnectedTracks
+     * fills \a aList with tracks and vias having an end at \a aPosition on \a aLayerMask,
+     * skipping the ones flagged BUSY or IS_DELETED (the same criteria as ::GetTrace()).
+     */
+    void getConnectedTracks( const wxPoint& aPosition, LAYER_MSK aLayerMask,
+                             std::vector<TRACK*>& aList );
+
+    /**
+     * Function isTraceHit
+     * tells if \a aTrack is a GetTrace() match for \a aPosition and \a aLayerMask.
+     */
+    bool isTraceHit( TRACK* aTrack, const wxPoint& aPosition, LAYER_MSK aLayerMask ) const;
+
     /**
      * Function chainMarkedSegments
      * is used by MarkTrace() to set the BUSY flag of connected segments of the trace
@@ -334,6 +360,21 @@ public:
 
 #define ADD_APPEND 1        ///< aControl flag for Add( aControl ), appends not inserts
 
+    /**
+     * Function AddTracks
+     * adds a batch of tracks and vias to this BOARD and takes ownership of their memory.
+     * They are spliced into m_Track in a single pass, instead of looking for the insertion
+     * point of each of them like Add() does.  Each net goes to the same place in the list
+     * as with Add(), before the tracks of this net which are already on the board, but its
+     * tracks keep the batch order, while repeated Add() calls would reverse it.
+     *
+     * The spatial index is rebuilt on the next lookup, and the connectivity is not
+     * updated: the caller has to do it once the batch is added (or to clear m_Status_Pcb).
+     *
+     * @param aTracks The tracks and vias to add, sorted by net code.
+     */
+    void AddTracks( const TRACK_PTRS& aTracks );
+
     /**
      * Function Delete
      * removes the given single item from this BOARD and deletes its memory.
@@ -913,6 +954,33 @@ public:
     SEARCH_RESULT Visit( INSPECTOR* inspector, const void* testData,
                          const KICAD_T scanTypes[] );
 
+    /**
+     * Function GetSpatialIndex
+     * returns the index of tracks, vias and modules by position. It is rebuilt if the
+     * track or module lists have been modified other than by Add() or Remove().
+     */
+    BOARD_SPATIAL_INDEX& GetSpatialIndex();
+
+    /**
+     * Function InvalidateSpatialIndex
+     * has to be called after tracks or modules have been moved, resized or changed layer
+     * without being removed from the board, so the index is rebuilt before the next lookup.
+     */
+    void InvalidateSpatialIndex()
+    {
+        m_spatialIndex.Invalidate();
+    }
+
+    /**
+     * Function UpdateSpatialIndex
+     * re-indexes \a aItem after it has been moved, resized or put on an other layer.
+     * It is called by the track and module setters, see BOARD_ITEM::updateSpatialIndex().
+     */
+    void UpdateSpatialIndex( BOARD_ITEM* aItem )
+    {
+        m_spatialIndex.Update( aItem );
+    }
+
     /**
      * Function FindModuleByReference
      * searches for a MODULE within this board with the given
@@ -50,6 +50,15 @@ wxString BOARD_ITEM::ShowShape( STROKE_T aShape )
 }
 
 
+void BOARD_ITEM::updateSpatialIndex()
+{
+    BOARD_ITEM* parent = GetParent();
+
+    if( parent && parent->Type() == PCB_T )
+        static_cast<BOARD*>( parent )->UpdateSpatialIndex( this );
+}
+
+
 void BOARD_ITEM::UnLink()
 {
     DLIST<BOARD_ITEM>* list = (DLIST<BOARD_ITEM>*) GetList();
@@ -86,84 +95,97 @@ wxString BOARD_ITEM::GetLayerName() const
 }
 
 
-std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+/// Number of decimals of a value in millimeters, IU_PER_MM being a power of 10.
+static const int IU_DECIMALS = KiROUND( log10( IU_PER_MM ) );
+
+
+int BOARD_ITEM::FormatInternalUnits( int aValue, char* aBuffer )
 {
 #if 1
 
-    char    buf[50];
-    int     len;
-    double  mm = aValue / IU_PER_MM;
+    // Write the integer digits and insert the decimal point, without any floating point
+    // operation nor printf().  The text is the exact value in millimeters with trailing zeros
+    // removed, which is the same as the general purpose algorithm below gives, because an int
+    // does not have more than the 10 significant digits printed by "%.10g".
 
-    if( mm != 0.0 && fabs( mm ) <= 0.0001 )
+    char*       out   = aBuffer;
+    unsigned    value = aValue < 0 ? 0u - (unsigned) aValue : (unsigned) aValue;
+    char        digits[16];         // least significant digit first
+    int         count = 0;
+
+    if( aValue < 0 )
+        *out++ = '-';
+
+    do
     {
-        len = sprintf( buf, "%.10f", mm );
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while( value );
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+    // Skip the trailing zeros of the decimals
+    int last = 0;
 
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-            ++len;
+    while( last < IU_DECIMALS && ( last >= count || digits[last] == '0' ) )
+        last++;
+
+    if( count > IU_DECIMALS )
+    {
+        for( int ii = count - 1; ii >= IU_DECIMALS; ii-- )
+            *out++ = digits[ii];
     }
     else
     {
-        len = sprintf( buf, "%.10g", mm );
+        *out++ = '0';
     }
 
-    return std::string( buf, len );
+    if( last < IU_DECIMALS )
+    {
+        *out++ = '.';
 
-#else
+        for( int ii = IU_DECIMALS - 1; ii >= last; ii-- )
+            *out++ = ii < count ? digits[ii] : '0';
+    }
 
-    // Assume aValue is in nanometers, and that we want the result in millimeters,
-    // and that int is 32 bits wide.  Then perform an alternative algorithm.
-    // Can be used to verify that the above algorithm is correctly generating text.
-    // Convert aValue into an integer string, then insert a decimal point manually.
-    // Results are the same as above general purpose algorithm.
+    *out = '\0';
 
-    wxASSERT( sizeof(int) == 4 );
+    return out - aBuffer;
 
-    if( aValue == 0 )
-        return std::string( 1, '0' );
-    else
-    {
-        char    buf[50];
-        int     len = sprintf( buf, aValue > 0 ? "%06d" : "%07d", aValue );     // optionally pad w/leading zeros
+#else
 
-        std::string ret( buf, len );
+    // General purpose algorithm, the reference of the one above.
 
-        std::string::iterator it = ret.end() - 1;           // last byte
+    int     len;
+    double  mm = aValue / IU_PER_MM;
 
-        // insert '.' at 6 positions from end, dividing by 10e6 (a million), nm => mm
-        std::string::iterator decpoint = ret.end() - 6;
+    if( mm != 0.0 && fabs( mm ) <= 0.0001 )
+    {
+        len = sprintf( aBuffer, "%.10f", mm );
 
-        // truncate trailing zeros, up to decimal point position
-        for(  ; *it=='0' && it >= decpoint;  --it )
-            ret.erase( it );    // does not invalidate iterators it or decpoint
+        while( --len > 0 && aBuffer[len] == '0' )
+            aBuffer[len] = '\0';
 
-        if( it >= decpoint )
-        {
-            ret.insert( decpoint, '.' );
+        if( aBuffer[len] == '.' )
+            aBuffer[len] = '\0';
+        else
+            ++len;
+    }
+    else
+    {
+        len = sprintf( aBuffer, "%.10g", mm );
+    }
 
-            // decpoint is invalidated here, after insert()
+    return len;
 
-#if 1       // want a leading zero when decimal point is in first position?
-            if( ret[0] == '.' )
-            {
-                // insert leading zero ahead of decimal point.
-                ret.insert( ret.begin(), '0' );
-            }
-            else if( ret[0]=='-' && ret[1]=='.' )
-            {
-                ret.insert( ret.begin() + 1, '0' );
-            }
 #endif
-        }
+}
 
-        return ret;
-    }
 
-#endif
+std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+{
+    char    buf[FMT_IU_BUFSIZE];
+    int     len = FormatInternalUnits( aValue, buf );
+
+    return std::string( buf, len );
 }
 
 
@@ -177,15 +199,28 @@ std::string BOARD_ITEM::FormatAngle( double aAngle )
 }
 
 
+int BOARD_ITEM::FormatInternalUnits( const wxPoint& aPoint, char* aBuffer )
+{
+    int len = FormatInternalUnits( aPoint.x, aBuffer );
+
+    aBuffer[len++] = ' ';
+
+    return len + FormatInternalUnits( aPoint.y, aBuffer + len );
+}
+
+
 std::string BOARD_ITEM::FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    char    buf[2 * FMT_IU_BUFSIZE];
+    int     len = FormatInternalUnits( aPoint, buf );
+
+    return std::string( buf, len );
 }
 
 
 std::string BOARD_ITEM::FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    return FormatInternalUnits( wxPoint( aSize.GetWidth(), aSize.GetHeight() ) );
 }
 
 
@@ -90,6 +90,25 @@ void EDGE_MODULE::Copy( EDGE_MODULE* source )
 }
 
 
+bool EDGE_MODULE::IsSameAs( const EDGE_MODULE& aEdge ) const
+{
+    return m_Start == aEdge.m_Start
+           && m_End == aEdge.m_End
+           && m_Start0 == aEdge.m_Start0
+           && m_End0 == aEdge.m_End0
+           && m_Shape == aEdge.m_Shape
+           && m_Width == aEdge.m_Width
+           && m_Type == aEdge.m_Type
+           && m_Angle == aEdge.m_Angle
+           && m_BezierC1 == aEdge.m_BezierC1
+           && m_BezierC2 == aEdge.m_BezierC2
+           && m_BezierPoints == aEdge.m_BezierPoints
+           && m_PolyPoints == aEdge.m_PolyPoints
+           && GetLayer() == aEdge.GetLayer()
+           && GetTimeStamp() == aEdge.GetTimeStamp();
+}
+
+
 void EDGE_MODULE::SetDrawCoord()
 {
     MODULE* module = (MODULE*) m_Parent;
@@ -59,6 +59,13 @@ public:
 
     void Copy( EDGE_MODULE* source );           // copy structure
 
+    /**
+     * Function IsSameAs
+     * tests if this drawing and \a aEdge have the same shape and position, layer and
+     * time stamp.  Used by undo/redo to drop unchanged drawings from the footprint copies.
+     */
+    bool IsSameAs( const EDGE_MODULE& aEdge ) const;
+
     void SetStart0( const wxPoint& aPoint )     { m_Start0 = aPoint; }
     const wxPoint& GetStart0() const            { return m_Start0; }
 
@@ -295,6 +295,82 @@ void MODULE::Copy( MODULE* aModule )
 }
 
 
+/**
+ * Function swapLists
+ * exchanges the items of two lists owned by different parents, without copying them.
+ */
+template <class T>
+static void swapLists( DLIST<T>& aList, DLIST<T>& aOther, EDA_ITEM* aParent,
+                       EDA_ITEM* aOtherParent )
+{
+    DLIST<T> tmp;
+
+    tmp.Append( aList );
+    aList.Append( aOther );
+    aOther.Append( tmp );
+
+    for( T* item = aList;  item;  item = item->Next() )
+        item->SetParent( aParent );
+
+    for( T* item = aOther;  item;  item = item->Next() )
+        item->SetParent( aOtherParent );
+}
+
+
+void MODULE::SwapProperties( MODULE* aImage )
+{
+    std::swap( m_Pos,           aImage->m_Pos );
+    std::swap( m_Layer,         aImage->m_Layer );
+    std::swap( m_fpid,          aImage->m_fpid );
+    std::swap( m_Attributs,     aImage->m_Attributs );
+    std::swap( m_ModuleStatus,  aImage->m_ModuleStatus );
+    std::swap( m_Orient,        aImage->m_Orient );
+    std::swap( m_BoundaryBox,   aImage->m_BoundaryBox );
+    std::swap( m_CntRot90,      aImage->m_CntRot90 );
+    std::swap( m_CntRot180,     aImage->m_CntRot180 );
+    std::swap( m_LastEditTime,  aImage->m_LastEditTime );
+    std::swap( m_Link,          aImage->m_Link );
+    std::swap( m_Path,          aImage->m_Path );
+
+    std::swap( m_LocalClearance,              aImage->m_LocalClearance );
+    std::swap( m_LocalSolderMaskMargin,       aImage->m_LocalSolderMaskMargin );
+    std::swap( m_LocalSolderPasteMargin,      aImage->m_LocalSolderPasteMargin );
+    std::swap( m_LocalSolderPasteMarginRatio, aImage->m_LocalSolderPasteMarginRatio );
+    std::swap( m_ZoneConnection,              aImage->m_ZoneConnection );
+    std::swap( m_ThermalWidth,                aImage->m_ThermalWidth );
+    std::swap( m_ThermalGap,                  aImage->m_ThermalGap );
+
+    // The reference and value texts can be referenced from outside the module
+    // (current item of the editor), so they keep their identity.
+    TEXTE_MODULE text( this );
+
+    text.Copy( m_Reference );
+    m_Reference->Copy( aImage->m_Reference );
+    aImage->m_Reference->Copy( &text );
+
+    text.Copy( m_Value );
+    m_Value->Copy( aImage->m_Value );
+    aImage->m_Value->Copy( &text );
+
+    swapLists( m_3D_Drawings, aImage->m_3D_Drawings, this, aImage );
+
+    std::swap( m_Doc,       aImage->m_Doc );
+    std::swap( m_KeyWord,   aImage->m_KeyWord );
+}
+
+
+void MODULE::SwapContents( MODULE* aImage )
+{
+    SwapProperties( aImage );
+
+    swapLists( m_Pads, aImage->m_Pads, this, aImage );
+    swapLists( m_Drawings, aImage->m_Drawings, this, aImage );
+
+    CalculateBoundingBox();
+    aImage->CalculateBoundingBox();
+}
+
+
 void MODULE::CopyNetlistSettings( MODULE* aModule )
 {
     // Don't do anything foolish like trying to copy to yourself.
@@ -411,6 +487,9 @@ void MODULE::CalculateBoundingBox()
 {
     m_BoundaryBox = GetFootprintRect();
     m_Surface = std::abs( (double) m_BoundaryBox.GetWidth() * m_BoundaryBox.GetHeight() );
+
+    // The footprint area changed, and the board indexes it
+    updateSpatialIndex();
 }
 
 
@@ -81,6 +81,23 @@ public:
 
     void Copy( MODULE* Module );        // Copy structure
 
+    /**
+     * Function SwapProperties
+     * exchanges the properties of this module and \a aImage (position, orientation,
+     * attributes, reference and value texts, 3D models..), but not their pads and
+     * drawings.  Nothing is copied except the reference and value texts.
+     * Used by undo/redo.
+     */
+    void SwapProperties( MODULE* aImage );
+
+    /**
+     * Function SwapContents
+     * exchanges the properties, pads and drawings of this module and \a aImage.  Pads and
+     * drawings are moved from one module to the other rather than copied.
+     * Used by undo/redo.
+     */
+    void SwapContents( MODULE* aImage );
+
     /*
      * Function Add
      * adds the given item to this MODULE and takes ownership of its memory.
@@ -91,7 +108,8 @@ public:
 
     /**
      * Function CalculateBoundingBox
-     * calculates the bounding box in board coordinates.
+     * calculates the bounding box in board coordinates.  It is called after each
+     * change of the footprint geometry, so it also re-indexes the module in its board.
      */
     void CalculateBoundingBox();
 
@@ -756,6 +756,30 @@ int D_PAD::Compare( const D_PAD* padref, const D_PAD* padcmp )
 }
 
 
+bool D_PAD::IsSameAs( const D_PAD& aPad ) const
+{
+    // Compare() tests the shape, drill, sizes, offset and layers.
+    return Compare( this, &aPad ) == 0
+           && m_Pos == aPad.m_Pos
+           && m_Pos0 == aPad.m_Pos0
+           && m_Orient == aPad.m_Orient
+           && m_NumPadName == aPad.m_NumPadName
+           && GetNet() == aPad.GetNet()
+           && m_Netname == aPad.m_Netname
+           && m_Attribute == aPad.m_Attribute
+           && m_LengthPadToDie == aPad.m_LengthPadToDie
+           && m_LocalClearance == aPad.m_LocalClearance
+           && m_LocalSolderMaskMargin == aPad.m_LocalSolderMaskMargin
+           && m_LocalSolderPasteMargin == aPad.m_LocalSolderPasteMargin
+           && m_LocalSolderPasteMarginRatio == aPad.m_LocalSolderPasteMarginRatio
+           && m_ZoneConnection == aPad.m_ZoneConnection
+           && m_ThermalWidth == aPad.m_ThermalWidth
+           && m_ThermalGap == aPad.m_ThermalGap
+           && GetLayer() == aPad.GetLayer()
+           && GetTimeStamp() == aPad.GetTimeStamp();
+}
+
+
 wxString D_PAD::ShowPadShape() const
 {
     switch( GetShape() )
@@ -45,6 +45,7 @@ class EDA_DRAW_PANEL;
 class MODULE;
 class TRACK;
 class MSG_PANEL_INFO;
+class SHAPE_TEMPLATES;
 
 
 /* Default layers used for pads, according to the pad type.
@@ -220,11 +221,14 @@ public:
      * @param aCorrectionFactor = the correction to apply to circles radius to keep
      * clearance when the circle is approximated by segment bigger or equal
      * to the real clearance value (usually near from 1.0)
+     * @param aTemplates = the pad shapes shared by the pads converted during a zone fill,
+     * or NULL to build the shape at the pad position
     */
     void TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer,
                                                int aClearanceValue,
                                                int aCircleToSegmentsCount,
-                                               double aCorrectionFactor ) const;;
+                                               double aCorrectionFactor,
+                                               SHAPE_TEMPLATES* aTemplates = NULL ) const;
 
      /**
      * Function GetClearance
@@ -403,6 +407,14 @@ public:
      */
     static int Compare( const D_PAD* padref, const D_PAD* padcmp );
 
+    /**
+     * Function IsSameAs
+     * tests if this pad and \a aPad have the same properties and position, i.e. everything
+     * Copy() copies, and the same layer and time stamp.
+     * Used by undo/redo to drop unchanged pads from the footprint copies.
+     */
+    bool IsSameAs( const D_PAD& aPad ) const;
+
     void Move( const wxPoint& aMoveVector )
     {
         m_Pos += aMoveVector;
@@ -124,6 +124,28 @@ void TEXTE_MODULE::Copy( TEXTE_MODULE* source )
 }
 
 
+bool TEXTE_MODULE::IsSameAs( const TEXTE_MODULE& aText ) const
+{
+    return m_Text == aText.m_Text
+           && m_Pos == aText.m_Pos
+           && m_Pos0 == aText.m_Pos0
+           && m_Type == aText.m_Type
+           && m_NoShow == aText.m_NoShow
+           && m_Thickness == aText.m_Thickness
+           && m_Orient == aText.m_Orient
+           && m_Size == aText.m_Size
+           && m_Mirror == aText.m_Mirror
+           && m_Attributs == aText.m_Attributs
+           && m_Italic == aText.m_Italic
+           && m_Bold == aText.m_Bold
+           && m_HJustify == aText.m_HJustify
+           && m_VJustify == aText.m_VJustify
+           && m_MultilineAllowed == aText.m_MultilineAllowed
+           && GetLayer() == aText.GetLayer()
+           && GetTimeStamp() == aText.GetTimeStamp();
+}
+
+
 int TEXTE_MODULE::GetLength() const
 {
     return m_Text.Len();
@@ -115,6 +115,13 @@ public:
 
     void Copy( TEXTE_MODULE* source ); // copy structure
 
+    /**
+     * Function IsSameAs
+     * tests if this text and \a aText have the same properties and position, layer and
+     * time stamp.  Used by undo/redo to drop unchanged texts from the footprint copies.
+     */
+    bool IsSameAs( const TEXTE_MODULE& aText ) const;
+
     int GetLength() const;        // text length
 
     /**
@@ -370,6 +370,7 @@ void TRACK::Rotate( const wxPoint& aRotCentre, double aAngle )
 {
     RotatePoint( &m_Start, aRotCentre, aAngle );
     RotatePoint( &m_End, aRotCentre, aAngle );
+    updateSpatialIndex();
 }
 
 
@@ -380,6 +381,8 @@ void TRACK::Flip( const wxPoint& aCentre )
 
     if( Type() != PCB_VIA_T )
         SetLayer( FlipLayer( GetLayer() ) );
+
+    updateSpatialIndex();
 }
 
 
@@ -40,6 +40,7 @@
 class TRACK;
 class D_PAD;
 class MSG_PANEL_ITEM;
+class SHAPE_TEMPLATES;
 
 
 // Via attributes (m_Shape parameter)
@@ -106,22 +107,27 @@ public:
     {
         m_Start += aMoveVector;
         m_End   += aMoveVector;
+        updateSpatialIndex();
     }
 
     virtual void Rotate( const wxPoint& aRotCentre, double aAngle );
 
     virtual void Flip( const wxPoint& aCentre );
 
-    void SetPosition( const wxPoint& aPos )     { m_Start = aPos; }     // was overload
+    void SetPosition( const wxPoint& aPos )     // was overload
+    {
+        m_Start = aPos;
+        updateSpatialIndex();
+    }
     const wxPoint& GetPosition() const          { return m_Start; }     // was overload
 
-    void SetWidth( int aWidth )                 { m_Width = aWidth; }
+    void SetWidth( int aWidth )                 { m_Width = aWidth; updateSpatialIndex(); }
     int GetWidth() const                        { return m_Width; }
 
-    void SetEnd( const wxPoint& aEnd )          { m_End = aEnd; }
+    void SetEnd( const wxPoint& aEnd )          { m_End = aEnd; updateSpatialIndex(); }
     const wxPoint& GetEnd() const               { return m_End; }
 
-    void SetStart( const wxPoint& aStart )      { m_Start = aStart; }
+    void SetStart( const wxPoint& aStart )      { m_Start = aStart; updateSpatialIndex(); }
     const wxPoint& GetStart() const             { return m_Start; }
 
     int GetShape() const                        { return m_Shape; }
@@ -175,11 +181,14 @@ public:
      * @param aCorrectionFactor = the correction to apply to circles radius to keep
      * clearance when the circle is approximated by segment bigger or equal
      * to the real clearance value (usually near from 1.0)
+     * @param aTemplates = the via shapes shared by the vias converted during a zone fill,
+     * or NULL to build the shape at the via position
      */
-    void TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST& aCornerBuffer,
-                                               int             aClearanceValue,
-                                               int             aCircleToSegmentsCount,
-                                               double          aCorrectionFactor ) const;
+    void TransformShapeWithClearanceToPolygon( CPOLYGONS_LIST&  aCornerBuffer,
+                                               int              aClearanceValue,
+                                               int              aCircleToSegmentsCount,
+                                               double           aCorrectionFactor,
+                                               SHAPE_TEMPLATES* aTemplates = NULL ) const;
     /**
      * Function SetDrill
      * sets the drill value for vias.
@@ -409,7 +418,12 @@ public:
     void ReturnLayerPair( LAYER_NUM* top_layer, LAYER_NUM* bottom_layer ) const;
 
     const wxPoint& GetPosition() const  {  return m_Start; }       // was overload
-    void SetPosition( const wxPoint& aPoint ) { m_Start = aPoint;  m_End = aPoint; }    // was overload
+    void SetPosition( const wxPoint& aPoint )   // was overload
+    {
+        m_Start = aPoint;
+        m_End   = aPoint;
+        updateSpatialIndex();
+    }
 
     wxString GetClass() const
     {
@@ -849,6 +849,34 @@ void ZONE_CONTAINER::Copy( ZONE_CONTAINER* src )
 }
 
 
+void ZONE_CONTAINER::SwapContents( ZONE_CONTAINER* aImage, bool aSwapFill )
+{
+    std::swap( m_Layer, aImage->m_Layer );
+
+    int netcode = GetNet();
+    SetNet( aImage->GetNet() );
+    aImage->SetNet( netcode );
+
+    std::swap( m_Poly, aImage->m_Poly );        // outlines and hatching
+    m_CornerSelection = -1;
+    aImage->m_CornerSelection = -1;
+
+    std::swap( m_ZoneClearance,             aImage->m_ZoneClearance );
+    std::swap( m_ZoneMinThickness,          aImage->m_ZoneMinThickness );
+    std::swap( m_FillMode,                  aImage->m_FillMode );
+    std::swap( m_ArcToSegmentsCount,        aImage->m_ArcToSegmentsCount );
+    std::swap( m_PadConnection,             aImage->m_PadConnection );
+    std::swap( m_ThermalReliefGap,          aImage->m_ThermalReliefGap );
+    std::swap( m_ThermalReliefCopperBridge, aImage->m_ThermalReliefCopperBridge );
+
+    if( aSwapFill )
+    {
+        m_FilledPolysList.Swap( aImage->m_FilledPolysList );
+        m_FillSegmList.swap( aImage->m_FillSegmList );
+    }
+}
+
+
 bool ZONE_CONTAINER::SetNetNameFromNetCode( void )
 {
     NETINFO_ITEM* net;
@@ -111,6 +111,17 @@ public:
      */
     void Copy( ZONE_CONTAINER* src );
 
+    /**
+     * Function SwapContents
+     * exchanges the data Copy() copies between this zone and \a aImage, without copying
+     * the outlines and filled areas.
+     * Used by undo/redo.
+     * @param aImage = the zone to exchange data with
+     * @param aSwapFill = false to leave the filled areas alone, when they are known
+     *                    to be identical in both zones
+     */
+    void SwapContents( ZONE_CONTAINER* aImage, bool aSwapFill = true );
+
     void GetMsgPanelInfo( std::vector< MSG_PANEL_ITEM >& aList );
 
     /**
@@ -316,21 +327,6 @@ public:
      */
     bool BuildFilledSolidAreasPolygons( BOARD* aPcb, CPOLYGONS_LIST* aCornerBuffer = NULL );
 
-    /**
-     * Function CopyPolygonsFromKiPolygonListToFilledPolysList
-     * Copy polygons stored in aKiPolyList to m_FilledPolysList
-     * The previous m_FilledPolysList contents is replaced.
-     * @param aKiPolyList = a KI_POLYGON_SET containing polygons.
-     */
-    void CopyPolygonsFromKiPolygonListToFilledPolysList( KI_POLYGON_SET& aKiPolyList );
-
-    /**
-     * Function CopyPolygonsFromFilledPolysListToKiPolygonList
-     * Copy polygons from m_FilledPolysList to aKiPolyList
-     * @param aKiPolyList = a KI_POLYGON_SET to fill by polygons.
-     */
-    void CopyPolygonsFromFilledPolysListToKiPolygonList( KI_POLYGON_SET& aKiPolyList );
-
     /**
      * Function AddClearanceAreasPolygonsToPolysList
      * Add non copper areas polygons (pads and tracks with clearance)
@@ -515,11 +511,11 @@ public:
 
    /**
      * Function ClearFilledPolysList
-     * clears the list of filled polygons.
+     * clears the list of filled polygons and releases its memory.
      */
     void ClearFilledPolysList()
     {
-        m_FilledPolysList.RemoveAllContours();
+        CPOLYGONS_LIST().Swap( m_FilledPolysList );
     }
 
    /**
@@ -30,6 +30,13 @@
 
 
 #include <fctsys.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
 #include <class_drawpanel.h>
 #include <pcbcommon.h>
 #include <wxPcbStruct.h>
@@ -39,11 +46,199 @@
 #include <connect.h>
 #include <dialog_cleaning_options.h>
 
+/**
+ * Class TRACK_ENDS_INDEX
+ * finds the tracks and vias having an end at a given point, with the criteria of
+ * TRACK::GetTrace() (same end point and a common layer), without walking the track list.
+ *
+ * Items are indexed by their end points: an item must be removed before being deleted,
+ * and removed from its old end points and added again when one of its ends is moved.
+ * Items found at a given point are in the track list order, except the ones added after
+ * Build(), which come last.
+ */
+class TRACK_ENDS_INDEX
+{
+public:
+    /**
+     * Function Build
+     * indexes all the items of the track list starting at \a aFirst.
+     */
+    void Build( TRACK* aFirst )
+    {
+        m_ends.clear();
+
+        for( TRACK* track = aFirst; track; track = track->Next() )
+            Add( track );
+    }
+
+    void Add( TRACK* aTrack )
+    {
+        m_ends[ endKey( aTrack->GetStart() ) ].push_back( aTrack );
+
+        if( aTrack->GetEnd() != aTrack->GetStart() )
+            m_ends[ endKey( aTrack->GetEnd() ) ].push_back( aTrack );
+    }
+
+    /**
+     * Function Remove
+     * removes \a aTrack, which has been indexed with the end points \a aStart and \a aEnd.
+     */
+    void Remove( TRACK* aTrack, const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        remove( aTrack, aStart );
+
+        if( aEnd != aStart )
+            remove( aTrack, aEnd );
+    }
+
+    void Remove( TRACK* aTrack )
+    {
+        Remove( aTrack, aTrack->GetStart(), aTrack->GetEnd() );
+    }
+
+    /**
+     * Function GetItemsAt
+     * appends to \a aList all the items having an end at \a aPosition.
+     */
+    void GetItemsAt( const wxPoint& aPosition, std::vector<TRACK*>& aList ) const
+    {
+        ENDS::const_iterator it = m_ends.find( endKey( aPosition ) );
+
+        if( it != m_ends.end() )
+            aList.insert( aList.end(), it->second.begin(), it->second.end() );
+    }
+
+    /**
+     * Function GetConnected
+     * appends to \a aList the items connected to \a aTrack at \a aPosition, i.e. the
+     * ones TRACK::GetTrace() could return: having an end at \a aPosition, sharing a layer
+     * with \a aTrack and not flagged BUSY or IS_DELETED.
+     * @param aExclude is an item to ignore, as if it was flagged BUSY.
+     */
+    void GetConnected( const TRACK* aTrack, const wxPoint& aPosition,
+                       std::vector<TRACK*>& aList, const TRACK* aExclude = NULL ) const
+    {
+        ENDS::const_iterator it = m_ends.find( endKey( aPosition ) );
+
+        if( it == m_ends.end() )
+            return;
+
+        LAYER_MSK layerMask = aTrack->GetLayerMask();
+
+        for( unsigned ii = 0; ii < it->second.size(); ii++ )
+        {
+            TRACK* other = it->second[ii];
+
+            if( other == aTrack || other == aExclude )
+                continue;
+
+            if( other->GetState( BUSY | IS_DELETED ) )
+                continue;
+
+            if( layerMask & other->GetLayerMask() )
+                aList.push_back( other );
+        }
+    }
+
+    /**
+     * Function GetFirstConnected
+     * @return TRACK* - the first item found by GetConnected(), or NULL if none.
+     */
+    TRACK* GetFirstConnected( const TRACK* aTrack, const wxPoint& aPosition,
+                              const TRACK* aExclude = NULL ) const
+    {
+        std::vector<TRACK*> connected;
+
+        GetConnected( aTrack, aPosition, connected, aExclude );
+
+        return connected.empty() ? NULL : connected[0];
+    }
+
+private:
+    typedef std::pair<int, int>                                 END_KEY;
+    typedef boost::unordered_map< END_KEY, std::vector<TRACK*> > ENDS;
+
+    static END_KEY endKey( const wxPoint& aPosition )
+    {
+        return END_KEY( aPosition.x, aPosition.y );
+    }
+
+    void remove( TRACK* aTrack, const wxPoint& aPosition )
+    {
+        ENDS::iterator it = m_ends.find( endKey( aPosition ) );
+
+        if( it == m_ends.end() )
+            return;
+
+        std::vector<TRACK*>& items = it->second;
+        items.erase( std::remove( items.begin(), items.end(), aTrack ), items.end() );
+
+        if( items.empty() )
+            m_ends.erase( it );
+    }
+
+    ENDS    m_ends;
+};
+
+
+/**
+ * Class TRACK_WORKLIST
+ * holds the items a cleanup pass has still to examine, each of them once, in the order
+ * they were pushed.
+ */
+class TRACK_WORKLIST
+{
+public:
+    /**
+     * Function Push
+     * queues \a aTrack, unless it is already waiting to be examined.
+     */
+    void Push( TRACK* aTrack )
+    {
+        if( m_queued.insert( aTrack ).second )
+            m_list.push_back( aTrack );
+    }
+
+    /**
+     * Function Forget
+     * drops \a aTrack from the queue, it must be called before deleting an item.
+     */
+    void Forget( TRACK* aTrack )
+    {
+        m_queued.erase( aTrack );
+    }
+
+    /**
+     * Function Pop
+     * @return TRACK* - the next item to examine, or NULL when all have been examined.
+     */
+    TRACK* Pop()
+    {
+        while( !m_list.empty() )
+        {
+            TRACK* track = m_list.front();
+            m_list.pop_front();
+
+            // Forgotten items are still in the list, but not in m_queued
+            if( m_queued.erase( track ) )
+                return track;
+        }
+
+        return NULL;
+    }
+
+private:
+    std::deque<TRACK*>              m_list;
+    boost::unordered_set<TRACK*>    m_queued;
+};
+
+
 // Helper class used to clean tracks and vias
 class TRACKS_CLEANER: CONNECTIONS
 {
 private:
     BOARD * m_Brd;
+    TRACK_ENDS_INDEX m_ends;    // end points of tracks and vias, used by the cleanup passes
     bool m_deleteUnconnectedTracks;
     bool m_mergeSegments;
     bool m_cleanVias;
@@ -97,6 +292,23 @@ private:
      */
     void buildTrackConnectionInfo();
 
+    /**
+     * helper function
+     * tells if the end aEndPoint (FLG_START or FLG_END) of aTrack, which is not on a pad,
+     * is not connected to anything, or only to a via having no other connection.
+     * Sets aTrack->start or aTrack->end to the item connected to this end.
+     */
+    bool isDanglingEnd( TRACK* aTrack, int aEndPoint );
+
+    /**
+     * helper function
+     * merge the segment aSegment with the only segment connected at its end aEndType,
+     * if any and when possible.  The merged segment and the segments connected at its
+     * new end are pushed to aWorklist, to be examined again.
+     * @return true if the segments were merged
+     */
+    bool mergeAtEnd( TRACK* aSegment, int aEndType, TRACK_WORKLIST& aWorklist );
+
     /**
      * helper function
      * merge aTrackRef and aCandidate, when possible,
@@ -214,8 +426,13 @@ bool TRACKS_CLEANER::clean_vias()
     TRACK* next_track;
     bool modified = false;
 
-    for( TRACK* track = m_Brd->m_Track; track; track = track->Next() )
+    // Locations of the through vias already found
+    boost::unordered_set< std::pair<int, int> > through_vias;
+
+    for( TRACK* track = m_Brd->m_Track; track; track = next_track )
     {
+        next_track = track->Next();
+
         // Correct via m_End defects (if any)
         if( track->Type() == PCB_VIA_T )
         {
@@ -226,24 +443,16 @@ bool TRACKS_CLEANER::clean_vias()
         if( track->GetShape() != VIA_THROUGH )
             continue;
 
-        // Search and delete others vias at same location
-        TRACK* alt_track = track->Next();
-
-        for( ; alt_track != NULL; alt_track = next_track )
-        {
-            next_track = alt_track->Next();
-
-            if( alt_track->GetShape() != VIA_THROUGH )
-                continue;
+        // Keep the first via found at a location, and delete the others
+        std::pair<int, int> location( track->GetStart().x, track->GetStart().y );
 
-            if( alt_track->GetStart() != track->GetStart() )
-                continue;
+        if( through_vias.insert( location ).second )
+            continue;
 
-            // delete via
-            alt_track->UnLink();
-            delete alt_track;
-            modified = true;
-        }
+        // delete via
+        track->UnLink();
+        delete track;
+        modified = true;
     }
 
     // Delete Via on pads at same location
@@ -275,170 +484,111 @@ bool TRACKS_CLEANER::clean_vias()
 }
 
 
+bool TRACKS_CLEANER::isDanglingEnd( TRACK* aTrack, int aEndPoint )
+{
+    wxPoint         position = aEndPoint == FLG_START ? aTrack->GetStart() : aTrack->GetEnd();
+    TRACK*          other = m_ends.GetFirstConnected( aTrack, position );
+    ZONE_CONTAINER* zone = NULL;
+    LAYER_NUM       top_layer, bottom_layer;
+
+    if( other == NULL )     // Test a connection to zones
+    {
+        if( aTrack->Type() != PCB_VIA_T )
+        {
+            zone = m_Brd->HitTestForAnyFilledArea( position,
+                                                   aTrack->GetLayer(), aTrack->GetLayer(),
+                                                   aTrack->GetNet() );
+        }
+        else
+        {
+            ((SEGVIA*)aTrack)->ReturnLayerPair( &top_layer, &bottom_layer );
+            zone = m_Brd->HitTestForAnyFilledArea( position, top_layer, bottom_layer,
+                                                   aTrack->GetNet() );
+        }
+
+        if( zone == NULL )
+            return true;
+    }
+
+    // segment, via or zone connected to this end
+    if( aEndPoint == FLG_START )
+        aTrack->start = other;
+    else
+        aTrack->end = other;
+
+    // If a via is connected to this end, test if this via has a second item connected.
+    // If no, remove it with the current segment
+    if( other && other->Type() == PCB_VIA_T )
+    {
+        SEGVIA* via = (SEGVIA*) other;
+        wxPoint via_pos = aEndPoint == FLG_START ? via->GetStart() : via->GetEnd();
+
+        // search for another item following the via
+        if( m_ends.GetFirstConnected( via, via_pos, aTrack ) == NULL )
+        {
+            via->ReturnLayerPair( &top_layer, &bottom_layer );
+            zone = m_Brd->HitTestForAnyFilledArea( via_pos, bottom_layer, top_layer,
+                                                   via->GetNet() );
+
+            if( zone == NULL )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
 /*
  *  Delete dangling tracks
  *  Vias:
  *  If a via is only connected to a dangling track, it also will be removed
+ *
+ *  Each item is examined once, and again only when an item connected to it is deleted,
+ *  because it is perhaps now not connected and should be deleted.
  */
 bool TRACKS_CLEANER::deleteUnconnectedTracks()
 {
     if( m_Brd->m_Track == NULL )
         return false;
 
-    bool modified = false;
-    bool item_erased = true;
-    while( item_erased )    // Iterate when at least one track is deleted
-    {
-        item_erased = false;
-        TRACK* next_track;
-        for( TRACK * track = m_Brd->m_Track; track ; track = next_track )
-        {
-            next_track = track->Next();
-
-            int flag_erase = 0; //Not connected indicator
-            int type_end = 0;
+    bool            modified = false;
+    TRACK_WORKLIST  worklist;
+    TRACK*          track;
 
-            if( track->GetState( START_ON_PAD ) )
-                type_end |= START_ON_PAD;
+    m_ends.Build( m_Brd->m_Track );
 
-            if( track->GetState( END_ON_PAD ) )
-                type_end |= END_ON_PAD;
+    for( track = m_Brd->m_Track; track; track = track->Next() )
+        worklist.Push( track );
 
-            // if the track start point is not connected to a pad,
-            // test if this track start point is connected to another track
-            // For via test, an enhancement could be to test if connected
-            // to 2 items on different layers.
-            // Currently a via must be connected to 2 items, that can be on the same layer
-            LAYER_NUM top_layer, bottom_layer;
-            ZONE_CONTAINER* zone;
+    while( ( track = worklist.Pop() ) != NULL )
+    {
+        // if a track end point is not connected to a pad,
+        // test if this end point is connected to another track
+        // For via test, an enhancement could be to test if connected
+        // to 2 items on different layers.
+        // Currently a via must be connected to 2 items, that can be on the same layer
+        bool dangling = ( !track->GetState( START_ON_PAD ) && isDanglingEnd( track, FLG_START ) )
+                        || ( !track->GetState( END_ON_PAD ) && isDanglingEnd( track, FLG_END ) );
+
+        if( !dangling )
+            continue;
 
-            if( (type_end & START_ON_PAD ) == 0 )
-            {
-                TRACK* other = track->GetTrace( m_Brd->m_Track, NULL, FLG_START );
-
-                if( other == NULL )     // Test a connection to zones
-                {
-                    if( track->Type() != PCB_VIA_T )
-                    {
-                        zone = m_Brd->HitTestForAnyFilledArea( track->GetStart(),
-                                                               track->GetLayer(),
-                                                               track->GetLayer(),
-                                                               track->GetNet() );
-                    }
-                    else
-                    {
-                        ((SEGVIA*)track)->ReturnLayerPair( &top_layer, &bottom_layer );
-                        zone = m_Brd->HitTestForAnyFilledArea( track->GetStart(),
-                                                               top_layer, bottom_layer,
-                                                               track->GetNet() );
-                    }
-                }
-
-                if( (other == NULL) && (zone == NULL) )
-                {
-                    flag_erase |= 1;
-                }
-                else    // segment, via or zone connected to this end
-                {
-                    track->start = other;
-                    // If a via is connected to this end,
-                    // test if this via has a second item connected.
-                    // If no, remove it with the current segment
-
-                    if( other && other->Type() == PCB_VIA_T )
-                    {
-                        // search for another segment following the via
-                        track->SetState( BUSY, true );
-
-                        SEGVIA* via = (SEGVIA*) other;
-                        other = via->GetTrace( m_Brd->m_Track, NULL, FLG_START );
-
-                        if( other == NULL )
-                        {
-                            via->ReturnLayerPair( &top_layer, &bottom_layer );
-                            zone = m_Brd->HitTestForAnyFilledArea( via->GetStart(),
-                                                                   bottom_layer,
-                                                                   top_layer,
-                                                                   via->GetNet() );
-                        }
-
-                        if( (other == NULL) && (zone == NULL) )
-                            flag_erase |= 2;
-
-                        track->SetState( BUSY, false );
-                    }
-                }
-            }
+        // The items connected to the deleted track must be examined again
+        std::vector<TRACK*> neighbours;
+        m_ends.GetItemsAt( track->GetStart(), neighbours );
+        m_ends.GetItemsAt( track->GetEnd(), neighbours );
 
-            // if track end point is not connected to a pad,
-            // test if this track end point is connected to an other track
-            if( (type_end & END_ON_PAD ) == 0 )
-            {
-                TRACK* other = track->GetTrace( m_Brd->m_Track, NULL, FLG_END );
-
-                if( other == NULL )     // Test a connection to zones
-                {
-                    if( track->Type() != PCB_VIA_T )
-                    {
-                        zone = m_Brd->HitTestForAnyFilledArea( track->GetEnd(),
-                                                               track->GetLayer(),
-                                                               track->GetLayer(),
-                                                               track->GetNet() );
-                    }
-                    else
-                    {
-                        ((SEGVIA*)track)->ReturnLayerPair( &top_layer, &bottom_layer );
-                        zone = m_Brd->HitTestForAnyFilledArea( track->GetEnd(),
-                                                               top_layer, bottom_layer,
-                                                               track->GetNet() );
-                    }
-                }
-
-                if ( (other == NULL) && (zone == NULL) )
-                {
-                    flag_erase |= 0x10;
-                }
-                else     // segment, via or zone connected to this end
-                {
-                    track->end = other;
-
-                    // If a via is connected to this end, test if this via has a second item connected
-                    // if no, remove it with the current segment
-
-                    if( other && other->Type() == PCB_VIA_T )
-                    {
-                        // search for another segment following the via
-
-                        track->SetState( BUSY, true );
-
-                        SEGVIA* via = (SEGVIA*) other;
-                        other = via->GetTrace( m_Brd->m_Track, NULL, FLG_END );
-
-                        if( other == NULL )
-                        {
-                            via->ReturnLayerPair( &top_layer, &bottom_layer );
-                            zone = m_Brd->HitTestForAnyFilledArea( via->GetEnd(),
-                                                                   bottom_layer, top_layer,
-                                                                   via->GetNet() );
-                        }
-
-                        if( (other == NULL) && (zone == NULL) )
-                            flag_erase |= 0x20;
-
-                        track->SetState( BUSY, false );
-                    }
-                }
-            }
+        // remove segment from board
+        m_ends.Remove( track );
+        worklist.Forget( track );
+        track->DeleteStructure();
+        modified = true;
 
-            if( flag_erase )
-            {
-                // remove segment from board
-                track->DeleteStructure();
-                // iterate, because a track connected to the deleted track
-                // is now perhaps now not connected and should be deleted
-                item_erased = true;
-                modified = true;
-            }
+        for( unsigned ii = 0; ii < neighbours.size(); ii++ )
+        {
+            if( neighbours[ii] != track )
+                worklist.Push( neighbours[ii] );
         }
     }
 
@@ -451,9 +601,6 @@ bool TRACKS_CLEANER::clean_segments()
 {
     bool modified = false;
     TRACK*          segment, * nextsegment;
-    TRACK*          other;
-    int             flag, no_inc;
-
 
     // Delete null segments
     for( segment = m_Brd->m_Track; segment; segment = nextsegment )
@@ -464,15 +611,23 @@ bool TRACKS_CLEANER::clean_segments()
             segment->DeleteStructure();
     }
 
+    m_ends.Build( m_Brd->m_Track );
+
     // Delete redundant segments, i.e. segments having the same end points
-    // and layers
-    for( segment  = m_Brd->m_Track; segment; segment = segment->Next() )
+    // and layers.  The first one in the track list is kept.
+    for( segment = m_Brd->m_Track; segment; segment = segment->Next() )
     {
-        for( other = segment->Next(); other; other = nextsegment )
+        std::vector<TRACK*> others;
+        m_ends.GetItemsAt( segment->GetStart(), others );
+
+        for( unsigned ii = 0; ii < others.size(); ii++ )
         {
-            nextsegment = other->Next();
+            TRACK* other = others[ii];
             bool erase = false;
 
+            if( other == segment )
+                continue;
+
             if( segment->Type() != other->Type() )
                 continue;
 
@@ -480,7 +635,7 @@ bool TRACKS_CLEANER::clean_segments()
                 continue;
 
             if( segment->GetNet() != other->GetNet() )
-                break;
+                continue;
 
             if( ( segment->GetStart() == other->GetStart() ) &&
                 ( segment->GetEnd() == other->GetEnd() ) )
@@ -493,6 +648,7 @@ bool TRACKS_CLEANER::clean_segments()
             // Delete redundant point
             if( erase )
             {
+                m_ends.Remove( other );
                 other->DeleteStructure();
                 modified = true;
             }
@@ -500,105 +656,72 @@ bool TRACKS_CLEANER::clean_segments()
     }
 
     // merge collinear segments:
-    for( segment = m_Brd->m_Track; segment; segment = nextsegment )
-    {
-        TRACK*  segStart;
-        TRACK*  segEnd;
-        TRACK*  segDelete;
-
-        nextsegment = segment->Next();
-
-        if( segment->Type() != PCB_TRACE_T )
-            continue;
-
-        flag = no_inc = 0;
+    TRACK_WORKLIST worklist;
 
-        // search for a possible point connected to the START point of the current segment
-        for( segStart = segment->Next(); ; )
-        {
-            segStart = segment->GetTrace( segStart, NULL, FLG_START );
-
-            if( segStart )
-            {
-                // the two segments must have the same width
-                if( segment->GetWidth() != segStart->GetWidth() )
-                    break;
+    for( segment = m_Brd->m_Track; segment; segment = segment->Next() )
+    {
+        if( segment->Type() == PCB_TRACE_T )
+            worklist.Push( segment );
+    }
 
-                // it cannot be a via
-                if( segStart->Type() != PCB_TRACE_T )
-                    break;
+    while( ( segment = worklist.Pop() ) != NULL )
+    {
+        // When merged, the current segment is pushed again to retry to merge it
+        if( mergeAtEnd( segment, FLG_START, worklist ) || mergeAtEnd( segment, FLG_END, worklist ) )
+            modified = true;
+    }
 
-                // We must have only one segment connected
-                segStart->SetState( BUSY, true );
-                other = segment->GetTrace( m_Brd->m_Track, NULL, FLG_START );
-                segStart->SetState( BUSY, false );
+    return modified;
+}
 
-                if( other == NULL )
-                    flag = 1;           // OK
 
-                break;
-            }
-            break;
-        }
+bool TRACKS_CLEANER::mergeAtEnd( TRACK* aSegment, int aEndType, TRACK_WORKLIST& aWorklist )
+{
+    wxPoint             start = aSegment->GetStart();
+    wxPoint             end = aSegment->GetEnd();
+    std::vector<TRACK*> connected;
 
-        if( flag )   // We have the starting point of the segment is connected to an other segment
-        {
-            segDelete = mergeCollinearSegmentIfPossible( segment, segStart, FLG_START );
+    m_ends.GetConnected( aSegment, aEndType == FLG_START ? start : end, connected );
 
-            if( segDelete )
-            {
-                no_inc = 1;
-                segDelete->DeleteStructure();
-                modified = true;
-            }
-        }
+    // We must have only one segment connected
+    if( connected.size() != 1 )
+        return false;
 
-        // search for a possible point connected to the END point of the current segment:
-        for( segEnd = segment->Next(); ; )
-        {
-            segEnd = segment->GetTrace( segEnd, NULL, FLG_END );
+    TRACK* candidate = connected[0];
 
-            if( segEnd )
-            {
-                if( segment->GetWidth() != segEnd->GetWidth() )
-                    break;
+    // the two segments must have the same width
+    if( aSegment->GetWidth() != candidate->GetWidth() )
+        return false;
 
-                if( segEnd->Type() != PCB_TRACE_T )
-                    break;
+    // it cannot be a via
+    if( candidate->Type() != PCB_TRACE_T )
+        return false;
 
-                // We must have only one segment connected
-                segEnd->SetState( BUSY, true );
-                other = segment->GetTrace( m_Brd->m_Track, NULL, FLG_END );
-                segEnd->SetState( BUSY, false );
+    TRACK* segDelete = mergeCollinearSegmentIfPossible( aSegment, candidate, aEndType );
 
-                if( other == NULL )
-                    flag |= 2;          // Ok
+    if( segDelete == NULL )
+        return false;
 
-                break;
-            }
-            else
-            {
-                break;
-            }
-        }
+    m_ends.Remove( aSegment, start, end );
+    m_ends.Remove( segDelete );
+    aWorklist.Forget( segDelete );
+    segDelete->DeleteStructure();
+    m_ends.Add( aSegment );
 
-        if( flag & 2 )  // We have the ending point of the segment is connected to an other segment
-        {
-            segDelete = mergeCollinearSegmentIfPossible( segment, segEnd, FLG_END );
+    // The segments at the new end of aSegment have a new neighbour
+    std::vector<TRACK*> neighbours;
+    m_ends.GetConnected( aSegment, aEndType == FLG_START ? aSegment->GetStart()
+                                                         : aSegment->GetEnd(), neighbours );
 
-            if( segDelete )
-            {
-                no_inc = 1;
-                segDelete->DeleteStructure();
-                modified = true;
-            }
-        }
+    aWorklist.Push( aSegment );
 
-        if( no_inc ) // The current segment was modified, retry to merge it
-            nextsegment = segment->Next();
+    for( unsigned ii = 0; ii < neighbours.size(); ii++ )
+    {
+        if( neighbours[ii]->Type() == PCB_TRACE_T )
+            aWorklist.Push( neighbours[ii] );
     }
 
-    return modified;
+    return true;
 }
 
 
@@ -350,6 +350,17 @@ public:
     SEARCH_RESULT Inspect( EDA_ITEM* testItem, const void* testData );
 
 
+    /**
+     * Function GetSearchArea
+     * Items are collected only if they are hit at the reference position.
+     */
+    bool GetSearchArea( EDA_RECT& aArea ) const
+    {
+        aArea = EDA_RECT( m_RefPos, wxSize( 0, 0 ) );
+        return true;
+    }
+
+
     /**
      * Function Collect
      * scans a BOARD_ITEM using this class's Inspector method, which does the collection.
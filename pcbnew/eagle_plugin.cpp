@@ -54,10 +54,16 @@ Load() TODO's
 */
 
 #include <errno.h>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
 
 #include <wx/string.h>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/bind.hpp>
 
 #include <eagle_plugin.h>
 
@@ -75,6 +81,7 @@ Load() TODO's
 #include <class_edge_mod.h>
 #include <class_zone.h>
 #include <class_pcb_text.h>
+#include <parallel_for.h>
 
 using namespace boost::property_tree;
 using namespace std;
@@ -1051,13 +1058,339 @@ static inline string makeKey( const string& aFirst, const string& aSecond )
 
 
 /// Make a unique time stamp
-static inline unsigned long timeStamp( CPTREE& aTree )
+static inline unsigned long timeStamp()
 {
-    // in this case from a unique tree memory location
-    return (unsigned long)(void*) &aTree;
+    // The document is read one element at a time, so the memory locations of the tree
+    // nodes are reused and not unique anymore.  Count the stamps instead, with a thread
+    // safe, atomic operation since packages are converted by several threads.
+    static unsigned long lastStamp = 0;
+
+    return __sync_add_and_fetch( &lastStamp, 1 );
 }
 
 
+/**
+ * Class EAGLE_DOC_INDEX
+ * reads an Eagle board file sequentially, SAX style, and notes where the XML elements
+ * converted by EAGLE_PLUGIN::Load() are in the file text, without building a tree of the
+ * whole document.  Each of these elements is read into its own small PTREE only when it
+ * is converted, see Parse().
+ *
+ * Only the markup is checked while indexing, the content of the elements is checked by
+ * the XML parser when they are read.
+ */
+class EAGLE_DOC_INDEX
+{
+public:
+    /// Byte range of an element in the file text, from its start tag to its end tag
+    struct SPAN
+    {
+        size_t  begin;
+        size_t  end;
+
+        SPAN( size_t aBegin, size_t aEnd ) :
+            begin( aBegin ),
+            end( aEnd )
+        {}
+    };
+
+    typedef std::vector<SPAN>   SPANS;
+
+    SPANS   m_Layers;           ///< "eagle.drawing.layers"
+    SPANS   m_DesignRules;      ///< "eagle.drawing.board.designrules"
+    SPANS   m_Plain;            ///< each graphic item of "eagle.drawing.board.plain"
+    SPANS   m_Libraries;        ///< each "eagle.drawing.board.libraries.library"
+    SPANS   m_Elements;         ///< each "eagle.drawing.board.elements.element"
+    SPANS   m_Signals;          ///< each "eagle.drawing.board.signals.signal"
+
+    /**
+     * Function Read
+     * reads the file \a aFileName and indexes its elements.
+     * @param aFileName is the 8 bit file name, encoded as the file system expects it.
+     * @throw IO_ERROR if the file cannot be read, xml_parser_error if its markup is broken.
+     */
+    void Read( const string& aFileName )
+    {
+        std::ifstream file( aFileName.c_str(), std::ios::in | std::ios::binary );
+
+        if( !file )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open file '%s' for reading" ),
+                                              GetChars( FROM_UTF8( aFileName.c_str() ) ) ) );
+        }
+
+        std::ostringstream text;
+        text << file.rdbuf();
+
+        m_fileName = aFileName;
+        m_text = text.str();
+
+        scan();
+    }
+
+    /**
+     * Function RequireSection
+     * checks the file has an element at \a aPath, a dotted path from the document root
+     * at most 4 elements deep.
+     * @throw IO_ERROR if there is no such element.
+     */
+    void RequireSection( const char* aPath ) const
+    {
+        if( !m_sections.count( aPath ) )
+        {
+            string msg = "No such node (";
+            msg += aPath;
+            msg += ")";
+
+            THROW_IO_ERROR( msg );
+        }
+    }
+
+    /**
+     * Function Parse
+     * reads the element at \a aSpan into a tree, the element being the only child of its
+     * root.  The tree is kept until FreeTrees() is called, so the XPATH of an exception
+     * can still refer to its strings.
+     * @throw xml_parser_error if the element cannot be parsed.
+     */
+    CPTREE& Parse( const SPAN& aSpan )
+    {
+        std::istringstream stream( m_text.substr( aSpan.begin, aSpan.end - aSpan.begin ) );
+
+        m_trees.push_back( new PTREE() );
+
+        try
+        {
+            read_xml( stream, m_trees.back(),
+                      xml_parser::trim_whitespace | xml_parser::no_comments );
+        }
+        catch( const file_parser_error& fpe )
+        {
+            // Report the line in the file, not in the element
+            throw xml_parser_error( fpe.message(), m_fileName,
+                                    fpe.line() + lineOf( aSpan.begin ) - 1 );
+        }
+
+        return m_trees.back();
+    }
+
+    /**
+     * Function FreeTrees
+     * frees the trees read by Parse(), once their elements are converted.
+     */
+    void FreeTrees()
+    {
+        m_trees.clear();
+    }
+
+private:
+    string                  m_fileName;
+    string                  m_text;         ///< the whole file
+    std::set<string>        m_sections;     ///< paths of the elements up to 4 levels deep
+    boost::ptr_vector<PTREE> m_trees;       ///< elements read by Parse()
+
+    /// Opened element: where it starts, and the length of its parent path
+    struct OPEN_ELEMENT
+    {
+        size_t  begin;
+        size_t  parentPathLen;
+    };
+
+    /// @return the line number of the byte at aOffset, starting from 1.
+    unsigned long lineOf( size_t aOffset ) const
+    {
+        return 1 + std::count( m_text.begin(), m_text.begin() + aOffset, '\n' );
+    }
+
+    void error( size_t aOffset, const char* aMessage ) const
+    {
+        throw xml_parser_error( aMessage, m_fileName, lineOf( aOffset ) );
+    }
+
+    /// @return the offset past aEnd, found after aOffset.
+    size_t skipPast( size_t aOffset, const char* aEnd ) const
+    {
+        size_t pos = m_text.find( aEnd, aOffset );
+
+        if( pos == string::npos )
+            error( aOffset, "unexpected end of data" );
+
+        return pos + strlen( aEnd );
+    }
+
+    /// @return the offset past the '>' ending the tag at aOffset, skipping quoted
+    /// attribute values, which can contain a '>'.
+    size_t endOfTag( size_t aOffset ) const
+    {
+        for( size_t pos = aOffset + 1;  pos < m_text.size();  ++pos )
+        {
+            char c = m_text[pos];
+
+            if( c == '>' )
+                return pos + 1;
+
+            if( c == '"' || c == '\'' )
+            {
+                pos = m_text.find( c, pos + 1 );
+
+                if( pos == string::npos )
+                    break;
+            }
+        }
+
+        error( aOffset, "unexpected end of data" );
+        return m_text.size();
+    }
+
+    /// @return the offset past a <!DOCTYPE ...> declaration, which can have an internal
+    /// subset between brackets.
+    size_t skipDeclaration( size_t aOffset ) const
+    {
+        int depth = 0;
+
+        for( size_t pos = aOffset + 2;  pos < m_text.size();  ++pos )
+        {
+            char c = m_text[pos];
+
+            if( c == '[' )
+                ++depth;
+            else if( c == ']' )
+                --depth;
+            else if( c == '>' && depth <= 0 )
+                return pos + 1;
+        }
+
+        error( aOffset, "unexpected end of data" );
+        return m_text.size();
+    }
+
+    /// @return the name of the tag at aOffset, aNameStart being the offset of its first
+    /// character.
+    string tagName( size_t aNameStart ) const
+    {
+        size_t end = m_text.find_first_of( " \t\r\n/>", aNameStart );
+
+        if( end == string::npos )
+            end = m_text.size();
+
+        return m_text.substr( aNameStart, end - aNameStart );
+    }
+
+    /// Notes the element which ends at aEnd, aPath being its dotted path.
+    void indexElement( const string& aPath, size_t aParentPathLen, size_t aBegin, size_t aEnd )
+    {
+        SPAN span( aBegin, aEnd );
+
+        if( aPath == "eagle.drawing.board.signals.signal" )
+            m_Signals.push_back( span );
+        else if( aPath == "eagle.drawing.board.elements.element" )
+            m_Elements.push_back( span );
+        else if( aPath == "eagle.drawing.board.libraries.library" )
+            m_Libraries.push_back( span );
+        else if( aParentPathLen == strlen( "eagle.drawing.board.plain" )
+                 && aPath.compare( 0, aParentPathLen, "eagle.drawing.board.plain" ) == 0 )
+            m_Plain.push_back( span );
+        else if( aPath == "eagle.drawing.board.designrules" )
+            m_DesignRules.push_back( span );
+        else if( aPath == "eagle.drawing.layers" )
+            m_Layers.push_back( span );
+    }
+
+    void scan()
+    {
+        std::vector<OPEN_ELEMENT>   opened;
+        string                      path;       // dotted path of the innermost opened element
+        size_t                      pos = 0;
+
+        while( ( pos = m_text.find( '<', pos ) ) != string::npos )
+        {
+            size_t begin = pos;
+
+            if( m_text.compare( pos, 4, "<!--" ) == 0 )
+                pos = skipPast( pos + 4, "-->" );
+
+            else if( m_text.compare( pos, 9, "<![CDATA[" ) == 0 )
+                pos = skipPast( pos + 9, "]]>" );
+
+            else if( m_text.compare( pos, 2, "<?" ) == 0 )
+                pos = skipPast( pos + 2, "?>" );
+
+            else if( m_text.compare( pos, 2, "<!" ) == 0 )
+                pos = skipDeclaration( pos );
+
+            else if( m_text.compare( pos, 2, "</" ) == 0 )
+            {
+                string name = tagName( pos + 2 );
+
+                pos = endOfTag( pos );
+
+                if( opened.empty() ||
+                    path.compare( opened.back().parentPathLen ? opened.back().parentPathLen + 1 : 0,
+                                  string::npos, name ) != 0 )
+                    error( begin, "invalid closing tag" );
+
+                indexElement( path, opened.back().parentPathLen, opened.back().begin, pos );
+
+                path.resize( opened.back().parentPathLen );
+                opened.pop_back();
+            }
+
+            else
+            {
+                string          name = tagName( pos + 1 );
+                OPEN_ELEMENT    element;
+
+                if( name.empty() )
+                    error( begin, "expected element name" );
+
+                pos = endOfTag( pos );
+
+                element.begin = begin;
+                element.parentPathLen = path.size();
+
+                if( !path.empty() )
+                    path += '.';
+
+                path += name;
+
+                if( opened.size() < 4 )
+                    m_sections.insert( path );
+
+                // An empty element, like <wire .../>, is closed right away
+                if( m_text[pos - 2] == '/' )
+                {
+                    indexElement( path, element.parentPathLen, begin, pos );
+                    path.resize( element.parentPathLen );
+                }
+                else
+                    opened.push_back( element );
+            }
+        }
+
+        if( !opened.empty() )
+            error( m_text.size(), "unexpected end of data" );
+    }
+};
+
+
+/**
+ * Struct EPACKAGE_JOB
+ * is an Eagle package converted into a MODULE template by a thread of
+ * EAGLE_PLUGIN::loadPackages().
+ */
+struct EPACKAGE_JOB
+{
+    CPTREE*     m_Package;
+    string      m_Name;         ///< package name, made a valid file name
+    string      m_Key;          ///< lookup key in the MODULE templates
+    string      m_Lib;          ///< library name, empty if loading a *.lbr file
+    string      m_XPath;        ///< where the package is, for error messages
+    MODULE*     m_Module;       ///< the template, NULL if the package could not be converted
+    IO_ERROR*   m_Error;        ///< why the package could not be converted
+    string      m_TreeError;    ///< or what() of the ptree_error thrown
+};
+
+
 EAGLE_PLUGIN::EAGLE_PLUGIN() :
     m_rules( new ERULES() ),
     m_xpath( new XPATH() ),
@@ -1104,8 +1437,8 @@ wxSize inline EAGLE_PLUGIN::kicad_fontz( double d ) const
 
 BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-    PTREE       doc;
+    LOCALE_IO       toggle;     // toggles on, then off, the C locale.
+    EAGLE_DOC_INDEX doc;
 
     init( aProperties );
 
@@ -1125,7 +1458,7 @@ BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const
         // and is not necessarily utf8.
         string filename = (const char*) aFileName.char_str( wxConvFile );
 
-        read_xml( filename, doc, xml_parser::trim_whitespace | xml_parser::no_comments );
+        doc.Read( filename );
 
         m_min_trace    = INT_MAX;
         m_min_via      = INT_MAX;
@@ -1191,6 +1524,7 @@ void EAGLE_PLUGIN::init( const PROPERTIES* aProperties )
 
     m_xpath->clear();
     m_pads_to_nets.clear();
+    m_netcode = 1;
 
     // m_templates.clear();     this is the FOOTPRINT cache too
 
@@ -1214,18 +1548,31 @@ void EAGLE_PLUGIN::clear_cu_map()
 }
 
 
-void EAGLE_PLUGIN::loadAllSections( CPTREE& aDoc )
+void EAGLE_PLUGIN::loadAllSections( EAGLE_DOC_INDEX& aDoc )
 {
-    CPTREE& drawing = aDoc.get_child( "eagle.drawing" );
-    CPTREE& board   = drawing.get_child( "board" );
+    aDoc.RequireSection( "eagle.drawing" );
+    aDoc.RequireSection( "eagle.drawing.board" );
+    aDoc.RequireSection( "eagle.drawing.board.designrules" );
+    aDoc.RequireSection( "eagle.drawing.layers" );
+    aDoc.RequireSection( "eagle.drawing.board.plain" );
+    aDoc.RequireSection( "eagle.drawing.board.signals" );
+    aDoc.RequireSection( "eagle.drawing.board.libraries" );
+    aDoc.RequireSection( "eagle.drawing.board.elements" );
+
+    // Each element is read into its own tree, freed once converted, so the whole
+    // document is never held in a tree.  The layers come before the board in the file,
+    // but the design rules come after the packages, and the signals after the elements,
+    // while they are needed before them: the sections are read in the order of their
+    // dependencies.
 
     m_xpath->push( "eagle.drawing" );
 
     {
         m_xpath->push( "board" );
 
-        CPTREE& designrules = board.get_child( "designrules" );
-        loadDesignRules( designrules );
+        CPTREE& designrules = aDoc.Parse( aDoc.m_DesignRules[0] );
+        loadDesignRules( designrules.get_child( "designrules" ) );
+        aDoc.FreeTrees();
 
         m_xpath->pop();
     }
@@ -1233,8 +1580,9 @@ void EAGLE_PLUGIN::loadAllSections( CPTREE& aDoc )
     {
         m_xpath->push( "layers" );
 
-        CPTREE& layers = drawing.get_child( "layers" );
-        loadLayerDefs( layers );
+        CPTREE& layers = aDoc.Parse( aDoc.m_Layers[0] );
+        loadLayerDefs( layers.get_child( "layers" ) );
+        aDoc.FreeTrees();
 
         m_xpath->pop();
     }
@@ -1242,17 +1590,47 @@ void EAGLE_PLUGIN::loadAllSections( CPTREE& aDoc )
     {
         m_xpath->push( "board" );
 
-        CPTREE& plain = board.get_child( "plain" );
-        loadPlain( plain );
+        // loadPlain(), loadSignals() and loadElements() walk the children of their tree:
+        // give them trees holding a single graphic item, signal or element.
+        for( unsigned i = 0;  i < aDoc.m_Plain.size();  ++i )
+        {
+            loadPlain( aDoc.Parse( aDoc.m_Plain[i] ) );
+            aDoc.FreeTrees();
+        }
 
-        CPTREE&  signals = board.get_child( "signals" );
-        loadSignals( signals );
+        for( unsigned i = 0;  i < aDoc.m_Signals.size();  ++i )
+        {
+            loadSignals( aDoc.Parse( aDoc.m_Signals[i] ) );
+            aDoc.FreeTrees();
+        }
+
+        {
+            // The libraries are kept until all their packages are converted
+            EPACKAGE_JOBS   jobs;
+
+            m_xpath->push( "libraries.library", "name" );
+
+            for( unsigned i = 0;  i < aDoc.m_Libraries.size();  ++i )
+            {
+                CPTREE&         library  = aDoc.Parse( aDoc.m_Libraries[i] ).get_child( "library" );
+                const string&   lib_name = library.get<string>( "<xmlattr>.name" );
 
-        CPTREE&  libs = board.get_child( "libraries" );
-        loadLibraries( libs );
+                m_xpath->Value( lib_name.c_str() );
+
+                listPackages( library, &lib_name, jobs );
+            }
+
+            loadPackages( jobs );
+            aDoc.FreeTrees();
+
+            m_xpath->pop();
+        }
 
-        CPTREE& elems = board.get_child( "elements" );
-        loadElements( elems );
+        for( unsigned i = 0;  i < aDoc.m_Elements.size();  ++i )
+        {
+            loadElements( aDoc.Parse( aDoc.m_Elements[i] ) );
+            aDoc.FreeTrees();
+        }
 
         m_xpath->pop();     // "board"
     }
@@ -1347,7 +1725,7 @@ void EAGLE_PLUGIN::loadPlain( CPTREE& aGraphics )
                 DRAWSEGMENT* dseg = new DRAWSEGMENT( m_board );
                 m_board->Add( dseg, ADD_APPEND );
 
-                dseg->SetTimeStamp( timeStamp( gr->second ) );
+                dseg->SetTimeStamp( timeStamp() );
                 dseg->SetLayer( layer );
                 dseg->SetStart( wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ) );
                 dseg->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
@@ -1376,7 +1754,7 @@ void EAGLE_PLUGIN::loadPlain( CPTREE& aGraphics )
                 m_board->Add( pcbtxt, ADD_APPEND );
 
                 pcbtxt->SetLayer( layer );
-                pcbtxt->SetTimeStamp( timeStamp( gr->second ) );
+                pcbtxt->SetTimeStamp( timeStamp() );
                 pcbtxt->SetText( FROM_UTF8( t.text.c_str() ) );
                 pcbtxt->SetTextPosition( wxPoint( kicad_x( t.x ), kicad_y( t.y ) ) );
 
@@ -1467,7 +1845,7 @@ void EAGLE_PLUGIN::loadPlain( CPTREE& aGraphics )
                 m_board->Add( dseg, ADD_APPEND );
 
                 dseg->SetShape( S_CIRCLE );
-                dseg->SetTimeStamp( timeStamp( gr->second ) );
+                dseg->SetTimeStamp( timeStamp() );
                 dseg->SetLayer( layer );
                 dseg->SetStart( wxPoint( kicad_x( c.x ), kicad_y( c.y ) ) );
                 dseg->SetEnd( wxPoint( kicad_x( c.x + c.radius ), kicad_y( c.y ) ) );
@@ -1491,7 +1869,7 @@ void EAGLE_PLUGIN::loadPlain( CPTREE& aGraphics )
                 ZONE_CONTAINER* zone = new ZONE_CONTAINER( m_board );
                 m_board->Add( zone, ADD_APPEND );
 
-                zone->SetTimeStamp( timeStamp( gr->second ) );
+                zone->SetTimeStamp( timeStamp() );
                 zone->SetLayer( layer );
                 zone->SetNet( 0 );
 
@@ -1569,6 +1947,15 @@ void EAGLE_PLUGIN::loadPlain( CPTREE& aGraphics )
 
 
 void EAGLE_PLUGIN::loadLibrary( CPTREE& aLib, const string* aLibName )
+{
+    EPACKAGE_JOBS   jobs;
+
+    listPackages( aLib, aLibName, jobs );
+    loadPackages( jobs );
+}
+
+
+void EAGLE_PLUGIN::listPackages( CPTREE& aLib, const string* aLibName, EPACKAGE_JOBS& aJobs )
 {
     m_xpath->push( "packages" );
 
@@ -1583,64 +1970,139 @@ void EAGLE_PLUGIN::loadLibrary( CPTREE& aLib, const string* aLibName )
     {
         m_xpath->push( "package", "name" );
 
-        const string& pack_ref = package->second.get<string>( "<xmlattr>.name" );
+        EPACKAGE_JOB    job;
 
-        string pack_name( pack_ref );
+        job.m_Package = &package->second;
+        job.m_Name    = package->second.get<string>( "<xmlattr>.name" );
 
-        ReplaceIllegalFileNameChars( &pack_name );
+        ReplaceIllegalFileNameChars( &job.m_Name );
 
-#if 0 && defined(DEBUG)
-        if( pack_name == "TO220H" )
+        m_xpath->Value( job.m_Name.c_str() );
+
+        job.m_Key     = aLibName ? makeKey( *aLibName, job.m_Name ) : job.m_Name;
+        job.m_Lib     = aLibName ? *aLibName : string();
+        job.m_XPath   = m_xpath->Contents();
+        job.m_Module  = NULL;
+        job.m_Error   = NULL;
+
+        aJobs.push_back( job );
+
+        m_xpath->pop();
+    }
+
+    m_xpath->pop();     // "packages"
+}
+
+
+void EAGLE_PLUGIN::convertPackage( EPACKAGE_JOBS* aJobs, unsigned aJob ) const
+{
+    EPACKAGE_JOB& job = (*aJobs)[aJob];
+
+    try
+    {
+        job.m_Module = makeModule( *job.m_Package, job.m_Name );
+    }
+    catch( const ptree_error& pte )
+    {
+        job.m_TreeError = pte.what();
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        job.m_Error = new IO_ERROR( ioe );
+    }
+    // Nothing can be thrown out of a worker thread, map anything unexpected into
+    // the expected.
+    catch( const std::exception& se )
+    {
+        try
         {
-            int breakhere = 1;
-            (void) breakhere;
+            THROW_IO_ERROR( se.what() );
         }
-#endif
-        m_xpath->Value( pack_name.c_str() );
+        catch( const IO_ERROR& ioe )
+        {
+            job.m_Error = new IO_ERROR( ioe );
+        }
+    }
+}
+
 
-        string key = aLibName ? makeKey( *aLibName, pack_name ) : pack_name;
+void EAGLE_PLUGIN::loadPackages( EPACKAGE_JOBS& aJobs )
+{
+    // Boards and libraries hold from a few packages to several hundreds, spread the
+    // conversion over the threads this call may use.  A library read by a worker thread
+    // of FOOTPRINT_LIST gets its share of the cores as a property.
+    UTF8        value;
+    unsigned    budget = 0;
 
-        MODULE* m = makeModule( package->second, pack_name );
+    if( m_props && m_props->Value( PROPERTY_THREAD_BUDGET, &value ) )
+        budget = strtoul( value.c_str(), NULL, 10 );
 
-        // add the templating MODULE to the MODULE template factory "m_templates"
-        std::pair<MODULE_ITER, bool> r = m_templates.insert( key, m );
+    ParallelFor( aJobs.size(), boost::bind( &EAGLE_PLUGIN::convertPackage, this, &aJobs, _1 ),
+                 budget );
+
+    // Add the templating MODULEs to the MODULE template factory "m_templates" in the
+    // order of the packages, up to the first one which failed, as when the packages were
+    // converted one after the other.
+    unsigned    ii;
+    wxString    emsg;
+
+    for( ii = 0; ii < aJobs.size(); ii++ )
+    {
+        EPACKAGE_JOB& job = aJobs[ii];
+
+        if( job.m_Error || !job.m_TreeError.empty() )
+            break;
+
+        // m_templates takes the ownership of the MODULE, even if not inserted
+        MODULE* m = job.m_Module;
+        job.m_Module = NULL;
+
+        std::pair<MODULE_ITER, bool> r = m_templates.insert( job.m_Key, m );
 
         if( !r.second
             // && !( m_props && m_props->Value( "ignore_duplicates" ) )
           )
         {
-            wxString lib = aLibName ? FROM_UTF8( aLibName->c_str() ) : m_lib_path;
-            wxString pkg = FROM_UTF8( pack_name.c_str() );
+            wxString lib = job.m_Lib.size() ? FROM_UTF8( job.m_Lib.c_str() ) : m_lib_path;
+            wxString pkg = FROM_UTF8( job.m_Name.c_str() );
 
-            wxString emsg = wxString::Format(
+            emsg = wxString::Format(
                 _( "<package> name: '%s' duplicated in eagle <library>: '%s'" ),
                 GetChars( pkg ),
                 GetChars( lib )
                 );
-            THROW_IO_ERROR( emsg );
+            break;
         }
-
-        m_xpath->pop();
     }
 
-    m_xpath->pop();     // "packages"
-}
-
+    if( ii == aJobs.size() )
+        return;
 
-void EAGLE_PLUGIN::loadLibraries( CPTREE& aLibs )
-{
-    m_xpath->push( "libraries.library", "name" );
+    std::auto_ptr<IO_ERROR> error( aJobs[ii].m_Error );
 
-    for( CITER library = aLibs.begin();  library != aLibs.end();  ++library )
+    if( !aJobs[ii].m_TreeError.empty() )
     {
-        const string& lib_name = library->second.get<string>( "<xmlattr>.name" );
+        // As the ptree_error handlers of Load() and cacheLib() would report it
+        string errmsg = aJobs[ii].m_TreeError;
 
-        m_xpath->Value( lib_name.c_str() );
+        errmsg += " @\n";
+        errmsg += aJobs[ii].m_XPath;
 
-        loadLibrary( library->second, &lib_name );
+        emsg = FROM_UTF8( errmsg.c_str() );
     }
 
-    m_xpath->pop();
+    for( ; ii < aJobs.size(); ii++ )
+    {
+        delete aJobs[ii].m_Module;
+
+        if( aJobs[ii].m_Error != error.get() )
+            delete aJobs[ii].m_Error;
+    }
+
+    if( error.get() )
+        throw IO_ERROR( *error );
+
+    THROW_IO_ERROR( emsg );
 }
 
 
@@ -2050,7 +2512,7 @@ void EAGLE_PLUGIN::packageText( MODULE* aModule, CPTREE& aTree ) const
         aModule->GraphicalItems().PushBack( txt );
     }
 
-    txt->SetTimeStamp( timeStamp( aTree ) );
+    txt->SetTimeStamp( timeStamp() );
     txt->SetText( FROM_UTF8( t.text.c_str() ) );
 
     wxPoint pos( kicad_x( t.x ), kicad_y( t.y ) );
@@ -2149,7 +2611,7 @@ void EAGLE_PLUGIN::packageRectangle( MODULE* aModule, CPTREE& aTree ) const
         dwg->SetLayer( layer );
         dwg->SetWidth( 0 );
 
-        dwg->SetTimeStamp( timeStamp( aTree ) );
+        dwg->SetTimeStamp( timeStamp() );
 
         std::vector<wxPoint> pts;
 
@@ -2195,7 +2657,7 @@ void EAGLE_PLUGIN::packagePolygon( MODULE* aModule, CPTREE& aTree ) const
 
         dwg->SetLayer( layer );
 
-        dwg->SetTimeStamp( timeStamp( aTree ) );
+        dwg->SetTimeStamp( timeStamp() );
 
         std::vector<wxPoint> pts;
         pts.reserve( aTree.size() );
@@ -2238,7 +2700,7 @@ void EAGLE_PLUGIN::packageCircle( MODULE* aModule, CPTREE& aTree ) const
     }
 
     gr->SetLayer( layer );
-    gr->SetTimeStamp( timeStamp( aTree ) );
+    gr->SetTimeStamp( timeStamp() );
 
     gr->SetStart0( wxPoint( kicad_x( e.x ), kicad_y( e.y ) ) );
     gr->SetEnd0( wxPoint( kicad_x( e.x + e.radius ), kicad_y( e.y ) ) );
@@ -2343,8 +2805,6 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
 
     m_xpath->push( "signals.signal", "name" );
 
-    int netCode = 1;
-
     for( CITER net = aSignals.begin();  net != aSignals.end();  ++net )
     {
         bool    sawPad = false;
@@ -2377,7 +2837,7 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
                 {
                     TRACK*  t = new TRACK( m_board );
 
-                    t->SetTimeStamp( timeStamp( it->second ) );
+                    t->SetTimeStamp( timeStamp() );
 
                     t->SetPosition( wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ) );
                     t->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
@@ -2388,7 +2848,7 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
 
                     t->SetWidth( width );
                     t->SetLayer( layer );
-                    t->SetNet( netCode );
+                    t->SetNet( m_netcode );
 
                     m_board->m_Track.Insert( t, NULL );
                 }
@@ -2446,14 +2906,14 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
                     else
                         via->SetShape( VIA_BLIND_BURIED );
 
-                    via->SetTimeStamp( timeStamp( it->second ) );
+                    via->SetTimeStamp( timeStamp() );
 
                     wxPoint pos( kicad_x( v.x ), kicad_y( v.y ) );
 
                     via->SetPosition( pos  );
                     via->SetEnd( pos );
 
-                    via->SetNet( netCode );
+                    via->SetNet( m_netcode );
 
                     via->SetShape( S_CIRCLE );  // @todo should be in SEGVIA constructor
                 }
@@ -2473,7 +2933,7 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
 
                 // D(printf( "adding refname:'%s' pad:'%s' netcode:%d netname:'%s'\n", reference.c_str(), pad.c_str(), netCode, nname.c_str() );)
 
-                m_pads_to_nets[ key ] = ENET( netCode, nname );
+                m_pads_to_nets[ key ] = ENET( m_netcode, nname );
 
                 m_xpath->pop();
 
@@ -2494,9 +2954,9 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
                     m_board->Add( zone, ADD_APPEND );
                     zones.push_back( zone );
 
-                    zone->SetTimeStamp( timeStamp( it->second ) );
+                    zone->SetTimeStamp( timeStamp() );
                     zone->SetLayer( layer );
-                    zone->SetNet( netCode );
+                    zone->SetNet( m_netcode );
                     zone->SetNetName( netName );
 
                     CPolyLine::HATCH_STYLE outline_hatch = CPolyLine::DIAGONAL_EDGE;
@@ -2561,7 +3021,7 @@ void EAGLE_PLUGIN::loadSignals( CPTREE& aSignals )
             // therefore omit this signal/net.
         }
         else
-            m_board->AppendNet( new NETINFO_ITEM( m_board, netName, netCode++ ) );
+            m_board->AppendNet( new NETINFO_ITEM( m_board, netName, m_netcode++ ) );
     }
 
     m_xpath->pop();     // "signals.signal"
@@ -36,6 +36,7 @@
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <boost/ptr_container/ptr_map.hpp>
 #include <map>
+#include <vector>
 
 
 class MODULE;
@@ -64,11 +65,15 @@ typedef boost::property_tree::ptree     PTREE;
 typedef const PTREE                     CPTREE;
 
 struct EELEMENT;
+struct EPACKAGE_JOB;
+class EAGLE_DOC_INDEX;
 class XPATH;
 struct ERULES;
 struct EATTR;
 class TEXTE_MODULE;
 
+typedef std::vector<EPACKAGE_JOB>   EPACKAGE_JOBS;
+
 
 /**
  * Class EAGLE_PLUGIN
@@ -127,6 +132,7 @@ private:
     int         m_hole_count;       ///< generates unique module names from eagle "hole"s.
 
     NET_MAP     m_pads_to_nets;     ///< net list
+    int         m_netcode;          ///< net code of the next signal loaded
 
     MODULE_MAP  m_templates;        ///< is part of a MODULE factory that operates
                                     ///< using copy construction.
@@ -175,7 +181,13 @@ private:
 
     // all these loadXXX() throw IO_ERROR or ptree_error exceptions:
 
-    void loadAllSections( CPTREE& aDocument );
+    /**
+     * Function loadAllSections
+     * loads the sections of an Eagle board in the order they depend on each other,
+     * reading each element converted into its own small document tree.
+     */
+    void loadAllSections( EAGLE_DOC_INDEX& aDocument );
+
     void loadDesignRules( CPTREE& aDesignRules );
     void loadLayerDefs( CPTREE& aLayers );
     void loadPlain( CPTREE& aPlain );
@@ -194,7 +206,24 @@ private:
      */
     void loadLibrary( CPTREE& aLib, const std::string* aLibName );
 
-    void loadLibraries( CPTREE& aLibs );
+    /**
+     * Function listPackages
+     * appends the packages of the Eagle "library" XML element \a aLib to \a aJobs, see
+     * loadLibrary().  \a aLib must not be freed before the jobs are done.
+     */
+    void listPackages( CPTREE& aLib, const std::string* aLibName, EPACKAGE_JOBS& aJobs );
+
+    /**
+     * Function loadPackages
+     * converts the packages listed in \a aJobs into MODULE templates using several
+     * threads, and adds them to m_templates in the order of the list.
+     * @throw IO_ERROR for the first package in the list which could not be converted
+     *   or is duplicated.
+     */
+    void loadPackages( EPACKAGE_JOBS& aJobs );
+
+    /// convert the package aJob of aJobs, run by the threads of loadPackages().
+    void convertPackage( EPACKAGE_JOBS* aJobs, unsigned aJob ) const;
     void loadElements( CPTREE& aElements );
 
     void orientModuleAndText( MODULE* m, const EELEMENT& e, const EATTR* nameAttr, const EATTR* valueAttr );
@@ -0,0 +1,383 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gal_benchmark.cpp
+ * @brief Renders boards with the Cairo GAL into an offscreen buffer and reports the frame
+ * rate for several zoom levels, as well as the cost of every layer.
+ *
+ * Usage: gal_benchmark [-s WIDTHxHEIGHT] [-f FRAMES] board1.kicad_pcb [board2.kicad_pcb ...]
+ *
+ * No GPU is needed, but wxWidgets still requires a display connection (e.g. Xvfb on
+ * headless machines), as CAIRO_GAL is a window.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include <fctsys.h>
+#include <wx/frame.h>
+
+#include <appl_wxstruct.h>
+#include <common.h>
+#include <profile.h>
+#include <class_colors_design_settings.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <io_mgr.h>
+#include <pcb_painter.h>
+
+#include <view/view.h>
+#include <view/view_item.h>
+#include <gal/cairo/cairo_gal.h>
+
+#define METRIC_UNIT_LENGTH (1e9)
+
+// Normally defined by the application, the benchmark is a standalone program
+COLORS_DESIGN_SETTINGS g_ColorsSettings;
+
+///> Zoom levels, relative to the view showing the whole board
+static const double ZOOM_LEVELS[] = { 1.0, 2.0, 4.0, 8.0, 16.0 };
+
+
+/**
+ * Class GAL_BENCHMARK
+ * renders a single board offscreen and measures the time spent.
+ */
+class GAL_BENCHMARK
+{
+public:
+    GAL_BENCHMARK( wxFrame* aParent, int aWidth, int aHeight, int aFrames ) :
+        m_frames( aFrames )
+    {
+        m_gal = new KIGFX::CAIRO_GAL( aParent );
+        m_gal->ResizeScreen( aWidth, aHeight );
+        m_gal->SetOffscreen( true );
+        m_gal->SetWorldUnitLength( 1.0 / METRIC_UNIT_LENGTH * 2.54 );   // 1 inch in nanometers
+        m_gal->SetScreenDPI( 106 );
+        m_gal->SetLookAtPoint( VECTOR2D( 0, 0 ) );
+        m_gal->SetZoomFactor( 1.0 );
+        m_gal->ComputeWorldScreenMatrix();
+
+        m_painter = new KIGFX::PCB_PAINTER( m_gal );
+
+        // Static view, items are not linked with it
+        m_view = new KIGFX::VIEW( false );
+        m_view->SetPainter( m_painter );
+        m_view->SetGAL( m_gal );
+    }
+
+    ~GAL_BENCHMARK()
+    {
+        m_view->Clear();
+        delete m_view;
+        delete m_painter;
+        m_gal->Destroy();
+    }
+
+    void Run( BOARD* aBoard )
+    {
+        KIGFX::PCB_RENDER_SETTINGS* settings = new KIGFX::PCB_RENDER_SETTINGS();
+        settings->ImportLegacyColors( aBoard->GetColorsSettings() );
+        m_painter->ApplySettings( settings );
+
+        prof_counter loadTime;
+        prof_start( &loadTime );
+        loadBoard( aBoard );
+        prof_end( &loadTime );
+
+        printf( "  %d items, view loaded in %.1f ms\n", (int) m_items.size(), loadTime.msecs() );
+
+        EDA_RECT bbox = aBoard->ComputeBoundingBox();
+        m_view->SetViewport( BOX2D( VECTOR2D( bbox.GetOrigin() ), VECTOR2D( bbox.GetSize() ) ) );
+
+        const double   fitScale = m_view->GetScale();
+        const VECTOR2D center   = m_view->GetCenter();
+
+        printf( "  %8s %12s %12s %10s %10s\n", "zoom", "first [ms]", "avg [ms]", "fps", "drawn" );
+
+        for( unsigned int i = 0; i < sizeof( ZOOM_LEVELS ) / sizeof( double ); ++i )
+        {
+            m_view->SetScale( fitScale * ZOOM_LEVELS[i] );
+            m_view->SetCenter( center );
+
+            // The first frame includes creating cached groups, report it separately
+            double first = renderFrame();
+            double avg   = renderFrames();
+
+            printf( "  %8.1f %12.2f %12.2f %10.1f %10d\n", ZOOM_LEVELS[i], first, avg,
+                    avg > 0.0 ? 1000.0 / avg : 0.0, m_view->GetDrawnItemsCount() );
+        }
+
+        // Per-layer cost, measured with the whole board visible
+        m_view->SetScale( fitScale );
+        m_view->SetCenter( center );
+        reportLayerCosts( aBoard );
+    }
+
+private:
+    ///> Adds all board items to the view, the same way as PCB_EDIT_FRAME::ViewReloadBoard()
+    void loadBoard( BOARD* aBoard )
+    {
+        m_view->Clear();
+        m_items.clear();
+
+        for( int i = 0; i < aBoard->GetAreaCount(); ++i )
+            m_items.push_back( aBoard->GetArea( i ) );
+
+        for( BOARD_ITEM* drawing = aBoard->m_Drawings; drawing; drawing = drawing->Next() )
+            m_items.push_back( drawing );
+
+        for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+            m_items.push_back( track );
+
+        for( MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+        {
+            for( D_PAD* pad = module->Pads().GetFirst(); pad; pad = pad->Next() )
+                m_items.push_back( pad );
+
+            for( BOARD_ITEM* drawing = module->GraphicalItems().GetFirst(); drawing;
+                 drawing = drawing->Next() )
+            {
+                m_items.push_back( drawing );
+            }
+
+            m_items.push_back( &module->Reference() );
+            m_items.push_back( &module->Value() );
+            m_items.push_back( module );
+        }
+
+        for( SEGZONE* zone = aBoard->m_Zone; zone; zone = zone->Next() )
+            m_items.push_back( zone );
+
+        m_view->Add( m_items );
+
+        // Netnames are drawn only when the scale is sufficient, so they are not cached
+        for( LAYER_NUM layer = FIRST_LAYER; layer < KIGFX::VIEW::VIEW_MAX_LAYERS; ++layer )
+        {
+            if( IsNetnameLayer( layer ) )
+                m_view->SetLayerTarget( layer, KIGFX::TARGET_NONCACHED );
+        }
+
+        m_view->RecacheAllItems( true );
+    }
+
+    ///> Renders a single frame and returns the time it took [ms]
+    double renderFrame()
+    {
+        prof_counter frameTime;
+
+        m_view->MarkDirty();
+
+        prof_start( &frameTime );
+
+        m_gal->BeginDrawing();
+        m_gal->SetBackgroundColor( m_painter->GetSettings()->GetBackgroundColor() );
+        m_gal->ClearScreen();
+        m_view->ClearTargets();
+        m_view->Redraw();
+        m_gal->EndDrawing();
+
+        prof_end( &frameTime );
+
+        return frameTime.msecs();
+    }
+
+    ///> Renders m_frames frames and returns the average frame time [ms]
+    double renderFrames()
+    {
+        double total = 0.0;
+
+        for( int i = 0; i < m_frames; ++i )
+            total += renderFrame();
+
+        return total / m_frames;
+    }
+
+    void reportLayerCosts( BOARD* aBoard )
+    {
+        std::set<int> usedLayers;
+        int layers[KIGFX::VIEW::VIEW_MAX_LAYERS], layersCount;
+
+        for( unsigned int i = 0; i < m_items.size(); ++i )
+        {
+            m_items[i]->ViewGetLayers( layers, layersCount );
+            usedLayers.insert( layers, layers + layersCount );
+        }
+
+        std::vector<std::pair<double, int> > costs;
+
+        for( std::set<int>::const_iterator it = usedLayers.begin(); it != usedLayers.end(); ++it )
+        {
+            for( std::set<int>::const_iterator l = usedLayers.begin(); l != usedLayers.end(); ++l )
+                m_view->SetLayerVisible( *l, *l == *it );
+
+            costs.push_back( std::make_pair( renderFrames(), *it ) );
+        }
+
+        for( std::set<int>::const_iterator l = usedLayers.begin(); l != usedLayers.end(); ++l )
+            m_view->SetLayerVisible( *l, true );
+
+        std::sort( costs.rbegin(), costs.rend() );
+
+        printf( "  %-24s %12s\n", "layer", "avg [ms]" );
+
+        for( unsigned int i = 0; i < costs.size(); ++i )
+        {
+            int      layer = costs[i].second;
+            wxString name;
+
+            if( layer < NB_PCB_LAYERS )
+                name = aBoard->GetLayerName( layer );
+            else
+                name.Printf( wxT( "GAL layer %d" ), layer );
+
+            printf( "  %-24s %12.2f\n", TO_UTF8( name ), costs[i].first );
+        }
+    }
+
+    int                         m_frames;
+    KIGFX::CAIRO_GAL*           m_gal;
+    KIGFX::PCB_PAINTER*         m_painter;
+    KIGFX::VIEW*                m_view;
+    std::vector<KIGFX::VIEW_ITEM*> m_items;
+};
+
+
+static void usage()
+{
+    fprintf( stderr, "Usage: gal_benchmark [-s WIDTHxHEIGHT] [-f FRAMES] "
+                     "board.kicad_pcb [...]\n" );
+}
+
+
+/*
+ * MacOSX: Needed for file association, the benchmark does not open files this way
+ */
+void EDA_APP::MacOpenFile( const wxString& aFileName )
+{
+}
+
+
+// EDA_APP, as the common code expects it from wxGetApp()
+IMPLEMENT_APP( EDA_APP )
+
+
+/*
+ * The benchmark runs from OnInit(): it returns false if the command line is wrong or
+ * a board cannot be loaded, so the exit status is not 0.  Otherwise the application
+ * exits once the frame is deleted.
+ */
+bool EDA_APP::OnInit()
+{
+    int                     width  = 1280;
+    int                     height = 1024;
+    int                     frames = 10;
+    std::vector<wxString>   files;
+
+    InitEDA_Appl( wxT( "GAL benchmark" ), APP_PCBNEW_T );
+
+    for( int i = 1; i < argc; ++i )
+    {
+        wxString arg( argv[i] );
+
+        if( arg == wxT( "-s" ) && i + 1 < argc )
+        {
+            wxString size( argv[++i] );
+            long w, h;
+
+            if( !size.BeforeFirst( 'x' ).ToLong( &w ) || !size.AfterFirst( 'x' ).ToLong( &h ) )
+            {
+                usage();
+                return false;
+            }
+
+            width  = w;
+            height = h;
+        }
+        else if( arg == wxT( "-f" ) && i + 1 < argc )
+        {
+            long f;
+
+            if( !wxString( argv[++i] ).ToLong( &f ) || f <= 0 )
+            {
+                usage();
+                return false;
+            }
+
+            frames = f;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if( files.empty() )
+    {
+        usage();
+        return false;
+    }
+
+    SetLocaleTo_C_standard();
+
+    wxFrame* frame = new wxFrame( NULL, wxID_ANY, wxT( "GAL benchmark" ),
+                                  wxDefaultPosition, wxSize( width, height ) );
+    bool     success = true;
+
+    printf( "Viewport %dx%d, %d frames per measurement\n", width, height, frames );
+
+    for( unsigned int i = 0; i < files.size(); ++i )
+    {
+        BOARD* board = NULL;
+
+        printf( "%s\n", TO_UTF8( files[i] ) );
+
+        try
+        {
+            board = IO_MGR::Load( IO_MGR::KICAD, files[i] );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            fprintf( stderr, "%s\n", TO_UTF8( ioe.errorText ) );
+            success = false;
+            continue;
+        }
+
+        {
+            // Every board gets a fresh GAL, so cached groups do not accumulate
+            GAL_BENCHMARK benchmark( frame, width, height, frames );
+            benchmark.Run( board );
+        }
+
+        delete board;
+    }
+
+    frame->Destroy();
+
+    return success;
+}
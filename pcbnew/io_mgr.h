@@ -33,6 +33,11 @@ class BOARD;
 class PLUGIN;
 class MODULE;
 
+/// The number of threads a PLUGIN may use to read a footprint library, set by the
+/// caller of PLUGIN::FootprintEnumerate() when it already reads other libraries
+/// concurrently.  Without it, a PLUGIN called from a worker thread reads serially.
+#define PROPERTY_THREAD_BUDGET  "thread_budget"
+
 /**
  * Class PROPERTIES
  * is a name/value tuple with unique names and optional values.  The names
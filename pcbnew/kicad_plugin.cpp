@@ -45,11 +45,14 @@
 #include <zones.h>
 #include <kicad_plugin.h>
 #include <pcb_parser.h>
+#include <fp_info_index.h>
+#include <parallel_for.h>
 
 #include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/wfstream.h>
 #include <boost/ptr_container/ptr_map.hpp>
+#include <boost/bind.hpp>
 #include <memory.h>
 
 #define FMTIU        BOARD_ITEM::FormatInternalUnits
@@ -87,6 +90,7 @@ public:
     bool        IsModified() const;
 
     MODULE*     GetModule() const { return m_module.get(); }
+    wxDateTime  GetModificationTime() const { return m_mod_time; }
     void        UpdateModificationTime() { m_mod_time = m_file_name.GetModificationTime(); }
 };
 
@@ -145,7 +149,13 @@ public:
     /// save the entire legacy library to m_lib_name;
     void Save();
 
-    void Load();
+    /**
+     * Function Load
+     * reads all the footprint files of the library.
+     * @param aThreadBudget is the number of threads the files may be parsed with, 0 for
+     *  the default of ParallelFor().
+     */
+    void Load( unsigned aThreadBudget = 0 );
 
     void Remove( const wxString& aFootprintName );
 
@@ -178,6 +188,10 @@ public:
      * @return true if \a aPath is the same as the cache path.
      */
     bool IsPath( const wxString& aPath ) const;
+
+private:
+    /// Save the #FP_INFO_INDEX of the library, if the index is outdated.
+    void saveIndex();
 };
 
 
@@ -247,7 +261,57 @@ void FP_CACHE::Save()
 }
 
 
-void FP_CACHE::Load()
+/**
+ * Struct FP_LOAD_JOB
+ * is a footprint file parsed by a worker thread of FP_CACHE::Load().
+ */
+struct FP_LOAD_JOB
+{
+    wxFileName  m_FileName;
+    MODULE*     m_Module;       ///< The footprint read, NULL if the file could not be read
+    IO_ERROR*   m_Error;        ///< Why the file could not be read, can be a PARSE_ERROR
+};
+
+
+static void parseFootprintFile( std::vector<FP_LOAD_JOB>* aJobs, unsigned aJob )
+{
+    FP_LOAD_JOB& job = (*aJobs)[aJob];
+
+    try
+    {
+        // The parser of the PCB_IO cannot be shared by threads, each job has its own.
+        PCB_PARSER          parser;
+        FILE_LINE_READER    reader( job.m_FileName.GetFullPath() );
+
+        parser.SetLineReader( &reader );
+
+        job.m_Module = (MODULE*) parser.Parse();
+    }
+    catch( const PARSE_ERROR& pe )
+    {
+        job.m_Error = new PARSE_ERROR( pe );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        job.m_Error = new IO_ERROR( ioe );
+    }
+    // Nothing can be thrown out of a worker thread, map anything unexpected into
+    // the expected.
+    catch( const std::exception& se )
+    {
+        try
+        {
+            THROW_IO_ERROR( se.what() );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            job.m_Error = new IO_ERROR( ioe );
+        }
+    }
+}
+
+
+void FP_CACHE::Load( unsigned aThreadBudget )
 {
     wxDir dir( m_lib_path.GetPath() );
 
@@ -266,23 +330,59 @@ void FP_CACHE::Load()
 
     if( dir.GetFirst( &fpFileName, wildcard, wxDIR_FILES ) )
     {
+        std::vector<FP_LOAD_JOB> jobs;
+
         do
         {
+            FP_LOAD_JOB job;
+
             // prepend the libpath into fullPath
-            wxFileName fullPath( m_lib_path.GetPath(), fpFileName );
+            job.m_FileName = wxFileName( m_lib_path.GetPath(), fpFileName );
+            job.m_Module   = NULL;
+            job.m_Error    = NULL;
 
-            FILE_LINE_READER    reader( fullPath.GetFullPath() );
+            jobs.push_back( job );
 
-            m_owner->m_parser->SetLineReader( &reader );
+        } while( dir.GetNext( &fpFileName ) );
+
+        // Libraries hold from a few footprints to several hundreds, spread the parsing
+        // over the threads this call may use.
+        ParallelFor( jobs.size(), boost::bind( parseFootprintFile, &jobs, _1 ), aThreadBudget );
+
+        // Cache the footprints in the directory order, up to the first file which could
+        // not be read, as when the files were read one after the other.
+        unsigned ii;
 
-            std::string name = TO_UTF8( fullPath.GetName() );
-            MODULE*     footprint = (MODULE*) m_owner->m_parser->Parse();
+        for( ii = 0; ii < jobs.size() && !jobs[ii].m_Error; ii++ )
+        {
+            const wxFileName&   fullPath = jobs[ii].m_FileName;
+            std::string         name = TO_UTF8( fullPath.GetName() );
+            MODULE*             footprint = jobs[ii].m_Module;
 
             // The footprint name is the file name without the extension.
             footprint->SetFPID( fullPath.GetName() );
             m_modules.insert( name, new FP_CACHE_ITEM( footprint, fullPath ) );
+        }
 
-        } while( dir.GetNext( &fpFileName ) );
+        if( ii < jobs.size() )
+        {
+            std::auto_ptr<IO_ERROR> error( jobs[ii].m_Error );
+
+            for( ; ii < jobs.size(); ii++ )
+            {
+                delete jobs[ii].m_Module;
+
+                if( jobs[ii].m_Error != error.get() )
+                    delete jobs[ii].m_Error;
+            }
+
+            if( PARSE_ERROR* pe = dynamic_cast<PARSE_ERROR*>( error.get() ) )
+                throw PARSE_ERROR( *pe );
+
+            throw IO_ERROR( *error );
+        }
+
+        saveIndex();
 
         // Remember the file modification time of library file when the
         // cache snapshot was made, so that in a networked environment we will
@@ -292,6 +392,35 @@ void FP_CACHE::Load()
 }
 
 
+void FP_CACHE::saveIndex()
+{
+    FP_INFO_INDEX index( GetPath() );
+
+    // Do not rewrite the index if it is still good.
+    if( index.Read() )
+        return;
+
+    for( MODULE_CITER it = m_modules.begin();  it != m_modules.end();  ++it )
+    {
+        const MODULE* module = it->second->GetModule();
+
+        index.Add( FROM_UTF8( it->first.c_str() ), module->GetDescription(),
+                   module->GetKeywords(), module->GetPadCount( MODULE::DO_NOT_INCLUDE_NPTH ),
+                   it->second->GetModificationTime() );
+    }
+
+    try
+    {
+        index.Write();
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        // The index only saves time to the footprint lists, the library is still usable.
+        wxLogTrace( traceFootprintLibrary, wxT( "%s" ), GetChars( ioe.errorText ) );
+    }
+}
+
+
 void FP_CACHE::Remove( const wxString& aFootprintName )
 {
 
@@ -372,6 +501,80 @@ bool FP_CACHE::IsModified( const wxString& aLibPath, const wxString& aFootprintN
 }
 
 
+/*  Helpers of the most frequent nodes, formatted without printf(): their text is built in
+ *  a reusable line, then output at once with OUTPUTFORMATTER::Write().  It is the same text
+ *  as OUTPUTFORMATTER::Print() gives for the equivalent format.
+ */
+
+/// Size from which a line being built is output, to bound the buffer on huge zone fillings
+static const unsigned FLUSH_LINE_SIZE = 65536;
+
+
+/// Same as the indentation of OUTPUTFORMATTER::Print()
+static inline void appendIndent( std::string& aLine, int aNestLevel )
+{
+    aLine.append( 2 * aNestLevel, ' ' );
+}
+
+
+/// Same as FMT_IU( aValue )
+static inline void appendIU( std::string& aLine, int aValue )
+{
+    char buf[FMT_IU_BUFSIZE];
+
+    aLine.append( buf, BOARD_ITEM::FormatInternalUnits( aValue, buf ) );
+}
+
+
+/// Same as FMT_IU( aPoint )
+static inline void appendIU( std::string& aLine, const wxPoint& aPoint )
+{
+    char buf[2 * FMT_IU_BUFSIZE];
+
+    aLine.append( buf, BOARD_ITEM::FormatInternalUnits( aPoint, buf ) );
+}
+
+
+/// Same as "%d"
+static void appendInt( std::string& aLine, int aValue )
+{
+    char        buf[16];
+    char*       end = buf + sizeof( buf );
+    char*       start = end;
+    unsigned    value = aValue < 0 ? 0u - (unsigned) aValue : (unsigned) aValue;
+
+    do
+    {
+        *--start = '0' + value % 10;
+        value /= 10;
+    } while( value );
+
+    if( aValue < 0 )
+        *--start = '-';
+
+    aLine.append( start, end );
+}
+
+
+/// Same as "%lX"
+static void appendHex( std::string& aLine, unsigned long aValue )
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    char        buf[2 * sizeof( unsigned long )];
+    char*       end = buf + sizeof( buf );
+    char*       start = end;
+
+    do
+    {
+        *--start = hexDigits[aValue & 0xF];
+        aValue >>= 4;
+    } while( aValue );
+
+    aLine.append( start, end );
+}
+
+
 void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* aProperties )
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
@@ -1186,19 +1389,40 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                                           aPad->GetAttribute() ) );
     }
 
-    m_out->Print( aNestLevel, "(pad %s %s %s",
-                  m_out->Quotew( aPad->GetPadName() ).c_str(),
-                  type, shape );
-    m_out->Print( 0, " (at %s", FMT_IU( aPad->GetPos0() ).c_str() );
+    // Pads are formatted without printf() up to their layers, the other parameters are
+    // seldom used.
+    std::string& line = m_line;
+
+    line.clear();
+    appendIndent( line, aNestLevel );
+
+    line += "(pad ";
+    line += m_out->Quotew( aPad->GetPadName() );
+    line += " ";
+    line += type;
+    line += " ";
+    line += shape;
+
+    line += " (at ";
+    appendIU( line, aPad->GetPos0() );
 
     if( aPad->GetOrientation() != 0.0 )
-        m_out->Print( 0, " %s", FMT_ANGLE( aPad->GetOrientation() ).c_str() );
+    {
+        line += " ";
+        line += FMT_ANGLE( aPad->GetOrientation() );
+    }
 
-    m_out->Print( 0, ")" );
-    m_out->Print( 0, " (size %s)", FMT_IU( aPad->GetSize() ).c_str() );
+    line += ")";
+    line += " (size ";
+    appendIU( line, wxPoint( aPad->GetSize().x, aPad->GetSize().y ) );
+    line += ")";
 
     if( (aPad->GetDelta().GetWidth()) != 0 || (aPad->GetDelta().GetHeight() != 0 ) )
-        m_out->Print( 0, " (rect_delta %s )", FMT_IU( aPad->GetDelta() ).c_str() );
+    {
+        line += " (rect_delta ";
+        appendIU( line, wxPoint( aPad->GetDelta().x, aPad->GetDelta().y ) );
+        line += " )";
+    }
 
     wxSize sz = aPad->GetDrillSize();
     wxPoint shapeoffset = aPad->GetOffset();
@@ -1206,23 +1430,35 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
     if( (sz.GetWidth() > 0) || (sz.GetHeight() > 0) ||
         (shapeoffset.x != 0) || (shapeoffset.y != 0) )
     {
-        m_out->Print( 0, " (drill" );
+        line += " (drill";
 
         if( aPad->GetDrillShape() == PAD_DRILL_OBLONG )
-            m_out->Print( 0, " oval" );
+            line += " oval";
 
         if( sz.GetWidth() > 0 )
-            m_out->Print( 0,  " %s", FMT_IU( sz.GetWidth() ).c_str() );
+        {
+            line += " ";
+            appendIU( line, sz.GetWidth() );
+        }
 
         if( sz.GetHeight() > 0  && sz.GetWidth() != sz.GetHeight() )
-            m_out->Print( 0,  " %s", FMT_IU( sz.GetHeight() ).c_str() );
+        {
+            line += " ";
+            appendIU( line, sz.GetHeight() );
+        }
 
         if( (shapeoffset.x != 0) || (shapeoffset.y != 0) )
-            m_out->Print( 0, " (offset %s)", FMT_IU( aPad->GetOffset() ).c_str() );
+        {
+            line += " (offset ";
+            appendIU( line, aPad->GetOffset() );
+            line += ")";
+        }
 
-        m_out->Print( 0, ")" );
+        line += ")";
     }
 
+    m_out->Write( line.data(), line.size() );
+
     formatLayers( aPad->GetLayerMask(), 0 );
 
     std::string output;
@@ -1335,6 +1571,12 @@ void PCB_IO::format( TEXTE_MODULE* aText, int aNestLevel ) const
 void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
     throw( IO_ERROR )
 {
+    // Tracks and vias are most of a board file, they are formatted without printf().
+    std::string& line = m_line;
+
+    line.clear();
+    appendIndent( line, aNestLevel );
+
     if( aTrack->Type() == PCB_VIA_T )
     {
         LAYER_NUM layer1, layer2;
@@ -1345,7 +1587,7 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
         wxCHECK_RET( board != 0, wxT( "Via " ) + via->GetSelectMenuText() +
                      wxT( " has no parent." ) );
 
-        m_out->Print( aNestLevel, "(via" );
+        line += "(via";
 
         via->ReturnLayerPair( &layer1, &layer2 );
 
@@ -1355,46 +1597,152 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
             break;
 
         case VIA_BLIND_BURIED:
-            m_out->Print( 0, " blind" );
+            line += " blind";
             break;
 
         case VIA_MICROVIA:
-            m_out->Print( 0, " micro" );
+            line += " micro";
             break;
 
         default:
             THROW_IO_ERROR( wxString::Format( _( "unknown via type %d"  ), aTrack->GetShape() ) );
         }
 
-        m_out->Print( 0, " (at %s) (size %s)",
-                      FMT_IU( aTrack->GetStart() ).c_str(),
-                      FMT_IU( aTrack->GetWidth() ).c_str() );
+        line += " (at ";
+        appendIU( line, aTrack->GetStart() );
+        line += ") (size ";
+        appendIU( line, aTrack->GetWidth() );
+        line += ")";
 
         if( aTrack->GetDrill() != UNDEFINED_DRILL_DIAMETER )
-            m_out->Print( 0, " (drill %s)", FMT_IU( aTrack->GetDrill() ).c_str() );
+        {
+            line += " (drill ";
+            appendIU( line, aTrack->GetDrill() );
+            line += ")";
+        }
 
-        m_out->Print( 0, " (layers %s %s)",
-                      m_out->Quotew( m_board->GetLayerName( layer1 ) ).c_str(),
-                      m_out->Quotew( m_board->GetLayerName( layer2 ) ).c_str() );
+        line += " (layers ";
+        line += m_out->Quotew( m_board->GetLayerName( layer1 ) );
+        line += " ";
+        line += m_out->Quotew( m_board->GetLayerName( layer2 ) );
+        line += ")";
     }
     else
     {
-        m_out->Print( aNestLevel, "(segment (start %s) (end %s) (width %s)",
-                      FMT_IU( aTrack->GetStart() ).c_str(), FMT_IU( aTrack->GetEnd() ).c_str(),
-                      FMT_IU( aTrack->GetWidth() ).c_str() );
-
-        m_out->Print( 0, " (layer %s)", m_out->Quotew( aTrack->GetLayerName() ).c_str() );
+        line += "(segment (start ";
+        appendIU( line, aTrack->GetStart() );
+        line += ") (end ";
+        appendIU( line, aTrack->GetEnd() );
+        line += ") (width ";
+        appendIU( line, aTrack->GetWidth() );
+        line += ")";
+
+        line += " (layer ";
+        line += m_out->Quotew( aTrack->GetLayerName() );
+        line += ")";
     }
 
-    m_out->Print( 0, " (net %d)", aTrack->GetNet() );
+    line += " (net ";
+    appendInt( line, aTrack->GetNet() );
+    line += ")";
 
     if( aTrack->GetTimeStamp() != 0 )
-        m_out->Print( 0, " (tstamp %lX)", aTrack->GetTimeStamp() );
+    {
+        line += " (tstamp ";
+        appendHex( line, (unsigned long) aTrack->GetTimeStamp() );
+        line += ")";
+    }
 
     if( aTrack->GetStatus() != 0 )
-        m_out->Print( 0, " (status %X)", aTrack->GetStatus() );
+    {
+        line += " (status ";
+        appendHex( line, aTrack->GetStatus() );
+        line += ")";
+    }
 
-    m_out->Print( 0, ")\n" );
+    line += ")\n";
+
+    m_out->Write( line.data(), line.size() );
+}
+
+
+void PCB_IO::formatPolygonPoints( const CPOLYGONS_LIST& aPolygons, const char* aKeyword,
+                                  const char* aNextPts, int aNestLevel ) const
+    throw( IO_ERROR )
+{
+    // Filled zones can have a huge number of corners, they are formatted without printf().
+    std::string& line = m_line;
+    int          newLine = 0;
+
+    line.clear();
+
+    appendIndent( line, aNestLevel );
+    line += "(";
+    line += aKeyword;
+    line += "\n";
+    appendIndent( line, aNestLevel+1 );
+    line += "(pts\n";
+
+    for( unsigned it = 0; it < aPolygons.GetCornersCount(); ++it )
+    {
+        if( newLine == 0 )
+        {
+            appendIndent( line, aNestLevel+2 );
+            line += "(xy ";
+        }
+        else
+        {
+            line += " (xy ";
+        }
+
+        appendIU( line, aPolygons.GetX( it ) );
+        line += " ";
+        appendIU( line, aPolygons.GetY( it ) );
+        line += ")";
+
+        if( newLine < 4 )
+        {
+            newLine += 1;
+        }
+        else
+        {
+            newLine = 0;
+            line += "\n";
+        }
+
+        if( line.size() >= FLUSH_LINE_SIZE )
+        {
+            m_out->Write( line.data(), line.size() );
+            line.clear();
+        }
+
+        if( aPolygons.IsEndContour( it ) )
+        {
+            if( newLine != 0 )
+                line += "\n";
+
+            appendIndent( line, aNestLevel+1 );
+            line += ")\n";
+
+            if( it+1 != aPolygons.GetCornersCount() )
+            {
+                newLine = 0;
+                appendIndent( line, aNestLevel );
+                line += ")\n";
+                appendIndent( line, aNestLevel );
+                line += "(";
+                line += aKeyword;
+                line += "\n";
+                appendIndent( line, aNestLevel+1 );
+                line += aNextPts;
+            }
+        }
+    }
+
+    appendIndent( line, aNestLevel );
+    line += ")\n";
+
+    m_out->Write( line.data(), line.size() );
 }
 
 
@@ -1507,115 +1855,49 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     m_out->Print( 0, ")\n" );
 
     const CPOLYGONS_LIST& cv = aZone->Outline()->m_CornersList;
-    int newLine = 0;
 
+    // The outlines have always been saved without a new line after the "(pts" of their
+    // second and next polygons.
     if( cv.GetCornersCount() )
-    {
-        m_out->Print( aNestLevel+1, "(polygon\n");
-        m_out->Print( aNestLevel+2, "(pts\n" );
-
-        for( unsigned it = 0; it < cv.GetCornersCount(); ++it )
-        {
-            if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FMT_IU( cv.GetX( it ) ).c_str(), FMT_IU( cv.GetY( it ) ).c_str() );
-            else
-                m_out->Print( 0, " (xy %s %s)",
-                              FMT_IU( cv.GetX( it ) ).c_str(), FMT_IU( cv.GetY( it ) ).c_str() );
-
-            if( newLine < 4 )
-            {
-                newLine += 1;
-            }
-            else
-            {
-                newLine = 0;
-                m_out->Print( 0, "\n" );
-            }
-
-            if( cv.IsEndContour( it ) )
-            {
-                if( newLine != 0 )
-                    m_out->Print( 0, "\n" );
-
-                m_out->Print( aNestLevel+2, ")\n" );
-
-                if( it+1 != cv.GetCornersCount() )
-                {
-                    newLine = 0;
-                    m_out->Print( aNestLevel+1, ")\n" );
-                    m_out->Print( aNestLevel+1, "(polygon\n" );
-                    m_out->Print( aNestLevel+2, "(pts" );
-                }
-            }
-        }
-
-        m_out->Print( aNestLevel+1, ")\n" );
-    }
+        formatPolygonPoints( cv, "polygon", "(pts", aNestLevel+1 );
 
     // Save the PolysList
     const CPOLYGONS_LIST& fv = aZone->GetFilledPolysList();
-    newLine = 0;
 
     if( fv.GetCornersCount() )
-    {
-        m_out->Print( aNestLevel+1, "(filled_polygon\n" );
-        m_out->Print( aNestLevel+2, "(pts\n" );
-
-        for( unsigned it = 0; it < fv.GetCornersCount();  ++it )
-        {
-            if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FMT_IU( fv.GetX( it ) ).c_str(), FMT_IU( fv.GetY( it ) ).c_str() );
-            else
-                m_out->Print( 0, " (xy %s %s)",
-                              FMT_IU( fv.GetX( it ) ).c_str(), FMT_IU( fv.GetY( it ) ).c_str() );
-
-            if( newLine < 4 )
-            {
-                newLine += 1;
-            }
-            else
-            {
-                newLine = 0;
-                m_out->Print( 0, "\n" );
-            }
-
-            if( fv.IsEndContour( it ) )
-            {
-                if( newLine != 0 )
-                    m_out->Print( 0, "\n" );
-
-                m_out->Print( aNestLevel+2, ")\n" );
-
-                if( it+1 != fv.GetCornersCount() )
-                {
-                    newLine = 0;
-                    m_out->Print( aNestLevel+1, ")\n" );
-                    m_out->Print( aNestLevel+1, "(filled_polygon\n" );
-                    m_out->Print( aNestLevel+2, "(pts\n" );
-                }
-            }
-        }
-
-        m_out->Print( aNestLevel+1, ")\n" );
-    }
+        formatPolygonPoints( fv, "filled_polygon", "(pts\n", aNestLevel+1 );
 
     // Save the filling segments list
     const std::vector< SEGMENT >& segs = aZone->FillSegments();
 
     if( segs.size() )
     {
-        m_out->Print( aNestLevel+1, "(fill_segments\n" );
+        std::string& line = m_line;
+
+        line.clear();
+        appendIndent( line, aNestLevel+1 );
+        line += "(fill_segments\n";
 
         for( std::vector< SEGMENT >::const_iterator it = segs.begin();  it != segs.end();  ++it )
         {
-            m_out->Print( aNestLevel+2, "(pts (xy %s) (xy %s))\n",
-                          FMT_IU( it->m_Start ).c_str(),
-                          FMT_IU( it->m_End ).c_str() );
+            appendIndent( line, aNestLevel+2 );
+            line += "(pts (xy ";
+            appendIU( line, it->m_Start );
+            line += ") (xy ";
+            appendIU( line, it->m_End );
+            line += "))\n";
+
+            if( line.size() >= FLUSH_LINE_SIZE )
+            {
+                m_out->Write( line.data(), line.size() );
+                line.clear();
+            }
         }
 
-        m_out->Print( aNestLevel+1, ")\n" );
+        appendIndent( line, aNestLevel+1 );
+        line += ")\n";
+
+        m_out->Write( line.data(), line.size() );
     }
 
     m_out->Print( aNestLevel, ")\n" );
@@ -1682,8 +1964,15 @@ void PCB_IO::cacheLib( const wxString& aLibraryPath, const wxString& aFootprintN
     {
         // a spectacular episode in memory management:
         delete m_cache;
+        // Set by FOOTPRINT_LIST, which reads several libraries at once.
+        UTF8        value;
+        unsigned    budget = 0;
+
+        if( m_props && m_props->Value( PROPERTY_THREAD_BUDGET, &value ) )
+            budget = strtoul( value.c_str(), NULL, 10 );
+
         m_cache = new FP_CACHE( this, aLibraryPath );
-        m_cache->Load();
+        m_cache->Load( budget );
     }
 }
 
@@ -32,6 +32,7 @@ class BOARD;
 class BOARD_ITEM;
 class FP_CACHE;
 class PCB_PARSER;
+class CPOLYGONS_LIST;
 
 
 /// Current s-expression file format version.  2 was the last legacy format version.
@@ -172,6 +173,9 @@ protected:
     int                 m_ctl;
     PCB_PARSER*         m_parser;
 
+    /// Reusable buffer of the nodes formatted without printf()
+    mutable std::string m_line;
+
     /// we only cache one footprint library, this determines which one.
     void cacheLib( const wxString& aLibraryPath, const wxString& aFootprintName = wxEmptyString );
 
@@ -211,6 +215,19 @@ private:
     void format( ZONE_CONTAINER* aZone, int aNestLevel = 0 ) const
         throw( IO_ERROR );
 
+    /**
+     * Function formatPolygonPoints
+     * outputs the corners of a zone outline or filling, one node per polygon.
+     *
+     * @param aPolygons are the polygons to output.
+     * @param aKeyword is the name of the nodes, such as "polygon".
+     * @param aNextPts is the text starting the list of points after the first polygon.
+     * @param aNestLevel is the indentation of the nodes.
+     */
+    void formatPolygonPoints( const CPOLYGONS_LIST& aPolygons, const char* aKeyword,
+                              const char* aNextPts, int aNestLevel ) const
+        throw( IO_ERROR );
+
     void formatLayer( const BOARD_ITEM* aItem ) const;
 
     void formatLayers( LAYER_MSK aLayerMask, int aNestLevel = 0 ) const
@@ -0,0 +1,149 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file module_index.cpp
+ * @brief Index of the footprints of a board by reference and by path.
+ */
+
+#include <fctsys.h>
+#include <algorithm>
+
+#include <class_board.h>
+#include <class_module.h>
+
+#include <module_index.h>
+
+
+MODULE_INDEX::MODULE_INDEX( const BOARD* aBoard ) :
+    m_nextRank( 0 )
+{
+    for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
+        insert( module, m_nextRank++ );
+}
+
+
+MODULE* MODULE_INDEX::FindModuleByReference( const wxString& aReference ) const
+{
+    return find( m_byReference, aReference );
+}
+
+
+MODULE* MODULE_INDEX::FindModule( const wxString& aRefOrTimeStamp,
+                                  bool aSearchByTimeStamp ) const
+{
+    if( aSearchByTimeStamp )
+        return find( m_byPath, aRefOrTimeStamp.Lower() );
+
+    return find( m_byReference, aRefOrTimeStamp );
+}
+
+
+void MODULE_INDEX::Append( MODULE* aModule )
+{
+    insert( aModule, m_nextRank++ );
+}
+
+
+void MODULE_INDEX::Remove( MODULE* aModule )
+{
+    ENTRIES::iterator it = m_entries.find( aModule );
+
+    if( it == m_entries.end() )
+        return;
+
+    removeKey( m_byReference, it->second.reference, aModule );
+    removeKey( m_byPath, it->second.path, aModule );
+    m_entries.erase( it );
+}
+
+
+void MODULE_INDEX::Update( MODULE* aModule )
+{
+    ENTRIES::iterator it = m_entries.find( aModule );
+
+    if( it == m_entries.end() )
+        return;
+
+    unsigned rank = it->second.rank;
+
+    Remove( aModule );
+    insert( aModule, rank );
+}
+
+
+void MODULE_INDEX::insert( MODULE* aModule, unsigned aRank )
+{
+    ENTRY& entry = m_entries[aModule];
+
+    entry.rank      = aRank;
+    entry.reference = aModule->GetReference();
+    entry.path      = aModule->GetPath().Lower();
+
+    addKey( m_byReference, entry.reference, aRank, aModule );
+    addKey( m_byPath, entry.path, aRank, aModule );
+}
+
+
+void MODULE_INDEX::addKey( KEY_MAP& aMap, const wxString& aKey, unsigned aRank,
+                           MODULE* aModule )
+{
+    RANKED_MODULES&                 modules = aMap[aKey];
+    std::pair<unsigned, MODULE*>    item( aRank, aModule );
+
+    modules.insert( std::lower_bound( modules.begin(), modules.end(), item ), item );
+}
+
+
+void MODULE_INDEX::removeKey( KEY_MAP& aMap, const wxString& aKey, MODULE* aModule )
+{
+    KEY_MAP::iterator it = aMap.find( aKey );
+
+    if( it == aMap.end() )
+        return;
+
+    RANKED_MODULES& modules = it->second;
+
+    for( RANKED_MODULES::iterator m = modules.begin();  m != modules.end();  ++m )
+    {
+        if( m->second == aModule )
+        {
+            modules.erase( m );
+            break;
+        }
+    }
+
+    if( modules.empty() )
+        aMap.erase( it );
+}
+
+
+MODULE* MODULE_INDEX::find( const KEY_MAP& aMap, const wxString& aKey )
+{
+    KEY_MAP::const_iterator it = aMap.find( aKey );
+
+    if( it == aMap.end() )
+        return NULL;
+
+    return it->second.front().second;
+}
@@ -0,0 +1,119 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file module_index.h
+ * @brief Index of the footprints of a board by reference and by path.
+ */
+
+#ifndef MODULE_INDEX_H_
+#define MODULE_INDEX_H_
+
+#include <vector>
+#include <boost/unordered/unordered_map.hpp>
+
+#include <wx/string.h>
+#include <wx/hashmap.h>
+
+class BOARD;
+class MODULE;
+
+/**
+ * Class MODULE_INDEX
+ * finds the footprints of a board by reference or by path (time stamp) in constant time,
+ * with the same result as BOARD::FindModule(): the first matching footprint in the module
+ * list of the board.
+ *
+ * The index is a snapshot of the board: it is meant to be built for a batch of lookups,
+ * such as a netlist import, and whoever changes the board in the meantime has to tell the
+ * index about it.
+ */
+class MODULE_INDEX
+{
+public:
+    /**
+     * Constructor
+     * indexes the footprints of \a aBoard.
+     */
+    MODULE_INDEX( const BOARD* aBoard );
+
+    /**
+     * Function FindModuleByReference
+     * does the same as BOARD::FindModuleByReference().
+     */
+    MODULE* FindModuleByReference( const wxString& aReference ) const;
+
+    /**
+     * Function FindModule
+     * does the same as BOARD::FindModule().
+     */
+    MODULE* FindModule( const wxString& aRefOrTimeStamp, bool aSearchByTimeStamp = false ) const;
+
+    /**
+     * Function Append
+     * adds a footprint which has just been appended to the module list of the board.
+     */
+    void Append( MODULE* aModule );
+
+    /**
+     * Function Remove
+     * removes a footprint which is about to be removed from the board.
+     */
+    void Remove( MODULE* aModule );
+
+    /**
+     * Function Update
+     * indexes again a footprint whose reference or path has been changed.
+     */
+    void Update( MODULE* aModule );
+
+private:
+    /// Footprints having the same key, ordered by rank in the module list
+    typedef std::vector< std::pair<unsigned, MODULE*> >     RANKED_MODULES;
+
+    typedef boost::unordered_map< wxString, RANKED_MODULES,
+                                  wxStringHash, wxStringEqual > KEY_MAP;
+
+    ///> Rank and keys of an indexed footprint
+    struct ENTRY
+    {
+        unsigned    rank;
+        wxString    reference;
+        wxString    path;           ///< Lower case, paths are compared ignoring case
+    };
+
+    typedef boost::unordered_map< MODULE*, ENTRY >          ENTRIES;
+
+    void insert( MODULE* aModule, unsigned aRank );
+
+    static void addKey( KEY_MAP& aMap, const wxString& aKey, unsigned aRank, MODULE* aModule );
+    static void removeKey( KEY_MAP& aMap, const wxString& aKey, MODULE* aModule );
+    static MODULE* find( const KEY_MAP& aMap, const wxString& aKey );
+
+    KEY_MAP     m_byReference;
+    KEY_MAP     m_byPath;
+    ENTRIES     m_entries;
+    unsigned    m_nextRank;         ///< Rank of the next footprint appended
+};
+
+#endif  // MODULE_INDEX_H_
@@ -44,6 +44,12 @@
 #include <class_module.h>
 #include <pcbnew.h>
 #include <io_mgr.h>
+#include <module_index.h>
+#include <parallel_for.h>
+
+#include <map>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/bind.hpp>
 
 
 void PCB_EDIT_FRAME::ReadPcbNetlist( const wxString& aNetlistFileName,
@@ -163,6 +169,94 @@ MODULE* PCB_EDIT_FRAME::ListAndSelectModuleName()
 
 #define ALLOW_PARTIAL_FPID      1
 
+
+/**
+ * Struct LIBRARY_FOOTPRINT
+ * is a footprint needed by a netlist, loaded from its library by a worker thread of
+ * PCB_EDIT_FRAME::loadFootprints().
+ */
+struct LIBRARY_FOOTPRINT
+{
+    FPID        m_FPID;
+    MODULE*     m_Module;       ///< NULL if the footprint was not found or could not be read
+    IO_ERROR*   m_Error;        ///< Why the footprint could not be read, can be a PARSE_ERROR
+
+    LIBRARY_FOOTPRINT( const FPID& aFPID ) :
+        m_FPID( aFPID ),
+        m_Module( NULL ),
+        m_Error( NULL )
+    {
+    }
+
+    ~LIBRARY_FOOTPRINT()
+    {
+        delete m_Module;
+        delete m_Error;
+    }
+
+    /**
+     * Function NewModule
+     * @return MODULE* - a copy of the footprint, or NULL if it was not found.
+     * @throw IO_ERROR or PARSE_ERROR, what loading the footprint threw.
+     */
+    MODULE* NewModule() const throw( IO_ERROR, PARSE_ERROR )
+    {
+        if( m_Error )
+        {
+            if( PARSE_ERROR* pe = dynamic_cast<PARSE_ERROR*>( m_Error ) )
+                throw PARSE_ERROR( *pe );
+
+            throw IO_ERROR( *m_Error );
+        }
+
+        return m_Module ? new MODULE( *m_Module ) : NULL;
+    }
+};
+
+
+/// The footprints to load from one library: the cache of a library is not thread safe.
+typedef std::vector< LIBRARY_FOOTPRINT* >  LIBRARY_LOAD_JOB;
+
+
+static void loadLibraryFootprints( FP_LIB_TABLE* aTable, std::vector<LIBRARY_LOAD_JOB>* aJobs,
+                                   unsigned aJob )
+{
+    LIBRARY_LOAD_JOB& job = (*aJobs)[aJob];
+
+    for( unsigned jj = 0; jj < job.size(); jj++ )
+    {
+        LIBRARY_FOOTPRINT* footprint = job[jj];
+
+        try
+        {
+            footprint->m_Module = aTable->FootprintLoad( footprint->m_FPID.GetLibNickname(),
+                                                         footprint->m_FPID.GetFootprintName() );
+        }
+        catch( const PARSE_ERROR& pe )
+        {
+            footprint->m_Error = new PARSE_ERROR( pe );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            footprint->m_Error = new IO_ERROR( ioe );
+        }
+        // Nothing can be thrown out of a worker thread, map anything unexpected into
+        // the expected.
+        catch( const std::exception& se )
+        {
+            try
+            {
+                THROW_IO_ERROR( se.what() );
+            }
+            catch( const IO_ERROR& ioe )
+            {
+                footprint->m_Error = new IO_ERROR( ioe );
+            }
+        }
+    }
+}
+
+
 void PCB_EDIT_FRAME::loadFootprints( NETLIST& aNetlist, REPORTER* aReporter )
     throw( IO_ERROR, PARSE_ERROR )
 {
@@ -177,6 +271,73 @@ void PCB_EDIT_FRAME::loadFootprints( NETLIST& aNetlist, REPORTER* aReporter )
 
     aNetlist.SortByFPID();
 
+    // Looking up each component with FindModule() would walk the module list every time.
+    MODULE_INDEX                                boardModules( m_Pcb );
+    std::vector<MODULE*>                        onBoard( aNetlist.GetCount(), (MODULE*) NULL );
+
+    boost::ptr_vector<LIBRARY_FOOTPRINT>        libFootprints;
+    std::map<std::string, LIBRARY_FOOTPRINT*>   libFootprintsByFPID;
+    std::vector<LIBRARY_LOAD_JOB>               jobs;
+    std::map<std::string, unsigned>             jobsByNickname;
+
+    // Find the footprints already on board, and gather the library footprints needed, so they
+    // are all loaded at once, one thread per library.
+    for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
+    {
+        component = aNetlist.GetComponent( ii );
+
+        const FPID& fpid = component->GetFPID();
+
+        if( !fpid.GetFootprintName().size() )
+            continue;
+
+        if( aNetlist.IsFindByTimeStamp() )
+            onBoard[ii] = boardModules.FindModule( component->GetTimeStamp(), true );
+        else
+            onBoard[ii] = boardModules.FindModule( component->GetReference() );
+
+        bool footprintMisMatch = onBoard[ii] && onBoard[ii]->GetFPID() != fpid;
+
+        if( onBoard[ii] && !( footprintMisMatch && aNetlist.GetReplaceFootprints() ) )
+            continue;
+
+        // A footprint without nickname is searched in all libraries, which cannot be done
+        // while other threads use them.  It is loaded later, if needed.
+        if( !fpid.GetLibNickname().size() )
+            continue;
+
+        std::string key = fpid.Format();
+
+        if( libFootprintsByFPID.count( key ) )
+            continue;
+
+        LIBRARY_FOOTPRINT* footprint = new LIBRARY_FOOTPRINT( fpid );
+
+        libFootprints.push_back( footprint );
+        libFootprintsByFPID[key] = footprint;
+
+        const std::string&                          nickname = fpid.GetLibNickname();
+        std::map<std::string, unsigned>::iterator   job = jobsByNickname.find( nickname );
+
+        if( job == jobsByNickname.end() )
+        {
+            job = jobsByNickname.insert( std::make_pair( nickname, (unsigned) jobs.size() ) ).first;
+            jobs.push_back( LIBRARY_LOAD_JOB() );
+        }
+
+        jobs[job->second].push_back( footprint );
+    }
+
+    if( !jobs.empty() )
+    {
+        // Keep LOCALE_IO::C_count at 1 or greater for the duration of all helper threads,
+        // see FOOTPRINT_LIST::ReadFootprintFiles().
+        LOCALE_IO   top_most_nesting;
+
+        ParallelFor( jobs.size(), boost::bind( loadLibraryFootprints, m_footprintLibTable,
+                                               &jobs, _1 ) );
+    }
+
     for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
     {
         component = aNetlist.GetComponent( ii );
@@ -201,10 +362,7 @@ void PCB_EDIT_FRAME::loadFootprints( NETLIST& aNetlist, REPORTER* aReporter )
 
         // Check if component footprint is already on BOARD and only load the footprint from
         // the library if it's needed.  Nickname can be blank.
-        if( aNetlist.IsFindByTimeStamp() )
-            fpOnBoard = m_Pcb->FindModule( aNetlist.GetComponent( ii )->GetTimeStamp(), true );
-        else
-            fpOnBoard = m_Pcb->FindModule( aNetlist.GetComponent( ii )->GetReference() );
+        fpOnBoard = onBoard[ii];
 
         bool footprintMisMatch = fpOnBoard &&
                                  fpOnBoard->GetFPID() != component->GetFPID();
@@ -252,8 +410,13 @@ void PCB_EDIT_FRAME::loadFootprints( NETLIST& aNetlist, REPORTER* aReporter )
                 continue;
             }
 
-            // loadFootprint() can find a footprint with an empty nickname in fpid.
-            module = PCB_BASE_FRAME::loadFootprint( component->GetFPID() );
+            std::map<std::string, LIBRARY_FOOTPRINT*>::const_iterator it =
+                    libFootprintsByFPID.find( component->GetFPID().Format() );
+
+            if( it != libFootprintsByFPID.end() )
+                module = it->second->NewModule();
+            else    // loadFootprint() can find a footprint with an empty nickname in fpid.
+                module = PCB_BASE_FRAME::loadFootprint( component->GetFPID() );
 
             if( module )
             {
@@ -280,7 +443,8 @@ void PCB_EDIT_FRAME::loadFootprints( NETLIST& aNetlist, REPORTER* aReporter )
             if( module == NULL )
                 continue;            // Module does not exist in any library.
 
-            module = new MODULE( *module );
+            if( loadFootprint )
+                module = new MODULE( *module );
         }
 
         if( loadFootprint && module != NULL )
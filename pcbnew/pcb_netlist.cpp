@@ -34,6 +34,8 @@
 #include <pcb_netlist.h>
 #include <class_module.h>
 
+#include <algorithm>
+
 
 #if defined(DEBUG)
 /**
@@ -78,14 +80,60 @@ void COMPONENT::SetModule( MODULE* aModule )
 COMPONENT_NET COMPONENT::m_emptyNet;
 
 
+/// Orders net indices by pin name, then by index, so the first net of a pin comes first
+struct PIN_NAME_ORDER
+{
+    const COMPONENT_NETS& m_nets;
+
+    PIN_NAME_ORDER( const COMPONENT_NETS& aNets ) : m_nets( aNets ) {}
+
+    bool operator()( unsigned aFirst, unsigned aSecond ) const
+    {
+        int diff = m_nets[aFirst].GetPinName().Cmp( m_nets[aSecond].GetPinName() );
+
+        return diff < 0 || ( diff == 0 && aFirst < aSecond );
+    }
+
+    bool operator()( unsigned aIndex, const wxString& aPinName ) const
+    {
+        return m_nets[aIndex].GetPinName().Cmp( aPinName ) < 0;
+    }
+};
+
+
 const COMPONENT_NET& COMPONENT::GetNet( const wxString& aPinName )
 {
-    for( unsigned i = 0;  i < m_nets.size();  i++ )
+    // Not worth an index
+    if( m_nets.size() <= 8 )
     {
-        if( m_nets[i].GetPinName() == aPinName )
-            return m_nets[i];
+        for( unsigned i = 0;  i < m_nets.size();  i++ )
+        {
+            if( m_nets[i].GetPinName() == aPinName )
+                return m_nets[i];
+        }
+
+        return m_emptyNet;
+    }
+
+    PIN_NAME_ORDER order( m_nets );
+
+    if( m_pinIndex.size() != m_nets.size() )
+    {
+        m_pinIndex.resize( m_nets.size() );
+
+        for( unsigned i = 0;  i < m_nets.size();  i++ )
+            m_pinIndex[i] = i;
+
+        std::sort( m_pinIndex.begin(), m_pinIndex.end(), order );
     }
 
+    std::vector< unsigned >::const_iterator it = std::lower_bound( m_pinIndex.begin(),
+                                                                   m_pinIndex.end(),
+                                                                   aPinName, order );
+
+    if( it != m_pinIndex.end() && m_nets[*it].GetPinName() == aPinName )
+        return m_nets[*it];
+
     return m_emptyNet;
 }
 
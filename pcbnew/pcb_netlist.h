@@ -93,6 +93,9 @@ typedef std::vector< COMPONENT_NET > COMPONENT_NETS;
 class COMPONENT
 {
     COMPONENT_NETS m_nets;
+
+    /// Indices of #m_nets sorted by pin name, built by GetNet() on components with many pins.
+    std::vector< unsigned > m_pinIndex;
     wxArrayString  m_footprintFilters; ///< Footprint filters found in netlist.
     wxString       m_reference;        ///< The component reference designator found in netlist.
     wxString       m_value;            ///< The component value found in netlist.
@@ -135,6 +138,7 @@ public:
     void AddNet( const wxString& aPinName, const wxString& aNetName )
     {
         m_nets.push_back( COMPONENT_NET( aPinName, aNetName ) );
+        m_pinIndex.clear();
     }
 
     unsigned GetNetCount() const { return m_nets.size(); }
@@ -143,7 +147,11 @@ public:
 
     const COMPONENT_NET& GetNet( const wxString& aPinName );
 
-    void SortPins() { sort( m_nets.begin(), m_nets.end() ); }
+    void SortPins()
+    {
+        sort( m_nets.begin(), m_nets.end() );
+        m_pinIndex.clear();
+    }
 
     void SetName( const wxString& aName ) { m_name = aName;}
     const wxString& GetName() const { return m_name; }
@@ -555,24 +555,26 @@ void PCB_EDIT_FRAME::ViewReloadBoard( const BOARD* aBoard ) const
     view->Clear();
 
     // All of PCB drawing elements should be added to the VIEW
-    // in order to be displayed
+    // in order to be displayed. They are collected first, so the VIEW
+    // can build its spatial index in a single pass.
+    std::vector<KIGFX::VIEW_ITEM*> items;
 
     // Load zones
     for( int i = 0; i < aBoard->GetAreaCount(); ++i )
     {
-        view->Add( (KIGFX::VIEW_ITEM*) ( aBoard->GetArea( i ) ) );
+        items.push_back( (KIGFX::VIEW_ITEM*) ( aBoard->GetArea( i ) ) );
     }
 
     // Load drawings
     for( BOARD_ITEM* drawing = aBoard->m_Drawings; drawing; drawing = drawing->Next() )
     {
-        view->Add( drawing );
+        items.push_back( drawing );
     }
 
     // Load tracks
     for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
     {
-        view->Add( track );
+        items.push_back( track );
     }
 
     // Load modules and its additional elements
@@ -581,30 +583,32 @@ void PCB_EDIT_FRAME::ViewReloadBoard( const BOARD* aBoard ) const
         // Load module's pads
         for( D_PAD* pad = module->Pads().GetFirst(); pad; pad = pad->Next() )
         {
-            view->Add( pad );
+            items.push_back( pad );
         }
 
         // Load module's drawing (mostly silkscreen)
         for( BOARD_ITEM* drawing = module->GraphicalItems().GetFirst(); drawing;
              drawing = drawing->Next() )
         {
-            view->Add( drawing );
+            items.push_back( drawing );
         }
 
         // Load module's texts (name and value)
-        view->Add( &module->Reference() );
-        view->Add( &module->Value() );
+        items.push_back( &module->Reference() );
+        items.push_back( &module->Value() );
 
         // Add the module itself
-        view->Add( module );
+        items.push_back( module );
     }
 
     // Segzones (equivalent of ZONE_CONTAINER for legacy boards)
     for( SEGZONE* zone = aBoard->m_Zone; zone; zone = zone->Next() )
     {
-        view->Add( zone );
+        items.push_back( zone );
     }
 
+    view->Add( items );
+
     // Add an entry for the worksheet layout
     KIGFX::WORKSHEET_VIEWITEM* worksheet = new KIGFX::WORKSHEET_VIEWITEM(
                                             std::string( aBoard->GetFileName().mb_str() ),
@@ -577,17 +577,10 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
     // 1 - merge areas which are intersecting, i.e. remove gaps
     //     having a thickness < aMinThickness
     // 2 - deflate resulting areas by aMinThickness/2
-    KI_POLYGON_SET areasToMerge;
-    bufferPolys.ExportTo( areasToMerge );
-    KI_POLYGON_SET initialAreas;
-    initialPolys.ExportTo( initialAreas );
-
     // Merge polygons: because each shape was created with an extra margin
     // = aMinThickness/2, shapes too close ( dist < aMinThickness )
-    // will be merged, because they are overlapping
-    KI_POLYGON_SET areas;
-    areas |= areasToMerge;
-
+    // will be merged by Inflate(), because they are overlapping
+    //
     // Deflate: remove the extra margin, to create the actual shapes
     // Here I am using polygon:resize, because this function creates better shapes
     // than deflate algo.
@@ -595,10 +588,10 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
     // In boost polygon (at least v 1.54 and previous) in very rare cases resize crashes
     // with 16 segments (perhaps related to 45 degrees pads). So using 18 segments
     // is a workaround to try to avoid these crashes
-    areas = resize( areas, -inflate , true, 18 );
+    bufferPolys.Inflate( -inflate, true, 18 );
 
     // Resize slightly changes shapes. So *ensure* initial shapes are kept
-    areas |= initialAreas;
+    bufferPolys.BooleanAdd( initialPolys );
 
     // To avoid a lot of code, use a ZONE_CONTAINER
     // to plot polygons, because they are exactly like
@@ -608,7 +601,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
     zone.SetMinThickness( 0 );      // trace polygons only
     zone.SetLayer ( layer );
 
-    zone.CopyPolygonsFromKiPolygonListToFilledPolysList( areas );
+    zone.AddFilledPolysList( bufferPolys );
     itemplotter.PlotFilledAreas( &zone );
 }
 
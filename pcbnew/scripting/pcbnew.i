@@ -41,6 +41,7 @@
 
 %ignore BOARD_ITEM::ZeroOffset;
 %ignore D_PAD::m_PadSketchModePenSize;
+%ignore ZONE_UNDO_IMAGE;                // ZONE_CONTAINER is not wrapped
 
 // rename the Add method of classes to Add native, so we will handle
 // the Add method in python
@@ -93,6 +94,7 @@
   #include <class_marker_pcb.h>
   #include <class_text_mod.h>
   #include <class_edge_mod.h>
+  #include <board_undo_images.h>
   #include <dlist.h>
   #include <class_zone_settings.h>
   #include <class_netclass.h>
@@ -128,6 +130,7 @@
 %include <class_marker_pcb.h>
 %include <class_text_mod.h>
 %include <class_edge_mod.h>
+%include <board_undo_images.h>
 %include <dlist.h>
 %include <class_zone_settings.h>
 %include <class_netclass.h>
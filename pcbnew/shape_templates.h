@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2014 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file shape_templates.h
+ * @brief Pad and via polygons shared by the items having the same shape during a zone fill.
+ */
+
+#ifndef SHAPE_TEMPLATES_H_
+#define SHAPE_TEMPLATES_H_
+
+#include <map>
+
+#include <PolyLine.h>
+
+
+///> Functions building shape templates
+enum SHAPE_TEMPLATE_KIND
+{
+    PAD_CLEARANCE_SHAPE,
+    VIA_CLEARANCE_SHAPE,
+    PAD_THERMAL_RELIEF_SHAPE
+};
+
+
+/**
+ * Struct SHAPE_TEMPLATE_KEY
+ * holds all the parameters a shape template depends on.
+ */
+struct SHAPE_TEMPLATE_KEY
+{
+    int     m_Kind;             ///< SHAPE_TEMPLATE_KIND
+    int     m_Shape;            ///< Pad shape
+    wxSize  m_Size;             ///< Pad size, or via diameter
+    wxSize  m_Delta;            ///< Trapezoidal pad deltas
+    double  m_Orient;
+    int     m_Clearance;        ///< Clearance, or thermal gap
+    int     m_CopperThickness;  ///< Thermal stubs thickness
+    int     m_MinThickness;     ///< Zone min thickness, for thermal reliefs
+    int     m_SegmentsCount;    ///< Segments count of circles
+    double  m_Correction;
+    double  m_ThermalRot;
+
+    SHAPE_TEMPLATE_KEY( SHAPE_TEMPLATE_KIND aKind, int aShape, const wxSize& aSize,
+                        double aOrient, int aClearance, int aSegmentsCount,
+                        double aCorrection ) :
+        m_Kind( aKind ), m_Shape( aShape ), m_Size( aSize ), m_Delta( 0, 0 ),
+        m_Orient( aOrient ), m_Clearance( aClearance ), m_CopperThickness( 0 ),
+        m_MinThickness( 0 ), m_SegmentsCount( aSegmentsCount ), m_Correction( aCorrection ),
+        m_ThermalRot( 0 )
+    {
+    }
+
+    bool operator<( const SHAPE_TEMPLATE_KEY& aOther ) const
+    {
+        if( m_Kind != aOther.m_Kind )
+            return m_Kind < aOther.m_Kind;
+
+        if( m_Shape != aOther.m_Shape )
+            return m_Shape < aOther.m_Shape;
+
+        if( m_Size.x != aOther.m_Size.x )
+            return m_Size.x < aOther.m_Size.x;
+
+        if( m_Size.y != aOther.m_Size.y )
+            return m_Size.y < aOther.m_Size.y;
+
+        if( m_Delta.x != aOther.m_Delta.x )
+            return m_Delta.x < aOther.m_Delta.x;
+
+        if( m_Delta.y != aOther.m_Delta.y )
+            return m_Delta.y < aOther.m_Delta.y;
+
+        if( m_Orient != aOther.m_Orient )
+            return m_Orient < aOther.m_Orient;
+
+        if( m_Clearance != aOther.m_Clearance )
+            return m_Clearance < aOther.m_Clearance;
+
+        if( m_CopperThickness != aOther.m_CopperThickness )
+            return m_CopperThickness < aOther.m_CopperThickness;
+
+        if( m_MinThickness != aOther.m_MinThickness )
+            return m_MinThickness < aOther.m_MinThickness;
+
+        if( m_SegmentsCount != aOther.m_SegmentsCount )
+            return m_SegmentsCount < aOther.m_SegmentsCount;
+
+        if( m_Correction != aOther.m_Correction )
+            return m_Correction < aOther.m_Correction;
+
+        return m_ThermalRot < aOther.m_ThermalRot;
+    }
+};
+
+
+/**
+ * Class SHAPE_TEMPLATES
+ * holds the polygons of pad and via shapes placed at (0,0).  Many pads and vias of a board
+ * have the same shape, size and orientation, and a zone fill converts them all with the
+ * same clearance: their polygons are built once and translated to the position of each item.
+ * An instance belongs to one zone fill, which gives it to the shape conversion functions.
+ */
+class SHAPE_TEMPLATES
+{
+public:
+    /**
+     * Function GetTemplate
+     * returns the template for \a aKey.  It is empty and \a aIsNew is set to true if it
+     * has to be built by the caller.
+     */
+    CPOLYGONS_LIST& GetTemplate( const SHAPE_TEMPLATE_KEY& aKey, bool& aIsNew )
+    {
+        std::pair<TEMPLATES::iterator, bool> inserted =
+            m_templates.insert( std::make_pair( aKey, CPOLYGONS_LIST() ) );
+
+        aIsNew = inserted.second;
+
+        return inserted.first->second;
+    }
+
+private:
+    typedef std::map<SHAPE_TEMPLATE_KEY, CPOLYGONS_LIST> TEMPLATES;
+
+    TEMPLATES   m_templates;
+};
+
+#endif  // SHAPE_TEMPLATES_H_
@@ -31,6 +31,7 @@
 
 //  see http://www.boost.org/libs/ptr_container/doc/ptr_set.html
 #include <boost/ptr_container/ptr_set.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <fctsys.h>
 #include <specctra_lexer.h>
@@ -3168,6 +3169,21 @@ public:
     }
 
     void Format( OUTPUTFORMATTER* out, int nestLevel ) throw( IO_ERROR )
+    {
+        FormatHeader( out, nestLevel );
+
+        if( wiring )
+            wiring->Format( out, nestLevel+1 );
+
+        out->Print( nestLevel, ")\n" );
+    }
+
+    /**
+     * Function FormatHeader
+     * formats the opening of this PCB and all its sections but the wiring, which the
+     * caller has to output before closing the PCB.
+     */
+    void FormatHeader( OUTPUTFORMATTER* out, int nestLevel ) throw( IO_ERROR )
     {
         const char* quote = out->GetQuoteChar( pcbname.c_str() );
 
@@ -3194,11 +3210,6 @@ public:
 
         if( network )
             network->Format( out, nestLevel+1 );
-
-        if( wiring )
-            wiring->Format( out, nestLevel+1 );
-
-        out->Print( nestLevel, ")\n" );
     }
 
     UNIT_RES*  GetUnits() const
@@ -3593,6 +3604,47 @@ public:
 typedef boost::ptr_set<PADSTACK>    PADSTACKSET;
 
 
+/**
+ * Struct PAD_KEY
+ * holds the properties of a D_PAD which the PADSTACK made by
+ * SPECCTRA_DB::makePADSTACK() depends on.
+ */
+struct PAD_KEY
+{
+    int         shape;
+    wxSize      size;
+    wxSize      delta;
+    wxPoint     offset;
+    LAYER_MSK   layers;         ///< copper layers only
+
+    bool operator==( const PAD_KEY& aOther ) const
+    {
+        return shape == aOther.shape && size == aOther.size && delta == aOther.delta
+               && offset == aOther.offset && layers == aOther.layers;
+    }
+};
+
+
+inline std::size_t hash_value( const PAD_KEY& aKey )
+{
+    std::size_t seed = 0;
+
+    boost::hash_combine( seed, aKey.shape );
+    boost::hash_combine( seed, aKey.size.x );
+    boost::hash_combine( seed, aKey.size.y );
+    boost::hash_combine( seed, aKey.delta.x );
+    boost::hash_combine( seed, aKey.delta.y );
+    boost::hash_combine( seed, aKey.offset.x );
+    boost::hash_combine( seed, aKey.offset.y );
+    boost::hash_combine( seed, aKey.layers );
+
+    return seed;
+}
+
+/// padstacks of padstackset by the properties of the pads they have been made from
+typedef boost::unordered_map<PAD_KEY, PADSTACK*>   PADSTACK_INDEX;
+
+
 /**
  * Class SPECCTRA_DB
  * holds a DSN data tree, usually coming from a DSN file. Is essentially a
@@ -3630,6 +3682,7 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
     static const KICAD_T scanPADs[];
 
     PADSTACKSET     padstackset;
+    PADSTACK_INDEX  padstackIndex;
 
     /// we don't want ownership here permanently, so we don't use boost::ptr_vector
     std::vector<NET*>   nets;
@@ -3797,6 +3850,29 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
      */
     PADSTACK* makeVia( const SEGVIA* aVia );
 
+    /**
+     * Function registerVia
+     * adds the PADSTACK of \a aVia to the library, if there is not already a via like it.
+     * @return PADSTACK* - The padstack registered in the library.
+     */
+    PADSTACK* registerVia( const SEGVIA* aVia );
+
+    /**
+     * Function exportWIREs
+     * exports the tracks of \a aBoard having a net as WIREs, chaining the connected
+     * segments having the same width and layer. If \a aOut is NULL the WIREs are added
+     * to pcb->wiring, otherwise each WIRE is formatted to \a aOut as soon as it is
+     * complete and is not kept.
+     */
+    void exportWIREs( BOARD* aBoard, OUTPUTFORMATTER* aOut, int aNestLevel ) throw( IO_ERROR );
+
+    /**
+     * Function exportWIRE_VIAs
+     * exports the vias of \a aBoard having a net as WIRE_VIAs, like exportWIREs() does.
+     */
+    void exportWIRE_VIAs( BOARD* aBoard, OUTPUTFORMATTER* aOut, int aNestLevel )
+        throw( IO_ERROR );
+
     /**
      * Function deleteNETs
      * deletes all the NETs that may be in here.
@@ -3933,8 +4009,23 @@ public:
      * for how this can be done before calling this function.
      *
      * @param aBoard The BOARD to convert to a PCB.
+     * @param aWithWiring If false, the tracks and vias of the BOARD are not added to the
+     *  wiring of the PCB, but their via padstacks are still added to the library.
+     */
+    void FromBOARD( BOARD* aBoard, bool aWithWiring = true ) throw( IO_ERROR );
+
+    /**
+     * Function ExportBOARD
+     * writes \a aBoard as a SPECTRA DSN format file, like FromBOARD() followed by
+     * ExportPCB() do, but the wiring is formatted directly from the tracks and vias
+     * of the BOARD instead of being built in memory first.  The BOARD has to be
+     * prepared as for FromBOARD().
+     *
+     * @param aBoard The BOARD to export.
+     * @param aFilename The file to save to, it is also the name of the PCB.
+     * @throw IO_ERROR, if the BOARD cannot be exported or an i/o error occurs.
      */
-    void FromBOARD( BOARD* aBoard ) throw( IO_ERROR );
+    void ExportBOARD( BOARD* aBoard, const wxString& aFilename ) throw( IO_ERROR );
 
     /**
      * Function FromSESSION
@@ -40,6 +40,10 @@
 
 #include <set>                  // std::set
 #include <map>                  // std::map
+#include <vector>
+#include <memory>               // std::auto_ptr
+
+#include <boost/unordered_map.hpp>
 
 #include <boost/utility.hpp>    // boost::addressof()
 
@@ -151,10 +155,9 @@ void PCB_EDIT_FRAME::ExportToSpecctra( wxCommandEvent& event )
     try
     {
         GetBoard()->SynchronizeNetsAndNetClasses();
-        db.FromBOARD( GetBoard() );
-        db.ExportPCB(  fullFileName, true );
+        db.ExportBOARD( GetBoard(), fullFileName );
 
-        // if an exception is thrown by FromBOARD or ExportPCB(), then
+        // if an exception is thrown by ExportBOARD(), then
         // ~SPECCTRA_DB() will close the file.
     }
     catch( IO_ERROR& ioe )
@@ -243,101 +246,194 @@ static POINT mapPt( const wxPoint& pt )
 
 
 /**
- * Function findPoint
- * searches for a DRAWSEGMENT with an end point or start point of aPoint, and
- * if found, removes it from the TYPE_COLLECTOR and returns it, else returns NULL.
- * @param aPoint The starting or ending point to search for.
- * @param items The list to remove from.
- * @param aLimit is the distance from \a aPoint that still constitutes a valid find.
- * @return DRAWSEGMENT* - The first DRAWSEGMENT that has a start or end point matching
- *   aPoint, otherwise NULL if none.
+ * Class OUTLINE_INDEX
+ * holds the Edge.Cuts graphics which are not chained into an outline yet, with their end
+ * points hashed by grid cells, so the graphic following a point of an outline is found
+ * without searching all the remaining graphics.
  */
-static DRAWSEGMENT* findPoint( const wxPoint& aPoint, TYPE_COLLECTOR* items, unsigned aLimit )
+class OUTLINE_INDEX
 {
-    unsigned min_d = INT_MAX;
-    int      ndx_min = 0;
+public:
+    /**
+     * Constructor
+     * @param aGraphics are the graphics to chain, in board order.
+     * @param aCellSize is the size of the grid cells, it should be near the biggest
+     *  distance used in FindPoint().
+     */
+    OUTLINE_INDEX( const std::vector<DRAWSEGMENT*>& aGraphics, int aCellSize ) :
+        m_graphics( aGraphics ),
+        m_removed( aGraphics.size(), false ),
+        m_cellSize( std::max( aCellSize, 1 ) ),
+        m_count( aGraphics.size() ),
+        m_first( 0 )
+    {
+        for( unsigned i = 0; i < m_graphics.size(); ++i )
+        {
+            wxPoint start;
+            wxPoint end;
+
+            endPoints( m_graphics[i], start, end );
+
+            CELL startCell = cellOf( start );
+            CELL endCell   = cellOf( end );
+
+            m_cells[startCell].push_back( i );
+
+            if( endCell != startCell )
+                m_cells[endCell].push_back( i );
+        }
+    }
+
+    /// @return int - the count of graphics not chained yet.
+    int GetCount() const { return m_count; }
 
-    // find the point closest to aPoint and perhaps exactly matching aPoint.
-    for( int i = 0; i<items->GetCount(); ++i )
+    /**
+     * Function Remove
+     * removes the graphic of index \a aIndex in the list given to the constructor.
+     */
+    void Remove( unsigned aIndex )
     {
-        DRAWSEGMENT*    graphic = (DRAWSEGMENT*) (*items)[i];
-        unsigned        d;
+        if( !m_removed[aIndex] )
+        {
+            m_removed[aIndex] = true;
+            --m_count;
+        }
+    }
 
-        wxASSERT( graphic->Type() == PCB_LINE_T );
+    /**
+     * Function TakeFirst
+     * removes and returns the first graphic not chained yet, in board order.
+     */
+    DRAWSEGMENT* TakeFirst()
+    {
+        while( m_removed[m_first] )
+            ++m_first;
 
-        switch( graphic->GetShape() )
+        Remove( m_first );
+        return m_graphics[m_first];
+    }
+
+    /**
+     * Function FindPoint
+     * searches for a graphic with an end point or start point of aPoint, and
+     * if found, removes it and returns it, else returns NULL.
+     * @param aPoint The starting or ending point to search for.
+     * @param aLimit is the distance from \a aPoint that still constitutes a valid find.
+     * @return DRAWSEGMENT* - The first graphic (in board order) that has a start or end
+     *   point matching aPoint, else the closest one within aLimit, otherwise NULL if none.
+     */
+    DRAWSEGMENT* FindPoint( const wxPoint& aPoint, unsigned aLimit )
+    {
+        int      limit = (int) aLimit;
+        CELL     first = cellOf( wxPoint( aPoint.x - limit, aPoint.y - limit ) );
+        CELL     last  = cellOf( wxPoint( aPoint.x + limit, aPoint.y + limit ) );
+        unsigned min_d = INT_MAX;
+        int      ndx_min = -1;
+
+        // find the point closest to aPoint and perhaps exactly matching aPoint.
+        for( int cx = first.first; cx <= last.first; ++cx )
         {
-        case S_ARC:
-            if( aPoint == graphic->GetArcStart() || aPoint == graphic->GetArcEnd() )
+            for( int cy = first.second; cy <= last.second; ++cy )
             {
-                items->Remove( i );
-                return graphic;
-            }
+                CELLS::const_iterator cell = m_cells.find( CELL( cx, cy ) );
 
-            d = close_ness( aPoint, graphic->GetArcStart() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
+                if( cell == m_cells.end() )
+                    continue;
 
-            d = close_ness( aPoint, graphic->GetArcEnd() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
-            break;
+                for( unsigned j = 0; j < cell->second.size(); ++j )
+                {
+                    int i = cell->second[j];
 
-        default:
-            if( aPoint == graphic->GetStart() || aPoint == graphic->GetEnd() )
-            {
-                items->Remove( i );
-                return graphic;
-            }
+                    if( m_removed[i] )
+                        continue;
 
-            d = close_ness( aPoint, graphic->GetStart() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
+                    wxPoint start;
+                    wxPoint end;
 
-            d = close_ness( aPoint, graphic->GetEnd() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
+                    endPoints( m_graphics[i], start, end );
+
+                    unsigned d = std::min( close_ness( aPoint, start ),
+                                           close_ness( aPoint, end ) );
+
+                    // Same choice as a search of the graphics in board order
+                    if( d < min_d || ( d == min_d && i < ndx_min ) )
+                    {
+                        min_d   = d;
+                        ndx_min = i;
+                    }
+                }
             }
         }
+
+        if( ndx_min >= 0 && min_d <= aLimit )
+        {
+            Remove( ndx_min );
+            return m_graphics[ndx_min];
+        }
+
+#if defined(DEBUG)
+        printf( "Unable to find segment matching point (%d,%d)\n",
+                aPoint.x, aPoint.y );
+
+        for( unsigned i = 0; i < m_graphics.size(); ++i )
+        {
+            if( m_removed[i] )
+                continue;
+
+            DRAWSEGMENT* graphic = m_graphics[i];
+
+            printf( "type=%s, GetStart()=%d,%d  GetEnd()=%d,%d\n",
+                    TO_UTF8( BOARD_ITEM::ShowShape( (STROKE_T) graphic->GetShape() ) ),
+                    graphic->GetStart().x,
+                    graphic->GetStart().y,
+                    graphic->GetEnd().x,
+                    graphic->GetEnd().y );
+        }
+#endif
+
+        return NULL;
     }
 
-    if( min_d <= aLimit )
+private:
+    typedef std::pair<int, int>                                 CELL;
+    typedef boost::unordered_map< CELL, std::vector<int> >      CELLS;
+
+    ///> The end points used to chain a graphic
+    static void endPoints( const DRAWSEGMENT* aGraphic, wxPoint& aStart, wxPoint& aEnd )
     {
-        DRAWSEGMENT* graphic = (DRAWSEGMENT*) (*items)[ndx_min];
-        items->Remove( ndx_min );
-        return graphic;
+        if( aGraphic->GetShape() == S_ARC )
+        {
+            aStart = aGraphic->GetArcStart();
+            aEnd   = aGraphic->GetArcEnd();
+        }
+        else
+        {
+            aStart = aGraphic->GetStart();
+            aEnd   = aGraphic->GetEnd();
+        }
     }
 
-#if defined(DEBUG)
-    printf( "Unable to find segment matching point (%d,%d)\n",
-            aPoint.x, aPoint.y );
+    ///> Rounds down a coordinate to a cell index, negative coordinates included
+    int cellCoord( int aCoord ) const
+    {
+        if( aCoord >= 0 )
+            return aCoord / m_cellSize;
+
+        return -( ( -( aCoord + 1 ) ) / m_cellSize ) - 1;
+    }
 
-    for( int i = 0; i< items->GetCount(); ++i )
+    CELL cellOf( const wxPoint& aPoint ) const
     {
-        DRAWSEGMENT* graphic = (DRAWSEGMENT*) (*items)[i];
-
-        printf( "type=%s, GetStart()=%d,%d  GetEnd()=%d,%d\n",
-                TO_UTF8( BOARD_ITEM::ShowShape( (STROKE_T) graphic->GetShape() ) ),
-                graphic->GetStart().x,
-                graphic->GetStart().y,
-                graphic->GetEnd().x,
-                graphic->GetEnd().y );
+        return CELL( cellCoord( aPoint.x ), cellCoord( aPoint.y ) );
     }
-#endif
 
-    return NULL;
-}
+    std::vector<DRAWSEGMENT*>   m_graphics;
+    std::vector<bool>           m_removed;      ///< Graphics already chained
+    CELLS                       m_cells;        ///< Graphics indices by end point cell
+    int                         m_cellSize;
+    int                         m_count;        ///< Count of graphics not chained yet
+    unsigned                    m_first;        ///< No graphic before it is left
+};
 
 
 /**
@@ -658,18 +754,40 @@ IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
 
         else
         {
-            PADSTACK*               padstack = makePADSTACK( aBoard, pad );
-            PADSTACKSET::iterator   iter = padstackset.find( *padstack );
+            PAD_KEY     key;
+
+            key.shape  = pad->GetShape();
+            key.size   = pad->GetSize();
+            key.delta  = pad->GetDelta();
+            key.offset = pad->GetOffset();
+            key.layers = pad->GetLayerMask() & ALL_CU_LAYERS;
 
-            if( iter != padstackset.end() )
+            PADSTACK_INDEX::iterator    known = padstackIndex.find( key );
+            PADSTACK*                   padstack;
+
+            if( known != padstackIndex.end() )
             {
-                // padstack is a duplicate, delete it and use the original
-                delete padstack;
-                padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
+                // a pad like this one has already been seen, no need to make its padstack
+                padstack = known->second;
             }
             else
             {
-                padstackset.insert( padstack );
+                padstack = makePADSTACK( aBoard, pad );
+
+                PADSTACKSET::iterator   iter = padstackset.find( *padstack );
+
+                if( iter != padstackset.end() )
+                {
+                    // padstack is a duplicate, delete it and use the original
+                    delete padstack;
+                    padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
+                }
+                else
+                {
+                    padstackset.insert( padstack );
+                }
+
+                padstackIndex[key] = padstack;
             }
 
             PIN* pin = new PIN( image );
@@ -889,21 +1007,23 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
 
     items.Collect( aBoard, scan_graphics );
 
-    for( int i = 0; i<items.GetCount(); )
+    std::vector<DRAWSEGMENT*> graphics;
+
+    for( int i = 0; i<items.GetCount(); ++i )
     {
-        if( items[i]->GetLayer() != EDGE_N )
-        {
-            items.Remove( i );
-        }
-        else    // remove graphics not on EDGE_N layer
+        // remove graphics not on EDGE_N layer
+        if( items[i]->GetLayer() == EDGE_N )
         {
             DBG( items[i]->Show( 0, std::cout );)
-            ++i;
+            graphics.push_back( (DRAWSEGMENT*) items[i] );
         }
     }
 
-    if( items.GetCount() )
+    if( graphics.size() )
     {
+        // The biggest proximity used below to chain graphics
+        OUTLINE_INDEX outline( graphics, Millimeter2iu( 0.25 ) );
+
         PATH*  path = new PATH( boundary );
         boundary->paths.push_back( path );
         path->layer_id = "pcb";
@@ -917,9 +1037,9 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
         wxPoint xmin    = wxPoint( INT_MAX, 0 );
         int     xmini   = 0;
 
-        for( int i = 0; i < items.GetCount(); i++ )
+        for( unsigned i = 0; i < graphics.size(); i++ )
         {
-            graphic = (DRAWSEGMENT*) items[i];
+            graphic = graphics[i];
 
             switch( graphic->GetShape() )
             {
@@ -1001,10 +1121,10 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
         // can put enough graphics together by matching endpoints to formulate a cohesive
         // polygon.
 
-        graphic = (DRAWSEGMENT*) items[xmini];
+        graphic = graphics[xmini];
 
-        // The first DRAWSEGMENT is in 'graphic', ok to remove it from 'items'
-        items.Remove( xmini );
+        // The first DRAWSEGMENT is in 'graphic', ok to remove it from 'outline'
+        outline.Remove( xmini );
 
         // Set maximum proximity threshold for point to point nearness metric for
         // board perimeter only, not interior keepouts yet.
@@ -1102,7 +1222,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
                 if( close_enough( startPt, prevPt, prox ) )     // the polygon is closed.
                     break;
 
-                graphic = findPoint( prevPt, &items, prox );
+                graphic = outline.FindPoint( prevPt, prox );
 
                 if( !graphic )
                 {
@@ -1121,7 +1241,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
         // for sloppy graphical items.
         prox = Millimeter2iu( 0.25 );
 
-        while( items.GetCount() )
+        while( outline.GetCount() )
         {
             // emit a signal layers keepout for every interior polygon left...
             KEEPOUT*    keepout = new KEEPOUT( NULL, T_keepout );
@@ -1130,8 +1250,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
             keepout->SetShape( poly_ko );
             poly_ko->SetLayerId( "signal" );
             pcb->structure->keepouts.push_back( keepout );
-            graphic = (DRAWSEGMENT*) items[0];
-            items.Remove( 0 );
+            graphic = outline.TakeFirst();
 
             if( graphic->GetShape() == S_CIRCLE )
             {
@@ -1221,7 +1340,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary ) throw( IO_ER
                     if( close_enough( startPt, prevPt, prox ) )
                         break;
 
-                    graphic = findPoint( prevPt, &items, prox );
+                    graphic = outline.FindPoint( prevPt, prox );
 
                     if( !graphic )
                     {
@@ -1354,7 +1473,7 @@ typedef std::set<std::string>                   STRINGSET;
 typedef std::pair<STRINGSET::iterator, bool>    STRINGSET_PAIR;
 
 
-void SPECCTRA_DB::FromBOARD( BOARD* aBoard ) throw( IO_ERROR )
+void SPECCTRA_DB::FromBOARD( BOARD* aBoard, bool aWithWiring ) throw( IO_ERROR )
 {
     TYPE_COLLECTOR          items;
 
@@ -1725,6 +1844,7 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard ) throw( IO_ERROR )
         items.Collect( aBoard, scanMODULEs );
 
         padstackset.clear();
+        padstackIndex.clear();
 
         for( int m = 0; m<items.GetCount(); ++m )
         {
@@ -1805,6 +1925,8 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard ) throw( IO_ERROR )
             pcb->library->AddPadstack( padstack );
         }
 
+        padstackIndex.clear();
+
         // copy our SPECCTRA_DB::nets to the pcb->network
         for( unsigned n = 1; n<nets.size(); ++n )
         {
@@ -1900,146 +2022,209 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard ) throw( IO_ERROR )
     }
 
 
-#if 1    // do existing wires and vias
+    //-----<create the wires and vias from tracks>--------------------------
+    if( aWithWiring )
+    {
+        exportWIREs( aBoard, NULL, 0 );
+        exportWIRE_VIAs( aBoard, NULL, 0 );
+    }
+    else
+    {
+        // The via padstacks must be in the library, even if the vias are not exported yet.
+        for( TRACK* track = aBoard->m_Track;  track;  track = track->Next() )
+        {
+            if( track->Type() == PCB_VIA_T && track->GetNet() != 0 )
+                registerVia( (SEGVIA*) track );
+        }
+    }
 
-    //-----<create the wires from tracks>-----------------------------------
+    //-----<via_descriptor>-------------------------------------------------
     {
-        // export all of them for now, later we'll decide what controls we need
-        // on this.
-        static const KICAD_T scanTRACKs[] = { PCB_TRACE_T, EOT };
+        // The pcb->library will output <padstack_descriptors> which is a combined
+        // list of part padstacks and via padstacks.  specctra dsn uses the
+        // <via_descriptors> to say which of those padstacks are vias.
 
-        items.Collect( aBoard, scanTRACKs );
+        // Output the vias in the padstack list here, by name only.  This must
+        // be done after exporting existing vias as WIRE_VIAs.
+        VIA* vias = pcb->structure->via;
 
-        std::string netname;
-        WIRING*     wiring = pcb->wiring;
-        PATH*       path = 0;
+        for(  unsigned viaNdx = 0; viaNdx < pcb->library->vias.size(); ++viaNdx )
+        {
+            vias->AppendVia( pcb->library->vias[viaNdx].padstack_id.c_str() );
+        }
+    }
 
-        int old_netcode = -1;
-        int old_width = -1;
-        LAYER_NUM old_layer = UNDEFINED_LAYER;
 
-        for( int i=0;  i<items.GetCount();  ++i )
-        {
-            TRACK*  track = (TRACK*) items[i];
+    //-----<output NETCLASSs>----------------------------------------------------
+    NETCLASSES& nclasses = aBoard->m_NetClasses;
 
-            int     netcode = track->GetNet();
+    exportNETCLASS( nclasses.GetDefault(), aBoard );
 
-            if( netcode == 0 )
-                continue;
+    for( NETCLASSES::iterator nc = nclasses.begin(); nc != nclasses.end(); ++nc )
+    {
+        NETCLASS* netclass = nc->second;
+        exportNETCLASS( netclass, aBoard );
+    }
+}
 
-            if( old_netcode != netcode
-            ||  old_width   != track->GetWidth()
-            ||  old_layer   != track->GetLayer()
-            ||  (path && path->points.back() != mapPt(track->GetStart()) )
-              )
-            {
-                old_width   = track->GetWidth();
-                old_layer   = track->GetLayer();
 
-                if( old_netcode != netcode )
-                {
-                    old_netcode = netcode;
-                    NETINFO_ITEM* net = aBoard->FindNet( netcode );
-                    wxASSERT( net );
-                    netname = TO_UTF8( net->GetNetname() );
-                }
+void SPECCTRA_DB::ExportBOARD( BOARD* aBoard, const wxString& aFilename ) throw( IO_ERROR )
+{
+    FromBOARD( aBoard, false );
 
-                WIRE* wire = new WIRE( wiring );
+    FILE_OUTPUTFORMATTER    formatter( aFilename, wxT( "wt" ), quote_char[0] );
+    WIRING*                 wiring = pcb->wiring;
 
-                wiring->wires.push_back( wire );
-                wire->net_id = netname;
+    pcb->pcbname = TO_UTF8( aFilename );
+    pcb->FormatHeader( &formatter, 0 );
 
-                wire->wire_type = T_protect;    // @todo, this should be configurable
+    // Same output as WIRING::Format(), but the wires and vias are made one at a time.
+    formatter.Print( 1, "(%s\n", wiring->Name() );
 
-                LAYER_NUM kiLayer  = track->GetLayer();
-                int pcbLayer = kicadLayer2pcb[kiLayer];
+    if( wiring->unit )
+        wiring->unit->Format( &formatter, 2 );
 
-                path = new PATH( wire );
+    exportWIREs( aBoard, &formatter, 2 );
+    exportWIRE_VIAs( aBoard, &formatter, 2 );
 
-                wire->SetShape( path );
+    formatter.Print( 1, ")\n" );
+    formatter.Print( 0, ")\n" );
+}
 
-                path->layer_id = layerIds[pcbLayer];
-                path->aperture_width = scale( old_width );
 
-                path->AppendPoint( mapPt( track->GetStart() ) );
-            }
+PADSTACK* SPECCTRA_DB::registerVia( const SEGVIA* aVia )
+{
+    PADSTACK*   padstack    = makeVia( aVia );
+    PADSTACK*   registered  = pcb->library->LookupVia( padstack );
 
-            path->AppendPoint( mapPt( track->GetEnd() ) );
-        }
-    }
+    // if the one looked up is not our padstack, then delete our padstack
+    // since it was a duplicate of one already registered.
+    if( padstack != registered )
+        delete padstack;
+
+    return registered;
+}
 
 
-    //-----<export the existing real BOARD instantiated vias>-----------------
+void SPECCTRA_DB::exportWIREs( BOARD* aBoard, OUTPUTFORMATTER* aOut, int aNestLevel )
+    throw( IO_ERROR )
+{
+    // export all of them for now, later we'll decide what controls we need
+    // on this.
+    std::string             netname;
+    WIRING*                 wiring = pcb->wiring;
+    std::auto_ptr<WIRE>     pending;    // the wire being built, when formatted to aOut
+    PATH*                   path = 0;
+
+    int old_netcode = -1;
+    int old_width = -1;
+    LAYER_NUM old_layer = UNDEFINED_LAYER;
+
+    for( TRACK* track = aBoard->m_Track;  track;  track = track->Next() )
     {
-        // Export all vias, once per unique size and drill diameter combo.
-        static const KICAD_T scanVIAs[] = { PCB_VIA_T, EOT };
+        if( track->Type() != PCB_TRACE_T )
+            continue;
 
-        items.Collect( aBoard, scanVIAs );
+        int     netcode = track->GetNet();
 
-        for( int i = 0; i<items.GetCount(); ++i )
+        if( netcode == 0 )
+            continue;
+
+        if( old_netcode != netcode
+        ||  old_width   != track->GetWidth()
+        ||  old_layer   != track->GetLayer()
+        ||  (path && path->points.back() != mapPt(track->GetStart()) )
+          )
         {
-            SEGVIA* via = (SEGVIA*) items[i];
-            wxASSERT( via->Type() == PCB_VIA_T );
+            old_width   = track->GetWidth();
+            old_layer   = track->GetLayer();
 
-            int     netcode = via->GetNet();
+            if( old_netcode != netcode )
+            {
+                old_netcode = netcode;
+                NETINFO_ITEM* net = aBoard->FindNet( netcode );
+                wxASSERT( net );
+                netname = TO_UTF8( net->GetNetname() );
+            }
 
-            if( netcode == 0 )
-                continue;
+            WIRE* wire = new WIRE( wiring );
 
-            PADSTACK*   padstack    = makeVia( via );
-            PADSTACK*   registered  = pcb->library->LookupVia( padstack );
+            if( aOut )
+            {
+                // the previous wire is complete
+                if( pending.get() )
+                    pending->Format( aOut, aNestLevel );
 
-            // if the one looked up is not our padstack, then delete our padstack
-            // since it was a duplicate of one already registered.
-            if( padstack != registered )
+                pending.reset( wire );
+            }
+            else
             {
-                delete padstack;
+                wiring->wires.push_back( wire );
             }
 
-            WIRE_VIA* dsnVia = new WIRE_VIA( pcb->wiring );
+            wire->net_id = netname;
 
-            pcb->wiring->wire_vias.push_back( dsnVia );
+            wire->wire_type = T_protect;    // @todo, this should be configurable
 
-            dsnVia->padstack_id = registered->padstack_id;
-            dsnVia->vertexes.push_back( mapPt( via->GetPosition() ) );
+            LAYER_NUM kiLayer  = track->GetLayer();
+            int pcbLayer = kicadLayer2pcb[kiLayer];
 
-            NETINFO_ITEM* net = aBoard->FindNet( netcode );
-            wxASSERT( net );
+            path = new PATH( wire );
 
-            dsnVia->net_id = TO_UTF8( net->GetNetname() );
+            wire->SetShape( path );
 
-            dsnVia->via_type = T_protect;     // @todo, this should be configurable
+            path->layer_id = layerIds[pcbLayer];
+            path->aperture_width = scale( old_width );
+
+            path->AppendPoint( mapPt( track->GetStart() ) );
         }
+
+        path->AppendPoint( mapPt( track->GetEnd() ) );
     }
 
-#endif    // do existing wires and vias
+    if( pending.get() )
+        pending->Format( aOut, aNestLevel );
+}
 
-    //-----<via_descriptor>-------------------------------------------------
+
+void SPECCTRA_DB::exportWIRE_VIAs( BOARD* aBoard, OUTPUTFORMATTER* aOut, int aNestLevel )
+    throw( IO_ERROR )
+{
+    // Export all vias, once per unique size and drill diameter combo.
+    for( TRACK* track = aBoard->m_Track;  track;  track = track->Next() )
     {
-        // The pcb->library will output <padstack_descriptors> which is a combined
-        // list of part padstacks and via padstacks.  specctra dsn uses the
-        // <via_descriptors> to say which of those padstacks are vias.
+        if( track->Type() != PCB_VIA_T )
+            continue;
 
-        // Output the vias in the padstack list here, by name only.  This must
-        // be done after exporting existing vias as WIRE_VIAs.
-        VIA* vias = pcb->structure->via;
+        SEGVIA* via = (SEGVIA*) track;
 
-        for(  unsigned viaNdx = 0; viaNdx < pcb->library->vias.size(); ++viaNdx )
-        {
-            vias->AppendVia( pcb->library->vias[viaNdx].padstack_id.c_str() );
-        }
-    }
+        int     netcode = via->GetNet();
 
+        if( netcode == 0 )
+            continue;
 
-    //-----<output NETCLASSs>----------------------------------------------------
-    NETCLASSES& nclasses = aBoard->m_NetClasses;
+        PADSTACK*   registered = registerVia( via );
 
-    exportNETCLASS( nclasses.GetDefault(), aBoard );
+        WIRE_VIA* dsnVia = new WIRE_VIA( pcb->wiring );
 
-    for( NETCLASSES::iterator nc = nclasses.begin(); nc != nclasses.end(); ++nc )
-    {
-        NETCLASS* netclass = nc->second;
-        exportNETCLASS( netclass, aBoard );
+        // when formatted to aOut, the via is not kept
+        std::auto_ptr<WIRE_VIA> deleter( aOut ? dsnVia : NULL );
+
+        if( !aOut )
+            pcb->wiring->wire_vias.push_back( dsnVia );
+
+        dsnVia->padstack_id = registered->padstack_id;
+        dsnVia->vertexes.push_back( mapPt( via->GetPosition() ) );
+
+        NETINFO_ITEM* net = aBoard->FindNet( netcode );
+        wxASSERT( net );
+
+        dsnVia->net_id = TO_UTF8( net->GetNetname() );
+
+        dsnVia->via_type = T_protect;     // @todo, this should be configurable
+
+        if( aOut )
+            dsnVia->Format( aOut, aNestLevel );
     }
 }
 
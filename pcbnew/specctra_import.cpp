@@ -38,6 +38,8 @@
 #include <wxPcbStruct.h>
 #include <macros.h>
 
+#include <algorithm>            // std::stable_sort()
+
 #include <class_board.h>
 #include <class_module.h>
 #include <class_edge_mod.h>
@@ -345,6 +347,24 @@ SEGVIA* SPECCTRA_DB::makeVIA( PADSTACK* aPadstack, const POINT& aPoint, int aNet
 }
 
 
+static bool sortByNetcode( const TRACK* aRef, const TRACK* aItem )
+{
+    return aRef->GetNet() < aItem->GetNet();
+}
+
+
+/**
+ * Function addTracks
+ * adds the tracks and vias made from the session to the board, in a single pass.
+ */
+static void addTracks( BOARD* aBoard, TRACK_PTRS& aTracks )
+{
+    std::stable_sort( aTracks.begin(), aTracks.end(), sortByNetcode );
+    aBoard->AddTracks( aTracks );
+    aTracks.clear();
+}
+
+
 // no UI code in this function, throw exception to report problems to the
 // UI handler: void PCB_EDIT_FRAME::ImportSpecctraSession( wxCommandEvent& event )
 
@@ -440,116 +460,131 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard ) throw( IO_ERROR )
 
     routeResolution = session->route->GetUnits();
 
-    // Walk the NET_OUTs and create tracks and vias anew.
-    NET_OUTS& net_outs = session->route->net_outs;
-    for( NET_OUTS::iterator net=net_outs.begin();  net!=net_outs.end();  ++net )
-    {
-        int         netCode = 0;
+    // The tracks and vias are added to the board all at once, when they are all made
+    TRACK_PTRS  newTracks;
 
-        // page 143 of spec says wire's net_id is optional
-        if( net->net_id.size() )
+    try
+    {
+        // Walk the NET_OUTs and create tracks and vias anew.
+        NET_OUTS& net_outs = session->route->net_outs;
+        for( NET_OUTS::iterator net=net_outs.begin();  net!=net_outs.end();  ++net )
         {
-            wxString netName = FROM_UTF8( net->net_id.c_str() );
+            int         netCode = 0;
 
-            NETINFO_ITEM* net = aBoard->FindNet( netName );
-            if( net )
-                netCode = net->GetNet();
-            else  // else netCode remains 0
+            // page 143 of spec says wire's net_id is optional
+            if( net->net_id.size() )
             {
-                // int breakhere = 1;
-            }
-        }
-
-        WIRES& wires = net->wires;
-        for( unsigned i=0;  i<wires.size();  ++i )
-        {
-            WIRE*   wire  = &wires[i];
-            DSN_T   shape = wire->shape->Type();
+                wxString netName = FROM_UTF8( net->net_id.c_str() );
 
-            if( shape != T_path )
-            {
-                /*  shape == T_polygon is expected from freerouter if you have
-                    a zone on a non "power" type layer, i.e. a T_signal layer
-                    and the design does a round trip back in as session here.
-                    We kept our own zones in the BOARD, so ignore this so called
-                    'wire'.
-
-                wxString netId = FROM_UTF8( wire->net_id.c_str() );
-                ThrowIOError(
-                    _("Unsupported wire shape: \"%s\" for net: \"%s\""),
-                    DLEX::GetTokenString(shape).GetData(),
-                    netId.GetData()
-                    );
-                */
+                NETINFO_ITEM* net = aBoard->FindNet( netName );
+                if( net )
+                    netCode = net->GetNet();
+                else  // else netCode remains 0
+                {
+                    // int breakhere = 1;
+                }
             }
-            else
+
+            WIRES& wires = net->wires;
+            for( unsigned i=0;  i<wires.size();  ++i )
             {
-                PATH*   path = (PATH*) wire->shape;
-                for( unsigned pt=0;  pt<path->points.size()-1;  ++pt )
+                WIRE*   wire  = &wires[i];
+                DSN_T   shape = wire->shape->Type();
+
+                if( shape != T_path )
                 {
-                    /* a debugging aid, may come in handy
-                    if( path->points[pt].x == 547800
-                    &&  path->points[pt].y == -380250 )
+                    /*  shape == T_polygon is expected from freerouter if you have
+                        a zone on a non "power" type layer, i.e. a T_signal layer
+                        and the design does a round trip back in as session here.
+                        We kept our own zones in the BOARD, so ignore this so called
+                        'wire'.
+
+                    wxString netId = FROM_UTF8( wire->net_id.c_str() );
+                    ThrowIOError(
+                        _("Unsupported wire shape: \"%s\" for net: \"%s\""),
+                        DLEX::GetTokenString(shape).GetData(),
+                        netId.GetData()
+                        );
+                    */
+                }
+                else
+                {
+                    PATH*   path = (PATH*) wire->shape;
+                    for( unsigned pt=0;  pt<path->points.size()-1;  ++pt )
                     {
-                        int breakhere = 1;
+                        /* a debugging aid, may come in handy
+                        if( path->points[pt].x == 547800
+                        &&  path->points[pt].y == -380250 )
+                        {
+                            int breakhere = 1;
+                        }
+                        */
+
+                        newTracks.push_back( makeTRACK( path, pt, netCode ) );
                     }
-                    */
-
-                    TRACK* track = makeTRACK( path, pt, netCode );
-                    aBoard->Add( track );
                 }
             }
-        }
 
-        WIRE_VIAS& wire_vias = net->wire_vias;
-        LIBRARY& library = *session->route->library;
-        for( unsigned i=0;  i<wire_vias.size();  ++i )
-        {
-            int         netCode = 0;
-
-            // page 144 of spec says wire_via's net_id is optional
-            if( net->net_id.size() )
+            WIRE_VIAS& wire_vias = net->wire_vias;
+            LIBRARY& library = *session->route->library;
+            for( unsigned i=0;  i<wire_vias.size();  ++i )
             {
-                wxString netName = FROM_UTF8( net->net_id.c_str() );
+                int         netCode = 0;
 
-                NETINFO_ITEM* net = aBoard->FindNet( netName );
-                if( net )
-                    netCode = net->GetNet();
+                // page 144 of spec says wire_via's net_id is optional
+                if( net->net_id.size() )
+                {
+                    wxString netName = FROM_UTF8( net->net_id.c_str() );
 
-                // else netCode remains 0
-            }
+                    NETINFO_ITEM* net = aBoard->FindNet( netName );
+                    if( net )
+                        netCode = net->GetNet();
 
-            WIRE_VIA* wire_via = &wire_vias[i];
+                    // else netCode remains 0
+                }
 
-            // example: (via Via_15:8_mil 149000 -71000 )
+                WIRE_VIA* wire_via = &wire_vias[i];
 
-            PADSTACK* padstack = library.FindPADSTACK( wire_via->GetPadstackId() );
-            if( !padstack )
-            {
-                // Dick  Feb 29, 2008:
-                // Freerouter has a bug where it will not round trip all vias.
-                // Vias which have a (use_via) element will be round tripped.
-                // Vias which do not, don't come back in in the session library,
-                // even though they may be actually used in the pre-routed,
-                // protected wire_vias. So until that is fixed, create the
-                // padstack from its name as a work around.
+                // example: (via Via_15:8_mil 149000 -71000 )
 
+                PADSTACK* padstack = library.FindPADSTACK( wire_via->GetPadstackId() );
+                if( !padstack )
+                {
+                    // Dick  Feb 29, 2008:
+                    // Freerouter has a bug where it will not round trip all vias.
+                    // Vias which have a (use_via) element will be round tripped.
+                    // Vias which do not, don't come back in in the session library,
+                    // even though they may be actually used in the pre-routed,
+                    // protected wire_vias. So until that is fixed, create the
+                    // padstack from its name as a work around.
 
-                // Could use a STRING_FORMATTER here and convert the entire
-                // wire_via to text and put that text into the exception.
-                wxString psid( FROM_UTF8( wire_via->GetPadstackId().c_str() ) );
 
-                ThrowIOError( _("A wire_via references a missing padstack \"%s\""),
-                             GetChars( psid ) );
-            }
+                    // Could use a STRING_FORMATTER here and convert the entire
+                    // wire_via to text and put that text into the exception.
+                    wxString psid( FROM_UTF8( wire_via->GetPadstackId().c_str() ) );
 
-            for( unsigned v=0;  v<wire_via->vertexes.size();  ++v )
-            {
-                SEGVIA* via = makeVIA( padstack, wire_via->vertexes[v], netCode );
-                aBoard->Add( via );
+                    ThrowIOError( _("A wire_via references a missing padstack \"%s\""),
+                                 GetChars( psid ) );
+                }
+
+                for( unsigned v=0;  v<wire_via->vertexes.size();  ++v )
+                {
+                    SEGVIA* via = makeVIA( padstack, wire_via->vertexes[v], netCode );
+
+                    if( via )
+                        newTracks.push_back( via );
+                }
             }
         }
     }
+    catch( IO_ERROR& )
+    {
+        // Keep what has been imported, as when the tracks were added one by one
+        addTracks( aBoard, newTracks );
+        throw;
+    }
+
+    addTracks( aBoard, newTracks );
 }
 
 
@@ -107,8 +107,6 @@ bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb,
             AddClearanceAreasPolygonsToPolysList( aPcb );
         else
         {
-            // This KI_POLYGON_SET is the area(s) to fill, with m_ZoneMinThickness/2
-            KI_POLYGON_SET polyset_zone_solid_areas;
             int         margin = m_ZoneMinThickness / 2;
 
             /* First, creates the main polygon (i.e. the filled area using only one outline)
@@ -116,13 +114,9 @@ bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb,
              * this margin is the room to redraw outlines with segments having a width set to
              * m_ZoneMinThickness
              * so m_ZoneMinThickness is the min thickness of the filled zones areas
-             * the polygon is stored in polyset_zone_solid_areas
+             * the solid area is shrunk in place in m_FilledPolysList
              */
-            CopyPolygonsFromFilledPolysListToKiPolygonList( polyset_zone_solid_areas );
-            polyset_zone_solid_areas -= margin;
-            // put solid area in m_FilledPolysList:
-            m_FilledPolysList.RemoveAllContours();
-            CopyPolygonsFromKiPolygonListToFilledPolysList( polyset_zone_solid_areas );
+            m_FilledPolysList.Inflate( -margin );
         }
         if ( m_FillMode )   // if fill mode uses segments, create them:
             FillZoneAreasWithSegments( );
@@ -45,6 +45,7 @@
  */
 
 #include <cmath>
+#include <vector>
 
 #include <fctsys.h>
 #include <polygons_defs.h>
@@ -62,6 +63,7 @@
 #include <pcbnew.h>
 #include <zones.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <shape_templates.h>
 
 
 extern void BuildUnconnectedThermalStubsPolygonList( CPOLYGONS_LIST& aCornerBuffer,
@@ -79,7 +81,8 @@ extern void CreateThermalReliefPadPolygon( CPOLYGONS_LIST& aCornerBuffer,
                                            int                   aMinThicknessValue,
                                            int                   aCircleToSegmentsCount,
                                            double                aCorrectionFactor,
-                                           double                aThermalRot );
+                                           double                aThermalRot,
+                                           SHAPE_TEMPLATES*      aTemplates );
 
 // Local Variables:
 static double s_thermalRot = 450;  // angle of stubs in thermal reliefs for round pads
@@ -138,8 +141,6 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
      */
     s_Correction = 1.0 / cos( M_PI / s_CircleToSegmentsCount );
 
-    // This KI_POLYGON_SET is the area(s) to fill, with m_ZoneMinThickness/2
-    KI_POLYGON_SET polyset_zone_solid_areas;
     int         margin = m_ZoneMinThickness / 2;
 
     /* First, creates the main polygon (i.e. the filled area using only one outline)
@@ -147,13 +148,13 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
      * this margin is the room to redraw outlines with segments having a width set to
      * m_ZoneMinThickness
      * so m_ZoneMinThickness is the min thickness of the filled zones areas
-     * the main polygon is stored in polyset_zone_solid_areas
+     * the main polygon is shrunk in place in m_FilledPolysList
+     * if nothing is left, the zone is not filled: its initial outline has no clearance
+     * areas removed, and would overlap the pads and tracks of other nets
      */
+    m_FilledPolysList.Inflate( -margin );
 
-    CopyPolygonsFromFilledPolysListToKiPolygonList( polyset_zone_solid_areas );
-    polyset_zone_solid_areas -= margin;
-
-    if( polyset_zone_solid_areas.size() == 0 )
+    if( m_FilledPolysList.GetCornersCount() == 0 )
         return;
 
     /* Calculates the clearance value that meet DRC requirements
@@ -180,6 +181,27 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     biggest_clearance = std::max( biggest_clearance, zone_clearance );
     zone_boundingbox.Inflate( biggest_clearance );
 
+    /* Only the modules, tracks and vias near the zone are candidates: they are found
+     * using the board spatial index. Pads are tested with their own clearance (or thermal
+     * gap) on top of zone_boundingbox, so modules are searched in a larger area; the index
+     * already accounts for local clearances and thermal gaps of modules and pads.
+     */
+    EDA_RECT search_area = zone_boundingbox;
+    search_area.Inflate( std::max( biggest_clearance, m_ThermalReliefGap ) + margin );
+
+    BOARD_SPATIAL_INDEX& index = aPcb->GetSpatialIndex();
+
+    // An item moved in place without the board being told, e.g. by a script, would
+    // be missed and the zone would be filled over it: check all of them first.
+    index.UpdateMovedItems();
+
+    std::vector<MODULE*> modules;
+    std::vector<TRACK*>  tracks;
+
+    index.QueryModules( search_area, modules );
+    index.QuerySegments( zone_boundingbox, GetLayerMask( GetLayer() ), tracks );
+    index.QueryVias( zone_boundingbox, tracks );
+
     /*
      * First : Add pads. Note: pads having the same net as zone are left in zone.
      * Thermal shapes will be created later if necessary
@@ -190,6 +212,9 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     static CPOLYGONS_LIST cornerBufferPolysToSubstract;
     cornerBufferPolysToSubstract.RemoveAllContours();
 
+    // Pads and vias having the same shape share their polygons during this fill
+    SHAPE_TEMPLATES shapeTemplates;
+
     /* Use a dummy pad to calculate hole clerance when a pad is not on all copper layers
      * and this pad has a hole
      * This dummy pad has the size and shape of the hole
@@ -200,9 +225,9 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     MODULE dummymodule( aPcb );    // Creates a dummy parent
     D_PAD dummypad( &dummymodule );
     D_PAD* nextpad;
-    for( MODULE* module = aPcb->m_Modules;  module;  module = module->Next() )
+    for( unsigned ii = 0; ii < modules.size(); ii++ )
     {
-        for( D_PAD* pad = module->Pads(); pad != NULL; pad = nextpad )
+        for( D_PAD* pad = modules[ii]->Pads(); pad != NULL; pad = nextpad )
         {
             nextpad = pad->Next();  // pad pointer can be modified by next code, so
                                     // calculate the next pad here
@@ -240,7 +265,8 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
                     pad->TransformShapeWithClearanceToPolygon( cornerBufferPolysToSubstract,
                                                                clearance,
                                                                s_CircleToSegmentsCount,
-                                                               s_Correction );
+                                                               s_Correction,
+                                                               &shapeTemplates );
                 }
 
                 continue;
@@ -261,7 +287,8 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
                     pad->TransformShapeWithClearanceToPolygon( cornerBufferPolysToSubstract,
                                                                gap,
                                                                s_CircleToSegmentsCount,
-                                                               s_Correction );
+                                                               s_Correction,
+                                                               &shapeTemplates );
                 }
             }
         }
@@ -270,8 +297,10 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     /* Add holes (i.e. tracks and vias areas as polygons outlines)
      * in cornerBufferPolysToSubstract
      */
-    for( TRACK* track = aPcb->m_Track;  track;  track = track->Next() )
+    for( unsigned ii = 0; ii < tracks.size(); ii++ )
     {
+        TRACK* track = tracks[ii];
+
         if( !track->IsOnLayer( GetLayer() ) )
             continue;
 
@@ -287,7 +316,8 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
             track->TransformShapeWithClearanceToPolygon( cornerBufferPolysToSubstract,
                                                          clearance,
                                                          s_CircleToSegmentsCount,
-                                                         s_Correction );
+                                                         s_Correction,
+                                                         &shapeTemplates );
         }
     }
 
@@ -295,9 +325,9 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
      * Pcbnew allows these items to be on copper layers in microwave applictions
      * This is a bad thing, but must be handle here, until a better way is found
      */
-    for( MODULE* module = aPcb->m_Modules;  module;  module = module->Next() )
+    for( unsigned ii = 0; ii < modules.size(); ii++ )
     {
-        for( BOARD_ITEM* item = module->GraphicalItems();  item;  item = item->Next() )
+        for( BOARD_ITEM* item = modules[ii]->GraphicalItems();  item;  item = item->Next() )
         {
             if( !item->IsOnLayer( GetLayer() ) )
                 continue;
@@ -322,6 +352,12 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
         if( item->GetLayer() != GetLayer() && item->GetLayer() != EDGE_N )
             continue;
 
+        item_boundingbox = item->GetBoundingBox();
+        item_boundingbox.Inflate( zone_clearance );
+
+        if( !item_boundingbox.Intersects( zone_boundingbox ) )
+            continue;
+
         switch( item->Type() )
         {
         case PCB_LINE_T:
@@ -378,9 +414,9 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     }
 
    // Remove thermal symbols
-    for( MODULE* module = aPcb->m_Modules;  module;  module = module->Next() )
+    for( unsigned ii = 0; ii < modules.size(); ii++ )
     {
-        for( D_PAD* pad = module->Pads(); pad != NULL; pad = pad->Next() )
+        for( D_PAD* pad = modules[ii]->Pads(); pad != NULL; pad = pad->Next() )
         {
             // Rejects non-standard pads with tht-only thermal reliefs
             if( GetPadConnection( pad ) == THT_THERMAL
@@ -407,25 +443,17 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
                                                GetThermalReliefCopperBridge( pad ),
                                                m_ZoneMinThickness,
                                                s_CircleToSegmentsCount,
-                                               s_Correction, s_thermalRot );
+                                               s_Correction, s_thermalRot,
+                                               &shapeTemplates );
             }
         }
     }
 
     // cornerBufferPolysToSubstract contains polygons to substract.
-    // polyset_zone_solid_areas contains the main filled area
-    // Calculate now actual solid areas
+    // m_FilledPolysList contains the main filled area
+    // Calculate now actual solid areas: remove holes from initial area
     if( cornerBufferPolysToSubstract.GetCornersCount() > 0 )
-    {
-        KI_POLYGON_SET polyset_holes;
-        cornerBufferPolysToSubstract.ExportTo( polyset_holes );
-        // Remove holes from initial area.:
-        polyset_zone_solid_areas -= polyset_holes;
-    }
-
-    // put solid areas in m_FilledPolysList:
-    m_FilledPolysList.RemoveAllContours();
-    CopyPolygonsFromKiPolygonListToFilledPolysList( polyset_zone_solid_areas );
+        m_FilledPolysList.BooleanSubtract( cornerBufferPolysToSubstract );
 
     // Remove insulated islands:
     if( GetNet() > 0 )
@@ -443,15 +471,8 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
     // remove copper areas corresponding to not connected stubs
     if( cornerBufferPolysToSubstract.GetCornersCount() )
     {
-        KI_POLYGON_SET polyset_holes;
-        cornerBufferPolysToSubstract.ExportTo( polyset_holes );
-
         // Remove unconnected stubs
-        polyset_zone_solid_areas -= polyset_holes;
-
-        // put these areas in m_FilledPolysList
-        m_FilledPolysList.RemoveAllContours();
-        CopyPolygonsFromKiPolygonListToFilledPolysList( polyset_zone_solid_areas );
+        m_FilledPolysList.BooleanSubtract( cornerBufferPolysToSubstract );
 
         if( GetNet() > 0 )
             TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
@@ -459,16 +480,3 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList( BOARD* aPcb )
 
     cornerBufferPolysToSubstract.RemoveAllContours();
 }
-
-
-void ZONE_CONTAINER::CopyPolygonsFromKiPolygonListToFilledPolysList( KI_POLYGON_SET& aKiPolyList )
-{
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.ImportFrom( aKiPolyList );
-}
-
-
-void ZONE_CONTAINER::CopyPolygonsFromFilledPolysListToKiPolygonList( KI_POLYGON_SET& aKiPolyList )
-{
-    m_FilledPolysList.ExportTo( aKiPolyList );
-}
@@ -1268,73 +1268,218 @@ void CPOLYGONS_LIST::ExportTo( KI_POLYGON_WITH_HOLES& aPolygoneWithHole )
     }
 }
 
+/*
+ * Boolean operations and offsets of polygons use boost::polygon, as the zone filling
+ * always did, but the corners are not copied to and from KI_POLYGON_SET any more:
+ * the contours of a CPOLYGONS_LIST are given to the engine where they are stored, and the
+ * resulting polygons are written directly in the corner list.
+ */
+
 /**
- * Copy all contours to a KI_POLYGON_SET aPolygons
- * Each contour is copied into a KI_POLYGON, and each KI_POLYGON
- * is append to aPolygons
+ * Class CONTOUR_VIEW
+ * is a contour of a CPOLYGONS_LIST, seen as a polygon by boost::polygon.
  */
-void CPOLYGONS_LIST::ExportTo( KI_POLYGON_SET& aPolygons )
+class CONTOUR_VIEW
 {
-    std::vector<KI_POLY_POINT> cornerslist;
-    unsigned    corners_count = GetCornersCount();
+public:
+    typedef int                                     coordinate_type;
+    typedef std::vector<CPolyPt>::const_iterator    iterator_type;
+    typedef CPolyPt                                 point_type;
 
-    // Count the number of polygons in aCornersBuffer
-    int         polycount = 0;
+    CONTOUR_VIEW( iterator_type aBegin, iterator_type aEnd ) :
+        m_begin( aBegin ), m_end( aEnd )
+    {
+    }
 
-    for( unsigned ii = 0; ii < corners_count; ii++ )
+    iterator_type begin() const { return m_begin; }
+    iterator_type end() const { return m_end; }
+    std::size_t size() const { return m_end - m_begin; }
+
+private:
+    iterator_type   m_begin;
+    iterator_type   m_end;
+};
+
+
+/**
+ * Class CONTOUR_WRITER
+ * is given by CONTOUR_SINK to boost::polygon to receive each polygon of a result,
+ * which is appended to the corner list as a new contour.
+ */
+class CONTOUR_WRITER
+{
+public:
+    typedef int                                     coordinate_type;
+    typedef std::vector<CPolyPt>::const_iterator    iterator_type;
+    typedef CPolyPt                                 point_type;
+
+    CONTOUR_WRITER() :
+        m_list( NULL )
     {
-        if( IsEndContour( ii ) )
-            polycount++;
     }
 
-    aPolygons.reserve( polycount );
+    template <class ITERATOR>
+    void set( ITERATOR aBegin, ITERATOR aEnd )
+    {
+        for( ; aBegin != aEnd; ++aBegin )
+            m_list->AddCorner( CPolyPt( bpl::x( *aBegin ), bpl::y( *aBegin ) ) );
+
+        m_list->CloseLastContour();
+    }
 
-    for( unsigned icnt = 0; icnt < corners_count; )
+    CPOLYGONS_LIST* m_list;
+};
+
+
+/**
+ * Class CONTOUR_SINK
+ * is the output container given to boost::polygon to get a result in a corner list.
+ */
+class CONTOUR_SINK
+{
+public:
+    typedef CONTOUR_WRITER  value_type;
+
+    CONTOUR_SINK( CPOLYGONS_LIST& aList )
     {
-        KI_POLYGON  poly;
-        cornerslist.clear();
+        m_writer.m_list = &aList;
+    }
 
-        unsigned    ii;
+    // Polygons are written by back(), which is called for each new polygon
+    void push_back( const value_type& ) {}
+    value_type& back() { return m_writer; }
 
-        for( ii = icnt; ii < corners_count; ii++ )
-        {
-            cornerslist.push_back( KI_POLY_POINT( GetX( ii ), GetY( ii ) ) );
+private:
+    CONTOUR_WRITER  m_writer;
+};
 
-            if( IsEndContour( ii ) )
-                break;
-        }
 
-        bpl::set_points( poly, cornerslist.begin(), cornerslist.end() );
-        aPolygons.push_back( poly );
-        icnt = ii + 1;
+namespace boost { namespace polygon {
+
+template <>
+struct geometry_concept<CPolyPt>
+{
+    typedef point_concept type;
+};
+
+
+template <>
+struct point_traits<CPolyPt>
+{
+    typedef int coordinate_type;
+
+    static inline coordinate_type get( const CPolyPt& aPoint, orientation_2d aOrient )
+    {
+        return aOrient == HORIZONTAL ? aPoint.x : aPoint.y;
     }
-}
+};
+
+
+template <>
+struct geometry_concept<CONTOUR_VIEW>
+{
+    typedef polygon_concept type;
+};
 
 
-/* Imports all polygons found in a KI_POLYGON_SET in list
+template <>
+struct geometry_concept<CONTOUR_WRITER>
+{
+    typedef polygon_concept type;
+};
+
+} }
+
+
+typedef bpl::polygon_set_data<int> POLYGON_SET_DATA;
+
+
+/* Gives the contours found in a range of corners to the engine
  */
-void CPOLYGONS_LIST::ImportFrom( KI_POLYGON_SET& aPolygons )
+static void insertContours( POLYGON_SET_DATA& aSet,
+                            std::vector<CPolyPt>::const_iterator aBegin,
+                            std::vector<CPolyPt>::const_iterator aEnd )
 {
-    CPolyPt corner;
+    std::vector<CPolyPt>::const_iterator start = aBegin;
 
-    for( unsigned ii = 0; ii < aPolygons.size(); ii++ )
+    for( std::vector<CPolyPt>::const_iterator it = aBegin; it != aEnd; ++it )
     {
-        KI_POLYGON& poly = aPolygons[ii];
-
-        for( unsigned jj = 0; jj < poly.size(); jj++ )
+        if( it->end_contour )
         {
-            KI_POLY_POINT point = *(poly.begin() + jj);
-            corner.x    = point.x();
-            corner.y    = point.y();
-            corner.end_contour = false;
-            AddCorner( corner );
+            aSet.insert( CONTOUR_VIEW( start, it + 1 ) );
+            start = it + 1;
         }
-
-        CloseLastContour();
     }
+
+    // An unclosed last contour
+    if( start != aEnd )
+        aSet.insert( CONTOUR_VIEW( start, aEnd ) );
 }
 
 
+static void insertContours( POLYGON_SET_DATA& aSet, const CPOLYGONS_LIST& aList )
+{
+    insertContours( aSet, aList.GetList().begin(), aList.GetList().end() );
+}
+
+
+/* Replaces the contours of aList by the polygons of aSet, holes being linked to their
+ * outline
+ */
+static void getContours( const POLYGON_SET_DATA& aSet, CPOLYGONS_LIST& aList )
+{
+    CONTOUR_SINK sink( aList );
+
+    aList.RemoveAllContours();
+    aSet.get( sink );
+}
+
+
+void CPOLYGONS_LIST::Inflate( int aDelta, bool aArcCorners, int aCircleToSegmentsCount )
+{
+    POLYGON_SET_DATA polygons;
+
+    insertContours( polygons, *this );
+
+    // bpl::resize() cleans the polygons before and after the offset, as it did when it was
+    // used on a KI_POLYGON_SET: cleaning rounds intersections and is not idempotent
+    bpl::resize( polygons, aDelta, aArcCorners, aCircleToSegmentsCount );
+    getContours( polygons, *this );
+}
+
+
+void CPOLYGONS_LIST::Merge()
+{
+    POLYGON_SET_DATA polygons;
+
+    insertContours( polygons, *this );
+    getContours( polygons, *this );
+}
+
+
+void CPOLYGONS_LIST::BooleanAdd( const CPOLYGONS_LIST& aPolygons )
+{
+    POLYGON_SET_DATA polygons;
+    POLYGON_SET_DATA other;
+
+    insertContours( polygons, *this );
+    insertContours( other, aPolygons );
+    polygons |= other;
+    getContours( polygons, *this );
+}
+
+
+void CPOLYGONS_LIST::BooleanSubtract( const CPOLYGONS_LIST& aHoles )
+{
+    POLYGON_SET_DATA polygons;
+    POLYGON_SET_DATA holes;
+
+    insertContours( polygons, *this );
+    insertContours( holes, aHoles );
+    polygons -= holes;
+    getContours( polygons, *this );
+}
+
 
 /**
  * Function ConvertPolysListWithHolesToOnePolygon
@@ -1365,62 +1510,26 @@ void ConvertPolysListWithHolesToOnePolygon( const CPOLYGONS_LIST& aPolysListWith
     }
 
     // Holes are found: convert them to only one polygon with overlap segments
-    KI_POLYGON_SET polysholes;
-    KI_POLYGON_SET mainpoly;
-    KI_POLYGON poly_tmp;
-    std::vector<KI_POLY_POINT> cornerslist;
-    corners_count = aPolysListWithHoles.GetCornersCount();
+    const std::vector<CPolyPt>&             corners = aPolysListWithHoles.GetList();
+    std::vector<CPolyPt>::const_iterator    holes = corners.begin();
 
-    unsigned ic    = 0;
     // enter main outline
-    while( ic < corners_count )
-    {
-        const CPolyPt& corner = aPolysListWithHoles.GetCorner( ic++ );
-        cornerslist.push_back( KI_POLY_POINT( corner.x, corner.y ) );
-
-        if( corner.end_contour )
-            break;
-    }
-    bpl::set_points( poly_tmp, cornerslist.begin(), cornerslist.end() );
-    mainpoly.push_back( poly_tmp );
-
-    while( ic < corners_count )
-    {
-        cornerslist.clear();
-        {
-            while( ic < corners_count )
-            {
-                const CPolyPt& corner = aPolysListWithHoles.GetCorner( ic++ );
-                cornerslist.push_back( KI_POLY_POINT( corner.x, corner.y ) );
+    while( !( holes++ )->end_contour )
+        ;
 
-                if( corner.end_contour )
-                    break;
-            }
+    POLYGON_SET_DATA mainpoly;
+    POLYGON_SET_DATA polysholes;
 
-            bpl::set_points( poly_tmp, cornerslist.begin(), cornerslist.end() );
-            polysholes.push_back( poly_tmp );
-        }
-    }
+    insertContours( mainpoly, corners.begin(), holes );
+    insertContours( polysholes, holes, corners.end() );
     mainpoly -= polysholes;
 
     // copy polygon with no holes to destination
     // Because all holes are now linked to the main outline
     // by overlapping segments, we should have only one polygon in list
-    wxASSERT( mainpoly.size() == 1 );
-
-    KI_POLYGON& poly_nohole = mainpoly[0];
-    CPolyPt   corner( 0, 0, false );
-
-    for( unsigned jj = 0; jj < poly_nohole.size(); jj++ )
-    {
-        KI_POLY_POINT point = *(poly_nohole.begin() + jj);
-        corner.x = point.x();
-        corner.y = point.y();
-        corner.end_contour = false;
-        aOnePolyList.AddCorner( corner );
-    }
+    CONTOUR_SINK sink( aOnePolyList );
 
-    aOnePolyList.CloseLastContour();
+    mainpoly.get( sink );
 }
 
 /**
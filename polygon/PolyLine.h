@@ -120,6 +120,12 @@ public:
 
 
     void RemoveAllContours( void ) { m_cornersList.clear(); }
+
+    /**
+     * Function Swap
+     * exchanges the corners of this list and \a aOther without copying them.
+     */
+    void Swap( CPOLYGONS_LIST& aOther ) { m_cornersList.swap( aOther.m_cornersList ); }
     CPolyPt& GetLastCorner() { return m_cornersList.back(); }
 
     unsigned GetCornersCount() const { return m_cornersList.size(); }
@@ -159,13 +165,6 @@ public:
         m_cornersList.insert( m_cornersList.begin() + aPosition + 1, aItem );
     }
 
-    /**
-     * Function ExportTo
-     * Copy all contours to a KI_POLYGON_SET
-     * @param aPolygons = the KI_POLYGON_WITH_HOLES to populate
-     */
-    void    ExportTo( KI_POLYGON_SET& aPolygons );
-
     /**
      * Function ExportTo
      * Copy the contours to a KI_POLYGON_WITH_HOLES
@@ -175,11 +174,34 @@ public:
     void    ExportTo( KI_POLYGON_WITH_HOLES& aPolygoneWithHole );
 
     /**
-     * Function ImportFrom
-     * Copy all polygons from a KI_POLYGON_SET in list
-     * @param aPolygons = the KI_POLYGON_SET to import
+     * Function Inflate
+     * grows the polygons by \a aDelta (or shrinks them if \a aDelta is negative),
+     * merging the overlapping ones.
+     * As for all the boolean operations below, the contours are replaced by the result,
+     * holes being linked to their main outline by overlapping segments.
+     * @param aDelta = the distance the outlines are moved by
+     * @param aArcCorners = true to use arcs for the corners created by the offset
+     * @param aCircleToSegmentsCount = the number of segments of a full circle for these arcs
+     */
+    void    Inflate( int aDelta, bool aArcCorners = false, int aCircleToSegmentsCount = 0 );
+
+    /**
+     * Function Merge
+     * merges the overlapping polygons.
+     */
+    void    Merge();
+
+    /**
+     * Function BooleanAdd
+     * adds the polygons of \a aPolygons to the polygons of the list.
+     */
+    void    BooleanAdd( const CPOLYGONS_LIST& aPolygons );
+
+    /**
+     * Function BooleanSubtract
+     * removes the polygons of \a aHoles from the polygons of the list.
      */
-    void    ImportFrom( KI_POLYGON_SET& aPolygons );
+    void    BooleanSubtract( const CPOLYGONS_LIST& aHoles );
 
     /**
      * function AddCorner
@@ -0,0 +1,74 @@
+import unittest
+import pcbnew
+
+from pcbnew import *
+
+class TestUndoImages(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.module = self.pcb.FindModule('U1')
+
+    def pads(self, module):
+        return list((pad.GetPadName(), pad.GetPosition().Get(), pad.GetSize().Get())
+                    for pad in module.Pads())
+
+    def drawings(self, module):
+        return list((item.GetLayer(), item.GetPosition().Get())
+                    for item in module.GraphicalItems())
+
+    def test_undo_redo_compacted_footprint_edit(self):
+        module = self.module
+        original = self.pads(module)
+        drawings = self.drawings(module)
+
+        self.assertTrue(len(original) > 2)
+
+        # command A: copy saved, then the first pad is edited
+        image_a = MODULE_UNDO_IMAGE(module)
+        module.Pads().GetFirst().SetSize(wxSizeMM(3.0, 3.0))
+        after_a = self.pads(module)
+
+        # command B: its copy is the state after A, A's copy is compacted against it
+        image_b = MODULE_UNDO_IMAGE(module)
+        image_a.Compact(image_b)
+
+        self.assertTrue(image_a.IsCompacted())
+        self.assertEqual(image_a.Pads().GetCount(), 1)
+        self.assertEqual(image_a.GraphicalItems().GetCount(), 0)
+
+        module.Pads().GetFirst().Next().SetSize(wxSizeMM(4.0, 4.0))
+        after_b = self.pads(module)
+
+        # undo B, then A
+        image_b.Swap(module)
+        self.assertEqual(self.pads(module), after_a)
+
+        image_a.Swap(module)
+        self.assertEqual(self.pads(module), original)
+        self.assertEqual(self.drawings(module), drawings)
+
+        # redo A, then B
+        image_a.Swap(module)
+        self.assertEqual(self.pads(module), after_a)
+
+        image_b.Swap(module)
+        self.assertEqual(self.pads(module), after_b)
+        self.assertEqual(self.drawings(module), drawings)
+
+    def test_compact_needs_matching_footprint(self):
+        module = self.module
+        original = self.pads(module)
+        image_a = MODULE_UNDO_IMAGE(module)
+
+        # pads cannot be matched one to one when the footprint is moved
+        module.Move(wxPointMM(1.0, 1.0))
+        image_b = MODULE_UNDO_IMAGE(module)
+        image_a.Compact(image_b)
+
+        self.assertFalse(image_a.IsCompacted())
+        self.assertEqual(image_a.Pads().GetCount(), module.Pads().GetCount())
+
+        # undo restores the whole footprint
+        image_a.Swap(module)
+        self.assertEqual(self.pads(module), original)